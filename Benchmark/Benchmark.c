@@ -0,0 +1,266 @@
+/** @file Benchmark.c
+ * Measure the solver phases duration on generated puzzles of various sizes.
+ * @author Adrien RICCIARDI
+ */
+#include <Generator.h>
+#include <Replay.h>
+#include <Solver.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+//-------------------------------------------------------------------------------------------------
+// Private constants
+//-------------------------------------------------------------------------------------------------
+/** How many values a comma-separated command line list can contain. */
+#define BENCHMARK_MAXIMUM_LIST_ITEMS_COUNT 32
+
+//-------------------------------------------------------------------------------------------------
+// Private types
+//-------------------------------------------------------------------------------------------------
+/** All measured solver phases. */
+typedef enum
+{
+	BENCHMARK_PHASE_LOAD, //!< GridLoadFromFile().
+	BENCHMARK_PHASE_SOLVE, //!< SolverSolveGrid().
+	BENCHMARK_PHASE_HIDDEN_WORD, //!< GridGetHiddenWord().
+	BENCHMARK_PHASES_COUNT
+} TBenchmarkPhase;
+
+//-------------------------------------------------------------------------------------------------
+// Private constants
+//-------------------------------------------------------------------------------------------------
+/** The phase names, as printed in the results. */
+static const char *Benchmark_Phase_Names[BENCHMARK_PHASES_COUNT] =
+{
+	"load",
+	"solve",
+	"hidden_word"
+};
+
+//-------------------------------------------------------------------------------------------------
+// Private functions
+//-------------------------------------------------------------------------------------------------
+/** Sort durations in ascending order.
+ * @param Pointer_A The first double to compare.
+ * @param Pointer_B The second double to compare.
+ * @return A negative number if the first duration is the shortest, a positive number if it is the longest, 0 if both are equal.
+ */
+static int BenchmarkCompareDurations(const void *Pointer_A, const void *Pointer_B)
+{
+	double A = *(const double *) Pointer_A, B = *(const double *) Pointer_B;
+
+	if (A < B) return -1;
+	if (A > B) return 1;
+	return 0;
+}
+
+/** Parse a comma-separated list of numbers or of "RowsxColumns" sizes.
+ * @param Pointer_String_List The list to parse.
+ * @param Pointer_First_Values On output, contain the numbers (or the rows count of each size).
+ * @param Pointer_Second_Values On output, contain the columns count of each size. Set to NULL to parse a list of numbers.
+ * @return -1 if the list is invalid,
+ * @return The amount of parsed items.
+ */
+static int BenchmarkParseList(char *Pointer_String_List, int *Pointer_First_Values, int *Pointer_Second_Values)
+{
+	int Count = 0;
+	char *Pointer_String_Item, *Pointer_String_End;
+
+	for (Pointer_String_Item = strtok(Pointer_String_List, ","); Pointer_String_Item != NULL; Pointer_String_Item = strtok(NULL, ","))
+	{
+		if (Count >= BENCHMARK_MAXIMUM_LIST_ITEMS_COUNT) return -1;
+
+		Pointer_First_Values[Count] = (int) strtol(Pointer_String_Item, &Pointer_String_End, 10);
+		if (Pointer_First_Values[Count] <= 0) return -1;
+		if (Pointer_Second_Values != NULL)
+		{
+			if (*Pointer_String_End != 'x') return -1;
+			Pointer_Second_Values[Count] = (int) strtol(Pointer_String_End + 1, &Pointer_String_End, 10);
+			if (Pointer_Second_Values[Count] <= 0) return -1;
+		}
+		if (*Pointer_String_End != 0) return -1;
+		Count++;
+	}
+
+	return Count;
+}
+
+/** Solve the same puzzle file many times and print the median and 99th percentile duration of each phase as a CSV line.
+ * @param Pointer_Parameters The parameters the puzzle has been generated with.
+ * @param Pointer_String_File_Name The puzzle file.
+ * @param Strategy How to search the words.
+ * @param Threads_Count How many threads the scan strategy can use.
+ * @param Repetitions_Count How many times to solve the puzzle.
+ * @return -1 if the puzzle could not be solved,
+ * @return 0 on success.
+ */
+static int BenchmarkMeasure(TGeneratorParameters *Pointer_Parameters, char *Pointer_String_File_Name, TSolverStrategy Strategy, int Threads_Count, int Repetitions_Count)
+{
+	TSolverPuzzle Puzzle;
+	double *Pointer_Durations[BENCHMARK_PHASES_COUNT] = { NULL }, Time, Median, Percentile_99;
+	int i, Phase, Rows_Count, Columns_Count, Return_Value = -1;
+
+	SolverPuzzleInitialize(&Puzzle, 0);
+	for (Phase = 0; Phase < BENCHMARK_PHASES_COUNT; Phase++)
+	{
+		Pointer_Durations[Phase] = malloc(Repetitions_Count * sizeof(double));
+		if (Pointer_Durations[Phase] == NULL)
+		{
+			printf("Error : not enough memory to store the measures.\n");
+			goto Exit;
+		}
+	}
+
+	for (i = 0; i < Repetitions_Count; i++)
+	{
+		Time = SolverGetTime();
+		if (GridLoadFromFile(&Puzzle.Grid, Pointer_String_File_Name, &Puzzle.Word_Table, &Rows_Count, &Columns_Count, &Puzzle.Words_Count) != 0) goto Exit;
+		Pointer_Durations[BENCHMARK_PHASE_LOAD][i] = SolverGetTime() - Time;
+
+		Time = SolverGetTime();
+		if (SolverSolveGrid(&Puzzle, Strategy, Threads_Count, Puzzle.Words_Count) != 0) goto Exit;
+		Pointer_Durations[BENCHMARK_PHASE_SOLVE][i] = SolverGetTime() - Time;
+
+		Time = SolverGetTime();
+		if (GridGetHiddenWord(&Puzzle.Grid, &Puzzle.Pointer_String_Hidden_Word, &Puzzle.Hidden_Word_Buffer_Size) != 0) goto Exit;
+		Pointer_Durations[BENCHMARK_PHASE_HIDDEN_WORD][i] = SolverGetTime() - Time;
+	}
+
+	// Print a line per phase
+	for (Phase = 0; Phase < BENCHMARK_PHASES_COUNT; Phase++)
+	{
+		qsort(Pointer_Durations[Phase], Repetitions_Count, sizeof(double), BenchmarkCompareDurations);
+		Median = Pointer_Durations[Phase][Repetitions_Count / 2];
+		Percentile_99 = Pointer_Durations[Phase][(Repetitions_Count * 99 + 99) / 100 - 1]; // Nearest-rank method
+		printf("%d,%d,%d,%llu,%s,%d,%s,%d,%.3f,%.3f\n", Pointer_Parameters->Rows_Count, Pointer_Parameters->Columns_Count, Pointer_Parameters->Words_Count, Pointer_Parameters->Seed, Solver_Strategy_Names[Strategy], Threads_Count, Benchmark_Phase_Names[Phase], Repetitions_Count, Median * 1000000.0, Percentile_99 * 1000000.0);
+	}
+	fflush(stdout);
+	Return_Value = 0;
+
+Exit:
+	if (Return_Value != 0) fprintf(stderr, "Error : failed to solve the %dx%d puzzle with %d words.\n", Pointer_Parameters->Columns_Count, Pointer_Parameters->Rows_Count, Pointer_Parameters->Words_Count);
+	for (Phase = 0; Phase < BENCHMARK_PHASES_COUNT; Phase++) free(Pointer_Durations[Phase]);
+	SolverPuzzleFree(&Puzzle);
+	return Return_Value;
+}
+
+//-------------------------------------------------------------------------------------------------
+// Entry point
+//-------------------------------------------------------------------------------------------------
+int main(int argc, char *argv[])
+{
+	TGeneratorParameters Parameters;
+	TReplayParameters Replay_Parameters;
+	TSolverStrategy Strategy = SOLVER_STRATEGY_SCAN;
+	int i, j, Rows_Counts[BENCHMARK_MAXIMUM_LIST_ITEMS_COUNT] = { 20, 100, 1000 }, Columns_Counts[BENCHMARK_MAXIMUM_LIST_ITEMS_COUNT] = { 20, 100, 1000 }, Sizes_Count = 3, Words_Counts[BENCHMARK_MAXIMUM_LIST_ITEMS_COUNT] = { 10, 100, 1000 }, Words_Counts_Count = 3, Repetitions_Count = 5, Threads_Count = 1, File_Descriptor, Return_Value = EXIT_FAILURE;
+	char *Pointer_String_Generated_File_Name = NULL, String_Temporary_File_Name[] = "/tmp/Word_Search_Solver_Benchmark_XXXXXX";
+
+	// Default puzzle settings
+	memset(&Parameters, 0, sizeof(Parameters));
+	Parameters.Minimum_Word_Length = 4;
+	Parameters.Maximum_Word_Length = 12;
+	Parameters.Seed = 1;
+
+	// Default replay settings
+	memset(&Replay_Parameters, 0, sizeof(Replay_Parameters));
+	Replay_Parameters.Threshold_Percentage = 25;
+	Replay_Parameters.Noise_Floor = 20;
+
+	// Check arguments
+	for (i = 1; i < argc; i++)
+	{
+		if ((strcmp(argv[i], "--seed") == 0) && (i + 1 < argc)) Parameters.Seed = strtoull(argv[++i], NULL, 10);
+		else if ((strcmp(argv[i], "--repetitions") == 0) && (i + 1 < argc)) Repetitions_Count = atoi(argv[++i]);
+		else if ((strcmp(argv[i], "--threads") == 0) && (i + 1 < argc)) Threads_Count = atoi(argv[++i]);
+		else if ((strcmp(argv[i], "--hidden-word") == 0) && (i + 1 < argc)) Parameters.Pointer_String_Hidden_Word = argv[++i];
+		else if ((strcmp(argv[i], "--generate") == 0) && (i + 1 < argc)) Pointer_String_Generated_File_Name = argv[++i];
+		else if ((strcmp(argv[i], "--replay") == 0) && (i + 1 < argc)) Replay_Parameters.Pointer_String_Directory_Name = argv[++i];
+		else if ((strcmp(argv[i], "--baseline") == 0) && (i + 1 < argc)) Replay_Parameters.Pointer_String_Baseline_File_Name = argv[++i];
+		else if (strcmp(argv[i], "--record") == 0) Replay_Parameters.Is_Recording = 1;
+		else if ((strcmp(argv[i], "--threshold") == 0) && (i + 1 < argc)) Replay_Parameters.Threshold_Percentage = atof(argv[++i]);
+		else if ((strcmp(argv[i], "--noise-floor") == 0) && (i + 1 < argc)) Replay_Parameters.Noise_Floor = atof(argv[++i]);
+		else if ((strcmp(argv[i], "--sizes") == 0) && (i + 1 < argc))
+		{
+			Sizes_Count = BenchmarkParseList(argv[++i], Rows_Counts, Columns_Counts);
+			if (Sizes_Count <= 0) break;
+		}
+		else if ((strcmp(argv[i], "--words") == 0) && (i + 1 < argc))
+		{
+			Words_Counts_Count = BenchmarkParseList(argv[++i], Words_Counts, NULL);
+			if (Words_Counts_Count <= 0) break;
+		}
+		else if ((strcmp(argv[i], "--lengths") == 0) && (i + 1 < argc))
+		{
+			if (sscanf(argv[++i], "%d-%d", &Parameters.Minimum_Word_Length, &Parameters.Maximum_Word_Length) != 2) break;
+		}
+		else if ((strcmp(argv[i], "--strategy") == 0) && (i + 1 < argc))
+		{
+			i++;
+			for (Strategy = 0; Strategy < SOLVER_STRATEGIES_COUNT; Strategy++)
+			{
+				if (strcmp(argv[i], Solver_Strategy_Names[Strategy]) == 0) break;
+			}
+			if (Strategy == SOLVER_STRATEGIES_COUNT) break;
+			Replay_Parameters.Is_Single_Strategy = 1;
+		}
+		else break;
+	}
+	if ((i < argc) || (Repetitions_Count < 1) || (Threads_Count < 1) || (Replay_Parameters.Threshold_Percentage < 0) || (Replay_Parameters.Noise_Floor < 0) || (Replay_Parameters.Is_Recording && (Replay_Parameters.Pointer_String_Baseline_File_Name == NULL)))
+	{
+		printf("Usage : %s [--seed N] [--repetitions N] [--sizes RowsxColumns,...] [--words N,...] [--lengths Minimum-Maximum] [--hidden-word Word] [--strategy Name] [--threads N] [--generate File_Name]\n"
+			"        %s --replay Directory [--repetitions N] [--strategy Name] [--baseline File_Name [--record] [--threshold Percentage] [--noise-floor Microseconds]]\n"
+			"Generate a puzzle for each grid size and words count combination, solve it the specified amount of times, and print the median and 99th percentile durations of the loading, solving and hidden word phases in CSV format (durations are in microseconds).\n"
+			"Default values are --seed 1 --repetitions 5 --sizes 20x20,100x100,1000x1000 --words 10,100,1000 --lengths 4-12 --strategy scan --threads 1.\n"
+			"The --generate option only writes a puzzle with the first grid size and the first words count to the specified file.\n"
+			"The --replay option solves each puzzle file of a directory the specified amount of times with every strategy (or only with the --strategy one), and prints for each puzzle its solved flag, a hash of its words locations, its median and 99th percentile durations and its hidden word, plus a total line per strategy. The --record option writes these results to the baseline file, otherwise they are compared to the baseline file : the program fails if a result differs, or if a median duration is more than --threshold percent (25 by default) and more than --noise-floor microseconds (20 by default) slower than the baseline one.\n", argv[0], argv[0]);
+		return EXIT_FAILURE;
+	}
+
+	// Replay a corpus of real puzzles instead of generated ones
+	if (Replay_Parameters.Pointer_String_Directory_Name != NULL)
+	{
+		Replay_Parameters.Repetitions_Count = Repetitions_Count;
+		Replay_Parameters.Strategy = Strategy;
+		if (ReplayRun(&Replay_Parameters) != 0) return EXIT_FAILURE;
+		return EXIT_SUCCESS;
+	}
+
+	// Only generate a puzzle if requested
+	if (Pointer_String_Generated_File_Name != NULL)
+	{
+		Parameters.Rows_Count = Rows_Counts[0];
+		Parameters.Columns_Count = Columns_Counts[0];
+		Parameters.Words_Count = Words_Counts[0];
+		if (GeneratorWritePuzzle(&Parameters, Pointer_String_Generated_File_Name) != 0) return EXIT_FAILURE;
+		return EXIT_SUCCESS;
+	}
+
+	// Puzzles are written to a temporary file because the solver loads puzzles from files
+	File_Descriptor = mkstemp(String_Temporary_File_Name);
+	if (File_Descriptor < 0)
+	{
+		printf("Error : could not create a temporary file.\n");
+		return EXIT_FAILURE;
+	}
+	close(File_Descriptor);
+
+	printf("rows,columns,words,seed,strategy,threads,phase,repetitions,median_us,p99_us\n");
+	for (i = 0; i < Sizes_Count; i++)
+	{
+		for (j = 0; j < Words_Counts_Count; j++)
+		{
+			Parameters.Rows_Count = Rows_Counts[i];
+			Parameters.Columns_Count = Columns_Counts[i];
+			Parameters.Words_Count = Words_Counts[j];
+			if (GeneratorWritePuzzle(&Parameters, String_Temporary_File_Name) != 0) goto Exit;
+			if (BenchmarkMeasure(&Parameters, String_Temporary_File_Name, Strategy, Threads_Count, Repetitions_Count) != 0) goto Exit;
+		}
+	}
+	Return_Value = EXIT_SUCCESS;
+
+Exit:
+	unlink(String_Temporary_File_Name);
+	return Return_Value;
+}
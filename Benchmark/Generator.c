@@ -0,0 +1,149 @@
+/** @file Generator.c
+ * See Generator.h for description.
+ * @author Adrien RICCIARDI
+ */
+#include <Configuration.h>
+#include <Generator.h>
+#include <Grid.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+//-------------------------------------------------------------------------------------------------
+// Private constants
+//-------------------------------------------------------------------------------------------------
+/** How many random locations are tried for a word before giving up on it. */
+#define GENERATOR_MAXIMUM_PLACEMENT_TRIES 100
+
+//-------------------------------------------------------------------------------------------------
+// Private variables
+//-------------------------------------------------------------------------------------------------
+/** The pseudo-random generator state. */
+static unsigned long long Generator_Random_State;
+
+//-------------------------------------------------------------------------------------------------
+// Private functions
+//-------------------------------------------------------------------------------------------------
+/** Get the next pseudo-random number (xorshift64* algorithm, which gives the same sequence on all platforms unlike rand()).
+ * @param Maximum_Value The returned number will be lower than this value.
+ * @return A number in range [0, Maximum_Value[.
+ */
+static unsigned int GeneratorGetRandomNumber(unsigned int Maximum_Value)
+{
+	Generator_Random_State ^= Generator_Random_State >> 12;
+	Generator_Random_State ^= Generator_Random_State << 25;
+	Generator_Random_State ^= Generator_Random_State >> 27;
+	return (unsigned int) (((Generator_Random_State * 2685821657736338717ULL) >> 32) % Maximum_Value);
+}
+
+//-------------------------------------------------------------------------------------------------
+// Public functions
+//-------------------------------------------------------------------------------------------------
+int GeneratorWritePuzzle(TGeneratorParameters *Pointer_Parameters, char *Pointer_String_File_Name)
+{
+	char *Pointer_Letters = NULL, *Pointer_Words = NULL, String_Word[CONFIGURATION_WORD_MAXIMUM_STRING_SIZE];
+	int i, j, Length, Maximum_Length, Direction, Row_Step, Column_Step, Row, Column, Tries, Is_Placed, Placed_Words_Count = 0, Hidden_Word_Length = 0, Hidden_Word_Index = 0, Return_Value = -1;
+	size_t Cells_Count, Cell_Index;
+	FILE *Pointer_File = NULL;
+
+	// A zero seed would make xorshift produce only zeros
+	Generator_Random_State = Pointer_Parameters->Seed * 0x9E3779B97F4A7C15ULL + 1;
+
+	// Words can't be longer than the grid or than what the solver accepts
+	Maximum_Length = Pointer_Parameters->Maximum_Word_Length;
+	if (Maximum_Length > CONFIGURATION_WORD_MAXIMUM_STRING_SIZE - 1) Maximum_Length = CONFIGURATION_WORD_MAXIMUM_STRING_SIZE - 1;
+	if (Maximum_Length > Pointer_Parameters->Rows_Count) Maximum_Length = Pointer_Parameters->Rows_Count;
+	if (Maximum_Length > Pointer_Parameters->Columns_Count) Maximum_Length = Pointer_Parameters->Columns_Count;
+	if ((Pointer_Parameters->Minimum_Word_Length < 1) || (Pointer_Parameters->Minimum_Word_Length > Maximum_Length))
+	{
+		printf("Error : the word length range [%d, %d] can't fit in a %dx%d grid.\n", Pointer_Parameters->Minimum_Word_Length, Pointer_Parameters->Maximum_Word_Length, Pointer_Parameters->Columns_Count, Pointer_Parameters->Rows_Count);
+		return -1;
+	}
+
+	// A free cell contains 0
+	Cells_Count = (size_t) Pointer_Parameters->Rows_Count * Pointer_Parameters->Columns_Count;
+	Pointer_Letters = calloc(Cells_Count, 1);
+	Pointer_Words = malloc((size_t) Pointer_Parameters->Words_Count * CONFIGURATION_WORD_MAXIMUM_STRING_SIZE + 1);
+	if ((Pointer_Letters == NULL) || (Pointer_Words == NULL))
+	{
+		printf("Error : not enough memory to generate the puzzle.\n");
+		goto Exit;
+	}
+
+	// Plant the words
+	for (i = 0; i < Pointer_Parameters->Words_Count; i++)
+	{
+		// Choose a random word
+		Length = Pointer_Parameters->Minimum_Word_Length + (int) GeneratorGetRandomNumber(Maximum_Length - Pointer_Parameters->Minimum_Word_Length + 1);
+		for (j = 0; j < Length; j++) String_Word[j] = 'A' + (char) GeneratorGetRandomNumber(CONFIGURATION_ALPHABET_LETTERS_COUNT);
+		String_Word[Length] = 0;
+
+		// Find a location where the word fits, it can cross other words if the shared letters are the same
+		for (Tries = 0; Tries < GENERATOR_MAXIMUM_PLACEMENT_TRIES; Tries++)
+		{
+			Direction = (int) GeneratorGetRandomNumber(GRID_DIRECTIONS_COUNT);
+			GridGetDirectionSteps(Direction, &Row_Step, &Column_Step);
+			Row = (int) GeneratorGetRandomNumber(Pointer_Parameters->Rows_Count);
+			Column = (int) GeneratorGetRandomNumber(Pointer_Parameters->Columns_Count);
+			if ((Row + (Length - 1) * Row_Step < 0) || (Row + (Length - 1) * Row_Step >= Pointer_Parameters->Rows_Count) || (Column + (Length - 1) * Column_Step < 0) || (Column + (Length - 1) * Column_Step >= Pointer_Parameters->Columns_Count)) continue;
+
+			Is_Placed = 1;
+			for (j = 0; j < Length; j++)
+			{
+				Cell_Index = (size_t) (Row + j * Row_Step) * Pointer_Parameters->Columns_Count + Column + j * Column_Step;
+				if ((Pointer_Letters[Cell_Index] != 0) && (Pointer_Letters[Cell_Index] != String_Word[j]))
+				{
+					Is_Placed = 0;
+					break;
+				}
+			}
+			if (!Is_Placed) continue;
+
+			for (j = 0; j < Length; j++) Pointer_Letters[(size_t) (Row + j * Row_Step) * Pointer_Parameters->Columns_Count + Column + j * Column_Step] = String_Word[j];
+			strcpy(&Pointer_Words[(size_t) Placed_Words_Count * CONFIGURATION_WORD_MAXIMUM_STRING_SIZE], String_Word);
+			Placed_Words_Count++;
+			break;
+		}
+	}
+
+	// Fill the free cells
+	if (Pointer_Parameters->Pointer_String_Hidden_Word != NULL) Hidden_Word_Length = (int) strlen(Pointer_Parameters->Pointer_String_Hidden_Word);
+	for (Cell_Index = 0; Cell_Index < Cells_Count; Cell_Index++)
+	{
+		if (Pointer_Letters[Cell_Index] != 0) continue;
+
+		if (Hidden_Word_Length > 0)
+		{
+			Pointer_Letters[Cell_Index] = Pointer_Parameters->Pointer_String_Hidden_Word[Hidden_Word_Index];
+			Hidden_Word_Index = (Hidden_Word_Index + 1) % Hidden_Word_Length;
+		}
+		else Pointer_Letters[Cell_Index] = 'A' + (char) GeneratorGetRandomNumber(CONFIGURATION_ALPHABET_LETTERS_COUNT);
+	}
+
+	// Write the puzzle
+	Pointer_File = fopen(Pointer_String_File_Name, "w");
+	if (Pointer_File == NULL)
+	{
+		printf("Error : could not create the file \"%s\".\n", Pointer_String_File_Name);
+		goto Exit;
+	}
+	for (Row = 0; Row < Pointer_Parameters->Rows_Count; Row++)
+	{
+		fwrite(&Pointer_Letters[(size_t) Row * Pointer_Parameters->Columns_Count], 1, Pointer_Parameters->Columns_Count, Pointer_File);
+		fputc('\n', Pointer_File);
+	}
+	fputs("-\n", Pointer_File);
+	for (i = 0; i < Placed_Words_Count; i++) fprintf(Pointer_File, "%s\n", &Pointer_Words[(size_t) i * CONFIGURATION_WORD_MAXIMUM_STRING_SIZE]);
+	if (ferror(Pointer_File))
+	{
+		printf("Error : failed to write the file \"%s\".\n", Pointer_String_File_Name);
+		goto Exit;
+	}
+	Return_Value = 0;
+
+Exit:
+	if ((Pointer_File != NULL) && (fclose(Pointer_File) != 0)) Return_Value = -1;
+	free(Pointer_Letters);
+	free(Pointer_Words);
+	return Return_Value;
+}
@@ -0,0 +1,35 @@
+/** @file Generator.h
+ * Create random word search puzzles of any size, in a reproducible way.
+ * @author Adrien RICCIARDI
+ */
+#ifndef H_GENERATOR_H
+#define H_GENERATOR_H
+
+//-------------------------------------------------------------------------------------------------
+// Types
+//-------------------------------------------------------------------------------------------------
+/** Describe the puzzle to generate. */
+typedef struct
+{
+	int Rows_Count; //!< The grid height.
+	int Columns_Count; //!< The grid width.
+	int Words_Count; //!< How many words to plant in the grid.
+	int Minimum_Word_Length; //!< The shortest word length.
+	int Maximum_Word_Length; //!< The longest word length.
+	char *Pointer_String_Hidden_Word; //!< If not NULL, the free cells are filled with this word letters (repeated as needed) instead of random letters.
+	unsigned long long Seed; //!< The same seed always produces the same puzzle.
+} TGeneratorParameters;
+
+//-------------------------------------------------------------------------------------------------
+// Functions
+//-------------------------------------------------------------------------------------------------
+/** Plant random words in all 8 directions of a grid, fill the remaining cells, then write the puzzle in the word search file format.
+ * @param Pointer_Parameters The puzzle to generate.
+ * @param Pointer_String_File_Name The file to write.
+ * @return -1 if an error occurred,
+ * @return 0 on success.
+ * @note If a word can't be placed after many tries (the grid is too crowded), it is not added to the word list, so the puzzle is always solvable.
+ */
+int GeneratorWritePuzzle(TGeneratorParameters *Pointer_Parameters, char *Pointer_String_File_Name);
+
+#endif
@@ -0,0 +1,510 @@
+/** @file Replay.c
+ * See Replay.h for description.
+ * @author Adrien RICCIARDI
+ */
+#include <dirent.h>
+#include <limits.h>
+#include <Replay.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+//-------------------------------------------------------------------------------------------------
+// Private constants
+//-------------------------------------------------------------------------------------------------
+/** The puzzle name of the lines summing all puzzles of a strategy. */
+#define REPLAY_TOTAL_NAME "total"
+
+/** The FNV-1a hash parameters used to hash the words locations. */
+#define REPLAY_HASH_OFFSET 0xCBF29CE484222325ULL
+#define REPLAY_HASH_PRIME 0x100000001B3ULL
+
+/** How many fields a results line contains. */
+#define REPLAY_FIELDS_COUNT 7
+
+/** How many times a puzzle is measured before a duration regression is reported. */
+#define REPLAY_MAXIMUM_ATTEMPTS_COUNT 5
+
+//-------------------------------------------------------------------------------------------------
+// Private types
+//-------------------------------------------------------------------------------------------------
+/** The results of a puzzle replayed with a strategy. */
+typedef struct
+{
+	char *Pointer_String_Puzzle_Name; //!< The puzzle file name, without the directory.
+	TSolverStrategy Strategy; //!< The strategy the puzzle has been solved with.
+	int Solved_Count; //!< 1 if the puzzle has been solved, 0 otherwise. This is the amount of solved puzzles for a total line.
+	unsigned long long Locations_Hash; //!< A hash of all words locations, or of all puzzles hashes for a total line.
+	double Median_Duration; //!< The median duration in microseconds.
+	double Percentile_99_Duration; //!< The 99th percentile duration in microseconds.
+	char *Pointer_String_Hidden_Word; //!< The hidden word, empty if the puzzle could not be solved.
+} TReplayResult;
+
+/** A growable list of results. */
+typedef struct
+{
+	TReplayResult *Pointer_Results; //!< All results.
+	int Count; //!< How many results the list contains.
+	int Allocated_Count; //!< How many results fit in the list.
+} TReplayResults;
+
+//-------------------------------------------------------------------------------------------------
+// Private functions
+//-------------------------------------------------------------------------------------------------
+/** Sort durations in ascending order.
+ * @param Pointer_A The first double to compare.
+ * @param Pointer_B The second double to compare.
+ * @return A negative number if the first duration is the shortest, a positive number if it is the longest, 0 if both are equal.
+ */
+static int ReplayCompareDurations(const void *Pointer_A, const void *Pointer_B)
+{
+	double A = *(const double *) Pointer_A, B = *(const double *) Pointer_B;
+
+	if (A < B) return -1;
+	if (A > B) return 1;
+	return 0;
+}
+
+/** Sort file names in alphabetical order.
+ * @param Pointer_A The first file name pointer to compare.
+ * @param Pointer_B The second file name pointer to compare.
+ * @return The strcmp() result.
+ */
+static int ReplayCompareNames(const void *Pointer_A, const void *Pointer_B)
+{
+	return strcmp(*(char * const *) Pointer_A, *(char * const *) Pointer_B);
+}
+
+/** Append a result to a list, copying its strings.
+ * @param Pointer_Results The list.
+ * @param Pointer_String_Puzzle_Name The puzzle name.
+ * @param Strategy The strategy.
+ * @param Solved_Count The solved puzzles count.
+ * @param Locations_Hash The locations hash.
+ * @param Median_Duration The median duration in microseconds.
+ * @param Percentile_99_Duration The 99th percentile duration in microseconds.
+ * @param Pointer_String_Hidden_Word The hidden word.
+ * @return -1 if no more heap memory is available,
+ * @return 0 on success.
+ */
+static int ReplayAddResult(TReplayResults *Pointer_Results, const char *Pointer_String_Puzzle_Name, TSolverStrategy Strategy, int Solved_Count, unsigned long long Locations_Hash, double Median_Duration, double Percentile_99_Duration, const char *Pointer_String_Hidden_Word)
+{
+	TReplayResult *Pointer_Result;
+
+	if (Pointer_Results->Count >= Pointer_Results->Allocated_Count)
+	{
+		Pointer_Result = realloc(Pointer_Results->Pointer_Results, (Pointer_Results->Allocated_Count + 64) * sizeof(TReplayResult));
+		if (Pointer_Result == NULL) goto Error;
+		Pointer_Results->Pointer_Results = Pointer_Result;
+		Pointer_Results->Allocated_Count += 64;
+	}
+
+	Pointer_Result = &Pointer_Results->Pointer_Results[Pointer_Results->Count];
+	Pointer_Result->Pointer_String_Puzzle_Name = strdup(Pointer_String_Puzzle_Name);
+	Pointer_Result->Pointer_String_Hidden_Word = strdup(Pointer_String_Hidden_Word);
+	if ((Pointer_Result->Pointer_String_Puzzle_Name == NULL) || (Pointer_Result->Pointer_String_Hidden_Word == NULL))
+	{
+		free(Pointer_Result->Pointer_String_Puzzle_Name);
+		free(Pointer_Result->Pointer_String_Hidden_Word);
+		goto Error;
+	}
+	Pointer_Result->Strategy = Strategy;
+	Pointer_Result->Solved_Count = Solved_Count;
+	Pointer_Result->Locations_Hash = Locations_Hash;
+	Pointer_Result->Median_Duration = Median_Duration;
+	Pointer_Result->Percentile_99_Duration = Percentile_99_Duration;
+	Pointer_Results->Count++;
+	return 0;
+
+Error:
+	fprintf(stderr, "Error : not enough memory to store the replay results.\n");
+	return -1;
+}
+
+/** Release all memory used by a results list.
+ * @param Pointer_Results The list to free.
+ */
+static void ReplayFreeResults(TReplayResults *Pointer_Results)
+{
+	int i;
+
+	for (i = 0; i < Pointer_Results->Count; i++)
+	{
+		free(Pointer_Results->Pointer_Results[i].Pointer_String_Puzzle_Name);
+		free(Pointer_Results->Pointer_Results[i].Pointer_String_Hidden_Word);
+	}
+	free(Pointer_Results->Pointer_Results);
+}
+
+/** Remove the last result of a list.
+ * @param Pointer_Results The list, it must not be empty.
+ */
+static void ReplayRemoveLastResult(TReplayResults *Pointer_Results)
+{
+	Pointer_Results->Count--;
+	free(Pointer_Results->Pointer_Results[Pointer_Results->Count].Pointer_String_Puzzle_Name);
+	free(Pointer_Results->Pointer_Results[Pointer_Results->Count].Pointer_String_Hidden_Word);
+}
+
+/** Print a result in the baseline format.
+ * @param Pointer_File Where to print the result.
+ * @param Pointer_Result The result.
+ */
+static void ReplayPrintResult(FILE *Pointer_File, TReplayResult *Pointer_Result)
+{
+	fprintf(Pointer_File, "%s,%s,%d,%016llx,%.3f,%.3f,%s\n", Pointer_Result->Pointer_String_Puzzle_Name, Solver_Strategy_Names[Pointer_Result->Strategy], Pointer_Result->Solved_Count, Pointer_Result->Locations_Hash, Pointer_Result->Median_Duration, Pointer_Result->Percentile_99_Duration, Pointer_Result->Pointer_String_Hidden_Word);
+}
+
+/** Parse a baseline line and append it to a list.
+ * @param Pointer_String_Line The line, it is modified.
+ * @param Pointer_Results The list.
+ * @return -1 if the line is invalid or if no more heap memory is available (an error message has been displayed),
+ * @return 0 on success.
+ */
+static int ReplayParseResult(char *Pointer_String_Line, TReplayResults *Pointer_Results)
+{
+	char *Pointer_Strings_Fields[REPLAY_FIELDS_COUNT];
+	TSolverStrategy Strategy;
+	int i;
+
+	// Split the fields, the hidden word is the last one and can be empty
+	Pointer_String_Line[strcspn(Pointer_String_Line, "\r\n")] = 0;
+	for (i = 0; i < REPLAY_FIELDS_COUNT; i++)
+	{
+		Pointer_Strings_Fields[i] = Pointer_String_Line;
+		if (i == REPLAY_FIELDS_COUNT - 1) break;
+
+		Pointer_String_Line = strchr(Pointer_String_Line, ',');
+		if (Pointer_String_Line == NULL) goto Invalid_Line;
+		*Pointer_String_Line = 0;
+		Pointer_String_Line++;
+	}
+
+	for (Strategy = 0; Strategy < SOLVER_STRATEGIES_COUNT; Strategy++)
+	{
+		if (strcmp(Pointer_Strings_Fields[1], Solver_Strategy_Names[Strategy]) == 0) break;
+	}
+	if (Strategy == SOLVER_STRATEGIES_COUNT) goto Invalid_Line;
+
+	return ReplayAddResult(Pointer_Results, Pointer_Strings_Fields[0], Strategy, atoi(Pointer_Strings_Fields[2]), strtoull(Pointer_Strings_Fields[3], NULL, 16), strtod(Pointer_Strings_Fields[4], NULL), strtod(Pointer_Strings_Fields[5], NULL), Pointer_Strings_Fields[6]);
+
+Invalid_Line:
+	fprintf(stderr, "Error : the baseline line \"%s\" is invalid.\n", Pointer_Strings_Fields[0]);
+	return -1;
+}
+
+/** Load all results of a baseline file.
+ * @param Pointer_String_File_Name The baseline file.
+ * @param Pointer_Results On output, contain the baseline results.
+ * @return -1 if the file could not be read or if it is invalid,
+ * @return 0 on success.
+ */
+static int ReplayLoadBaseline(char *Pointer_String_File_Name, TReplayResults *Pointer_Results)
+{
+	FILE *Pointer_File;
+	char *Pointer_String_Line = NULL;
+	size_t Line_Size = 0;
+	int Return_Value = -1;
+
+	Pointer_File = fopen(Pointer_String_File_Name, "r");
+	if (Pointer_File == NULL)
+	{
+		fprintf(stderr, "Error : could not open the baseline file \"%s\".\n", Pointer_String_File_Name);
+		return -1;
+	}
+
+	while (getline(&Pointer_String_Line, &Line_Size, Pointer_File) > 0)
+	{
+		// Skip the header and the empty lines
+		if ((strncmp(Pointer_String_Line, "puzzle,", 7) == 0) || (Pointer_String_Line[strspn(Pointer_String_Line, "\r\n")] == 0)) continue;
+		if (ReplayParseResult(Pointer_String_Line, Pointer_Results) != 0) goto Exit;
+	}
+	Return_Value = 0;
+
+Exit:
+	free(Pointer_String_Line);
+	fclose(Pointer_File);
+	return Return_Value;
+}
+
+/** List the puzzle files of a directory in alphabetical order.
+ * @param Pointer_String_Directory_Name The directory.
+ * @param Pointer_Pointer_Pointer_Strings_Names On output, contain the heap-allocated array of heap-allocated file names.
+ * @param Pointer_Names_Count On output, contain how many file names the array contains.
+ * @return -1 if the directory could not be read or if no more heap memory is available,
+ * @return 0 on success.
+ */
+static int ReplayListPuzzles(char *Pointer_String_Directory_Name, char ***Pointer_Pointer_Pointer_Strings_Names, int *Pointer_Names_Count)
+{
+	DIR *Pointer_Directory;
+	struct dirent *Pointer_Directory_Entry;
+	char **Pointer_Pointer_Strings_Names = NULL, **Pointer_Pointer_Strings_New_Names;
+	size_t Length;
+	int Count = 0, Return_Value = -1;
+
+	Pointer_Directory = opendir(Pointer_String_Directory_Name);
+	if (Pointer_Directory == NULL)
+	{
+		fprintf(stderr, "Error : could not open the directory \"%s\".\n", Pointer_String_Directory_Name);
+		return -1;
+	}
+
+	while ((Pointer_Directory_Entry = readdir(Pointer_Directory)) != NULL)
+	{
+		Length = strlen(Pointer_Directory_Entry->d_name);
+		if ((Length <= 4) || (strcmp(&Pointer_Directory_Entry->d_name[Length - 4], ".txt") != 0)) continue;
+
+		Pointer_Pointer_Strings_New_Names = realloc(Pointer_Pointer_Strings_Names, (Count + 1) * sizeof(char *));
+		if (Pointer_Pointer_Strings_New_Names == NULL) goto Exit;
+		Pointer_Pointer_Strings_Names = Pointer_Pointer_Strings_New_Names;
+		Pointer_Pointer_Strings_Names[Count] = strdup(Pointer_Directory_Entry->d_name);
+		if (Pointer_Pointer_Strings_Names[Count] == NULL) goto Exit;
+		Count++;
+	}
+	qsort(Pointer_Pointer_Strings_Names, Count, sizeof(char *), ReplayCompareNames);
+	Return_Value = 0;
+
+Exit:
+	if (Return_Value != 0) fprintf(stderr, "Error : not enough memory to list the directory \"%s\" files.\n", Pointer_String_Directory_Name);
+	closedir(Pointer_Directory);
+	*Pointer_Pointer_Pointer_Strings_Names = Pointer_Pointer_Strings_Names;
+	*Pointer_Names_Count = Count;
+	return Return_Value;
+}
+
+/** Hash the locations of all words of a solved puzzle, in the word table order.
+ * @param Pointer_Puzzle The solved puzzle.
+ * @return The locations hash.
+ */
+static unsigned long long ReplayHashLocations(TSolverPuzzle *Pointer_Puzzle)
+{
+	unsigned long long Hash = REPLAY_HASH_OFFSET, Location_Key;
+	int Word_Index, i;
+
+	for (Word_Index = 0; Word_Index < Pointer_Puzzle->Word_Table.Words_Count; Word_Index++)
+	{
+		Location_Key = (unsigned long long) Pointer_Puzzle->Pointer_Location_Keys[Word_Index];
+		for (i = 0; i < 8; i++)
+		{
+			Hash = (Hash ^ (Location_Key & 0xFF)) * REPLAY_HASH_PRIME;
+			Location_Key >>= 8;
+		}
+	}
+	return Hash;
+}
+
+/** Solve a puzzle many times with a strategy and append its results to a list.
+ * @param Pointer_Parameters The replay parameters.
+ * @param Pointer_String_Path The puzzle file.
+ * @param Pointer_String_Puzzle_Name The puzzle name to record.
+ * @param Strategy How to search the words.
+ * @param Pointer_Results The list to append the results to.
+ * @return -1 if the results are not the same each time or if no more heap memory is available,
+ * @return 0 on success.
+ */
+static int ReplayMeasure(TReplayParameters *Pointer_Parameters, char *Pointer_String_Path, char *Pointer_String_Puzzle_Name, TSolverStrategy Strategy, TReplayResults *Pointer_Results)
+{
+	TSolverPuzzle Puzzle;
+	TReplayResult *Pointer_Result;
+	double *Pointer_Durations, Time;
+	int i, Is_Solved, Repetitions_Count = Pointer_Parameters->Repetitions_Count, Return_Value = -1;
+	unsigned long long Locations_Hash = 0;
+
+	SolverPuzzleInitialize(&Puzzle, 0);
+	Pointer_Durations = malloc(Repetitions_Count * sizeof(double));
+	if (Pointer_Durations == NULL)
+	{
+		fprintf(stderr, "Error : not enough memory to store the measures.\n");
+		goto Exit;
+	}
+
+	// A first solve warms the caches up and gives the results all next solves must reproduce
+	Is_Solved = SolverSolvePuzzle(&Puzzle, Pointer_String_Path, Strategy, 1) == 0;
+	if (Is_Solved) Locations_Hash = ReplayHashLocations(&Puzzle);
+	if (ReplayAddResult(Pointer_Results, Pointer_String_Puzzle_Name, Strategy, Is_Solved, Locations_Hash, 0, 0, Is_Solved ? Puzzle.Pointer_String_Hidden_Word : "") != 0) goto Exit;
+	Pointer_Result = &Pointer_Results->Pointer_Results[Pointer_Results->Count - 1];
+
+	for (i = 0; i < Repetitions_Count; i++)
+	{
+		Time = SolverGetTime();
+		Is_Solved = SolverSolvePuzzle(&Puzzle, Pointer_String_Path, Strategy, 1) == 0;
+		Pointer_Durations[i] = (SolverGetTime() - Time) * 1000000.0;
+
+		if ((Is_Solved != Pointer_Result->Solved_Count) || (Is_Solved && ((ReplayHashLocations(&Puzzle) != Locations_Hash) || (strcmp(Puzzle.Pointer_String_Hidden_Word, Pointer_Result->Pointer_String_Hidden_Word) != 0))))
+		{
+			fprintf(stderr, "Error : the results of the puzzle \"%s\" with the %s strategy change from a solve to another.\n", Pointer_String_Puzzle_Name, Solver_Strategy_Names[Strategy]);
+			goto Exit;
+		}
+	}
+
+	qsort(Pointer_Durations, Repetitions_Count, sizeof(double), ReplayCompareDurations);
+	Pointer_Result->Median_Duration = Pointer_Durations[Repetitions_Count / 2];
+	Pointer_Result->Percentile_99_Duration = Pointer_Durations[(Repetitions_Count * 99 + 99) / 100 - 1]; // Nearest-rank method
+	Return_Value = 0;
+
+Exit:
+	free(Pointer_Durations);
+	SolverPuzzleFree(&Puzzle);
+	return Return_Value;
+}
+
+/** Compare a result to its baseline.
+ * @param Pointer_Parameters The replay parameters.
+ * @param Pointer_Result The result.
+ * @param Pointer_Baseline The baseline results.
+ * @param Is_Regression_Reported Set to display an error message if the duration regressed, clear to report the regression only with the return value.
+ * @return -1 if the result is not in the baseline or if it differs from the baseline (an error message has been displayed),
+ * @return 1 if the duration regressed,
+ * @return 0 on success.
+ */
+static int ReplayCompareResult(TReplayParameters *Pointer_Parameters, TReplayResult *Pointer_Result, TReplayResults *Pointer_Baseline, int Is_Regression_Reported)
+{
+	TReplayResult *Pointer_Baseline_Result = NULL;
+	int i;
+
+	for (i = 0; i < Pointer_Baseline->Count; i++)
+	{
+		if ((Pointer_Baseline->Pointer_Results[i].Strategy == Pointer_Result->Strategy) && (strcmp(Pointer_Baseline->Pointer_Results[i].Pointer_String_Puzzle_Name, Pointer_Result->Pointer_String_Puzzle_Name) == 0))
+		{
+			Pointer_Baseline_Result = &Pointer_Baseline->Pointer_Results[i];
+			break;
+		}
+	}
+	if (Pointer_Baseline_Result == NULL)
+	{
+		fprintf(stderr, "Error : the puzzle \"%s\" with the %s strategy is not in the baseline, the baseline must be recorded again.\n", Pointer_Result->Pointer_String_Puzzle_Name, Solver_Strategy_Names[Pointer_Result->Strategy]);
+		return -1;
+	}
+
+	// Any change of the results is an error
+	if ((Pointer_Result->Solved_Count != Pointer_Baseline_Result->Solved_Count) || (Pointer_Result->Locations_Hash != Pointer_Baseline_Result->Locations_Hash) || (strcmp(Pointer_Result->Pointer_String_Hidden_Word, Pointer_Baseline_Result->Pointer_String_Hidden_Word) != 0))
+	{
+		fprintf(stderr, "Error : the results of the puzzle \"%s\" with the %s strategy differ from the baseline.\n", Pointer_Result->Pointer_String_Puzzle_Name, Solver_Strategy_Names[Pointer_Result->Strategy]);
+		return -1;
+	}
+
+	// Small durations are noisy, so the difference must also be big enough
+	if ((Pointer_Result->Median_Duration > Pointer_Baseline_Result->Median_Duration * (1.0 + Pointer_Parameters->Threshold_Percentage / 100.0)) && (Pointer_Result->Median_Duration - Pointer_Baseline_Result->Median_Duration > Pointer_Parameters->Noise_Floor))
+	{
+		if (Is_Regression_Reported) fprintf(stderr, "Error : the puzzle \"%s\" with the %s strategy takes %.3f us instead of %.3f us (%+.1f %%).\n", Pointer_Result->Pointer_String_Puzzle_Name, Solver_Strategy_Names[Pointer_Result->Strategy], Pointer_Result->Median_Duration, Pointer_Baseline_Result->Median_Duration, (Pointer_Result->Median_Duration / Pointer_Baseline_Result->Median_Duration - 1.0) * 100.0);
+		return 1;
+	}
+
+	return 0;
+}
+
+//-------------------------------------------------------------------------------------------------
+// Public functions
+//-------------------------------------------------------------------------------------------------
+int ReplayRun(TReplayParameters *Pointer_Parameters)
+{
+	TReplayResults Results, Baseline;
+	TSolverStrategy Strategy, First_Strategy, Last_Strategy;
+	char **Pointer_Pointer_Strings_Puzzle_Names = NULL, String_Path[PATH_MAX];
+	int i, Puzzles_Count = 0, First_Result_Index, Solved_Count, Attempt, Comparison_Result, Is_Baseline_Compared, Is_Regression_Detected = 0, Return_Value = -1;
+	unsigned long long Locations_Hash;
+	double Median_Duration, Percentile_99_Duration;
+	FILE *Pointer_File;
+
+	memset(&Results, 0, sizeof(Results));
+	memset(&Baseline, 0, sizeof(Baseline));
+
+	if (ReplayListPuzzles(Pointer_Parameters->Pointer_String_Directory_Name, &Pointer_Pointer_Strings_Puzzle_Names, &Puzzles_Count) != 0) goto Exit;
+	if (Puzzles_Count == 0)
+	{
+		fprintf(stderr, "Error : the directory \"%s\" does not contain any puzzle.\n", Pointer_Parameters->Pointer_String_Directory_Name);
+		goto Exit;
+	}
+	Is_Baseline_Compared = !Pointer_Parameters->Is_Recording && (Pointer_Parameters->Pointer_String_Baseline_File_Name != NULL);
+	if (Is_Baseline_Compared && (ReplayLoadBaseline(Pointer_Parameters->Pointer_String_Baseline_File_Name, &Baseline) != 0)) goto Exit;
+
+	if (Pointer_Parameters->Is_Single_Strategy)
+	{
+		First_Strategy = Pointer_Parameters->Strategy;
+		Last_Strategy = Pointer_Parameters->Strategy;
+	}
+	else
+	{
+		First_Strategy = 0;
+		Last_Strategy = SOLVER_STRATEGIES_COUNT - 1;
+	}
+
+	printf("puzzle,strategy,solved,locations_hash,median_us,p99_us,hidden_word\n");
+	for (Strategy = First_Strategy; Strategy <= Last_Strategy; Strategy++)
+	{
+		// Replay all puzzles
+		First_Result_Index = Results.Count;
+		for (i = 0; i < Puzzles_Count; i++)
+		{
+			snprintf(String_Path, sizeof(String_Path), "%s/%s", Pointer_Parameters->Pointer_String_Directory_Name, Pointer_Pointer_Strings_Puzzle_Names[i]);
+			for (Attempt = 1; ; Attempt++)
+			{
+				if (ReplayMeasure(Pointer_Parameters, String_Path, Pointer_Pointer_Strings_Puzzle_Names[i], Strategy, &Results) != 0) goto Exit;
+				if (!Is_Baseline_Compared) break;
+
+				// Another program may have slowed the measure down, so a slower puzzle is measured again a bit later before reporting a regression
+				Comparison_Result = ReplayCompareResult(Pointer_Parameters, &Results.Pointer_Results[Results.Count - 1], &Baseline, Attempt == REPLAY_MAXIMUM_ATTEMPTS_COUNT);
+				if ((Comparison_Result != 1) || (Attempt == REPLAY_MAXIMUM_ATTEMPTS_COUNT)) break;
+				ReplayRemoveLastResult(&Results);
+				sleep(1);
+			}
+			if (Is_Baseline_Compared && (Comparison_Result != 0)) Is_Regression_Detected = 1;
+			ReplayPrintResult(stdout, &Results.Pointer_Results[Results.Count - 1]);
+		}
+
+		// Sum the strategy results, the total locations hash also depends on the puzzles order
+		Solved_Count = 0;
+		Locations_Hash = REPLAY_HASH_OFFSET;
+		Median_Duration = 0;
+		Percentile_99_Duration = 0;
+		for (i = First_Result_Index; i < Results.Count; i++)
+		{
+			Solved_Count += Results.Pointer_Results[i].Solved_Count;
+			Locations_Hash = (Locations_Hash ^ Results.Pointer_Results[i].Locations_Hash) * REPLAY_HASH_PRIME;
+			Median_Duration += Results.Pointer_Results[i].Median_Duration;
+			Percentile_99_Duration += Results.Pointer_Results[i].Percentile_99_Duration;
+		}
+		if (ReplayAddResult(&Results, REPLAY_TOTAL_NAME, Strategy, Solved_Count, Locations_Hash, Median_Duration, Percentile_99_Duration, "") != 0) goto Exit;
+		if (Is_Baseline_Compared && (ReplayCompareResult(Pointer_Parameters, &Results.Pointer_Results[Results.Count - 1], &Baseline, 1) != 0)) Is_Regression_Detected = 1;
+		ReplayPrintResult(stdout, &Results.Pointer_Results[Results.Count - 1]);
+		fflush(stdout);
+	}
+
+	// Write the new baseline
+	if (Pointer_Parameters->Is_Recording)
+	{
+		Pointer_File = fopen(Pointer_Parameters->Pointer_String_Baseline_File_Name, "w");
+		if (Pointer_File == NULL)
+		{
+			fprintf(stderr, "Error : could not create the baseline file \"%s\".\n", Pointer_Parameters->Pointer_String_Baseline_File_Name);
+			goto Exit;
+		}
+		fprintf(Pointer_File, "puzzle,strategy,solved,locations_hash,median_us,p99_us,hidden_word\n");
+		for (i = 0; i < Results.Count; i++) ReplayPrintResult(Pointer_File, &Results.Pointer_Results[i]);
+		if (fclose(Pointer_File) != 0)
+		{
+			fprintf(stderr, "Error : could not write the baseline file \"%s\".\n", Pointer_Parameters->Pointer_String_Baseline_File_Name);
+			goto Exit;
+		}
+		fprintf(stderr, "The baseline file \"%s\" has been recorded.\n", Pointer_Parameters->Pointer_String_Baseline_File_Name);
+	}
+	// Or tell whether the results match the baseline, once all differences have been reported
+	else if (Is_Baseline_Compared)
+	{
+		if (Is_Regression_Detected)
+		{
+			fprintf(stderr, "Error : the replay does not match the baseline file \"%s\".\n", Pointer_Parameters->Pointer_String_Baseline_File_Name);
+			goto Exit;
+		}
+		fprintf(stderr, "The replay matches the baseline file \"%s\" (threshold %.1f %%, noise floor %.1f us).\n", Pointer_Parameters->Pointer_String_Baseline_File_Name, Pointer_Parameters->Threshold_Percentage, Pointer_Parameters->Noise_Floor);
+	}
+	Return_Value = 0;
+
+Exit:
+	for (i = 0; i < Puzzles_Count; i++) free(Pointer_Pointer_Strings_Puzzle_Names[i]);
+	free(Pointer_Pointer_Strings_Puzzle_Names);
+	ReplayFreeResults(&Results);
+	ReplayFreeResults(&Baseline);
+	return Return_Value;
+}
@@ -0,0 +1,36 @@
+/** @file Replay.h
+ * Solve all puzzles of a directory many times with each strategy, then compare their results and durations to a baseline file recorded earlier. The baseline is a CSV file with a line per puzzle and per strategy (puzzle, strategy, solved flag, words locations hash, median and 99th percentile durations in microseconds, hidden word), plus a "total" line per strategy summing the puzzles lines.
+ * @author Adrien RICCIARDI
+ */
+#ifndef H_REPLAY_H
+#define H_REPLAY_H
+
+#include <Solver.h>
+
+//-------------------------------------------------------------------------------------------------
+// Types
+//-------------------------------------------------------------------------------------------------
+/** How to replay a puzzles corpus. */
+typedef struct
+{
+	char *Pointer_String_Directory_Name; //!< The directory containing the puzzles (the files ending with ".txt").
+	char *Pointer_String_Baseline_File_Name; //!< The baseline to compare the results to, or to write when recording. Set to NULL to only print the results.
+	int Is_Recording; //!< Set to write the results to the baseline file instead of comparing them.
+	int Repetitions_Count; //!< How many times each puzzle is solved with each strategy.
+	int Is_Single_Strategy; //!< Set to replay only the strategy field one, clear to replay all strategies.
+	TSolverStrategy Strategy; //!< The strategy to replay when a single strategy is replayed.
+	double Threshold_Percentage; //!< How much slower than the baseline a puzzle median duration can be before it is considered a regression.
+	double Noise_Floor; //!< Duration differences smaller than this many microseconds are never considered a regression, whatever the threshold.
+} TReplayParameters;
+
+//-------------------------------------------------------------------------------------------------
+// Functions
+//-------------------------------------------------------------------------------------------------
+/** Replay all puzzles of a directory and print their results in the baseline format.
+ * @param Pointer_Parameters What to replay.
+ * @return -1 if a puzzle could not be replayed, if a result differs from the baseline or if a duration regressed past the threshold,
+ * @return 0 on success.
+ */
+int ReplayRun(TReplayParameters *Pointer_Parameters);
+
+#endif
@@ -0,0 +1,68 @@
+/** @file Aho_Corasick.h
+ * Search all words at once by streaming every grid line, in all directions, through a single Aho-Corasick automaton.
+ * @author Adrien RICCIARDI
+ */
+#ifndef H_AHO_CORASICK_H
+#define H_AHO_CORASICK_H
+
+#include <Grid.h>
+
+//-------------------------------------------------------------------------------------------------
+// Types
+//-------------------------------------------------------------------------------------------------
+/** The automaton built from all words to search. State 0 is the root state. */
+typedef struct
+{
+	int *Pointer_Transitions; //!< The next state for each state and letter (CONFIGURATION_ALPHABET_LETTERS_COUNT entries per state). Once the automaton is built, all transitions are valid.
+	int *Pointer_Failure_States; //!< The state corresponding to the longest proper suffix of a state that is also a state.
+	int *Pointer_Dictionary_States; //!< The next state of the failure chain that ends a word, or -1 if there is none.
+	int *Pointer_First_Words; //!< The index of the first word ending on a state, or -1 if no word ends on this state.
+	int States_Count;
+	int Allocated_States_Count;
+	int *Pointer_Next_Words; //!< For each word, the index of the next word ending on the same state (several identical words can be searched), or -1.
+	int *Pointer_Word_Lengths; //!< The length of each word.
+} TAhoCorasickAutomaton;
+
+/** Called for each word occurrence found by AhoCorasickFindAllOccurrences().
+ * @param Pointer_Parameters The parameters provided to AhoCorasickFindAllOccurrences().
+ * @param Word_Index The found word index in the table the automaton has been built from.
+ * @param Row The word first letter row.
+ * @param Column The word first letter column.
+ * @param Direction The direction the word is written to.
+ */
+typedef void (*TAhoCorasickOccurrenceCallback)(void *Pointer_Parameters, int Word_Index, int Row, int Column, TGridDirection Direction);
+
+//-------------------------------------------------------------------------------------------------
+// Functions
+//-------------------------------------------------------------------------------------------------
+/** Build the automaton recognizing all words of a table. The automaton can then search as many grids as needed.
+ * @param Pointer_Automaton The automaton to build. It must be freed with AhoCorasickFree(), even if the build failed.
+ * @param Pointer_Word_Table The words to recognize. The automaton does not keep any pointer to the table.
+ * @return -1 if no more heap memory is available,
+ * @return 0 on success.
+ */
+int AhoCorasickBuild(TAhoCorasickAutomaton *Pointer_Automaton, TWordTable *Pointer_Word_Table);
+
+/** Release all memory allocated by an automaton.
+ * @param Pointer_Automaton The automaton to free.
+ */
+void AhoCorasickFree(TAhoCorasickAutomaton *Pointer_Automaton);
+
+/** Report every occurrence of every word in a grid, in all directions. The grid is read only once per direction, so the search time only depends on the grid size and on the amount of occurrences.
+ * @param Pointer_Automaton The automaton built from the words to search.
+ * @param Pointer_Grid The grid to search words in.
+ * @param Callback Called for each occurrence. Occurrences are reported direction after direction, following each grid line.
+ * @param Pointer_Callback_Parameters Provided as is to the callback.
+ */
+void AhoCorasickFindAllOccurrences(TAhoCorasickAutomaton *Pointer_Automaton, TGrid *Pointer_Grid, TAhoCorasickOccurrenceCallback Callback, void *Pointer_Callback_Parameters);
+
+/** Find the first location of every word to search, using the same location order than the cell-by-cell scan.
+ * @param Pointer_Grid The grid to search words in.
+ * @param Pointer_Word_Table The words to search. The table is not modified, the words already found are searched too.
+ * @param Pointer_Location_Keys On output, contain one location key (see GRID_MAKE_LOCATION_KEY()) per word, or -1 if the word was not found. Words are numbered like in the word table.
+ * @return -1 if no more heap memory is available,
+ * @return 0 on success.
+ */
+int AhoCorasickFindWords(TGrid *Pointer_Grid, TWordTable *Pointer_Word_Table, long long *Pointer_Location_Keys);
+
+#endif
@@ -0,0 +1,82 @@
+/** @file Cache.h
+ * Keep the results of the solved puzzles on disk, so a puzzle solved again is not searched again. Each entry is a file of the cache directory named after a 128-bit hash of the normalized puzzle (the uppercase grid and the words in the table order), it stores the location of each word and the hidden word.
+ * Entries are written to a temporary file then renamed, so several processes and threads can share the same directory. Reading an entry marks it as recently used, and the least recently used entries are removed when the directory grows bigger than its maximum size. The directory size is estimated from the written entries, so it is listed only when the estimate exceeds the maximum size, or once in a while to notice the entries written by other processes.
+ * @author Adrien RICCIARDI
+ */
+#ifndef H_CACHE_H
+#define H_CACHE_H
+
+#include <Grid.h>
+#include <pthread.h>
+#include <stddef.h>
+#include <Word_Table.h>
+
+//-------------------------------------------------------------------------------------------------
+// Types
+//-------------------------------------------------------------------------------------------------
+/** A cache directory. It can be shared by all threads. */
+typedef struct
+{
+	char *Pointer_String_Directory_Name; //!< Where the entries are stored.
+	long long Maximum_Size; //!< How many bytes all entries can use at most.
+	long long Estimated_Size; //!< How many bytes the entries used when the directory was last listed, plus the size of the entries stored since.
+	int Stores_Count; //!< How many entries have been stored since the directory was last listed.
+	pthread_mutex_t Mutex; //!< Protect the size estimate and the stores count.
+} TCache;
+
+/** Identify a puzzle in the cache. */
+typedef struct
+{
+	unsigned long long Hashes[2]; //!< Two hashes of the puzzle computed with different seeds.
+} TCacheKey;
+
+//-------------------------------------------------------------------------------------------------
+// Functions
+//-------------------------------------------------------------------------------------------------
+/** Use a directory as a cache, creating it if needed.
+ * @param Pointer_Cache The cache to initialize.
+ * @param Pointer_String_Directory_Name The cache directory.
+ * @param Maximum_Size How many bytes all entries can use at most.
+ * @return -1 if the directory could not be created or if no more heap memory is available,
+ * @return 0 on success.
+ */
+int CacheInitialize(TCache *Pointer_Cache, char *Pointer_String_Directory_Name, long long Maximum_Size);
+
+/** Release the memory used by a cache, its entries are kept on disk.
+ * @param Pointer_Cache The cache to free.
+ */
+void CacheFree(TCache *Pointer_Cache);
+
+/** Hash a loaded puzzle.
+ * @param Pointer_Grid The puzzle grid.
+ * @param Pointer_Word_Table The puzzle words.
+ * @param Pointer_Key On output, contain the puzzle key.
+ */
+void CacheComputeKey(TGrid *Pointer_Grid, TWordTable *Pointer_Word_Table, TCacheKey *Pointer_Key);
+
+/** Retrieve the results of a puzzle from the cache.
+ * @param Pointer_Cache The cache.
+ * @param Pointer_Key The puzzle key.
+ * @param Pointer_Grid The puzzle grid, its size must match the entry one.
+ * @param Pointer_Word_Table The puzzle words, their count must match the entry one.
+ * @param Pointer_Location_Keys On output, contain the location key (see GRID_MAKE_LOCATION_KEY()) of each word of the table. Its content is undefined if the puzzle is not cached.
+ * @param Pointer_Pointer_String_Hidden_Word On output, contain the hidden word. The buffer is grown if needed.
+ * @param Pointer_Buffer_Size On input, contain the hidden word buffer size. On output, contain the new buffer size if the buffer has been grown.
+ * @return 0 if the puzzle is not cached (or if its entry could not be read),
+ * @return 1 if the results have been retrieved.
+ */
+int CacheLoad(TCache *Pointer_Cache, TCacheKey *Pointer_Key, TGrid *Pointer_Grid, TWordTable *Pointer_Word_Table, long long *Pointer_Location_Keys, char **Pointer_Pointer_String_Hidden_Word, size_t *Pointer_Buffer_Size);
+
+/** Add the results of a solved puzzle to the cache, then remove the least recently used entries if the cache seems full.
+ * @param Pointer_Cache The cache.
+ * @param Pointer_Key The puzzle key.
+ * @param Pointer_Grid The puzzle grid.
+ * @param Pointer_Word_Table The puzzle words.
+ * @param Pointer_Location_Keys The location key of each word of the table.
+ * @param Pointer_String_Hidden_Word The puzzle hidden word.
+ * @return -1 if the entry could not be written,
+ * @return 0 on success.
+ */
+int CacheStore(TCache *Pointer_Cache, TCacheKey *Pointer_Key, TGrid *Pointer_Grid, TWordTable *Pointer_Word_Table, long long *Pointer_Location_Keys, char *Pointer_String_Hidden_Word);
+
+#endif
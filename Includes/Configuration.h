@@ -8,16 +8,19 @@
 //-------------------------------------------------------------------------------------------------
 // Constants
 //-------------------------------------------------------------------------------------------------
-/** The maximum size (including the terminating zero) of a word to search. */
-#define CONFIGURATION_WORD_LIST_ITEM_MAXIMUM_STRING_SIZE 32
+/** The maximum size (including the terminating zero) of a word to search. Words of up to 64 letters fit in a single 64-bit word of the shift-and strategy. */
+#define CONFIGURATION_WORD_MAXIMUM_STRING_SIZE 65
 
-/** How long can be the hidden word (it can exceed the largest grid dimension). */
-#define CONFIGURATION_HIDDEN_WORD_MAXIMUM_STRING_SIZE 256
-
-/** The grid containing the letters to search the words from won't be greater than this dimension. */
-#define CONFIGURATION_GRID_MAXIMUM_SIZE CONFIGURATION_WORD_LIST_ITEM_MAXIMUM_STRING_SIZE
+/** The grid containing the letters to search the words from won't have more rows or columns than this value. The grid memory is allocated according to the loaded grid size, this limit only guarantees that cell indexes fit in an int. */
+#define CONFIGURATION_GRID_MAXIMUM_SIZE 32768
 
 /** How many letters in the latin alphabet. */
 #define CONFIGURATION_ALPHABET_LETTERS_COUNT 26
 
+/** How many grid rows the streaming mode searches at once by default (the bands also contain the rows shared with the next band). */
+#define CONFIGURATION_STREAM_BAND_ROWS_COUNT 1024
+
+/** How many mebibytes the results cache can use by default. */
+#define CONFIGURATION_CACHE_MAXIMUM_SIZE 64
+
 #endif
@@ -0,0 +1,48 @@
+/** @file Dictionary.h
+ * Find every occurrence of the words of a big list (a dictionary) in grids. The dictionary is loaded once, then it can sweep as many grids as needed.
+ * @author Adrien RICCIARDI
+ */
+#ifndef H_DICTIONARY_H
+#define H_DICTIONARY_H
+
+#include <Aho_Corasick.h>
+#include <Grid.h>
+#include <Word_Table.h>
+
+//-------------------------------------------------------------------------------------------------
+// Types
+//-------------------------------------------------------------------------------------------------
+/** A loaded dictionary. */
+typedef struct
+{
+	TGrid File_Holder; //!< Keep the dictionary file content the words point to, it never contains a grid.
+	TWordTable Word_Table; //!< The dictionary words.
+	TAhoCorasickAutomaton Automaton; //!< Recognize all dictionary words at once.
+	int Skipped_Words_Count; //!< How many words of the file could not be searched.
+} TDictionary;
+
+//-------------------------------------------------------------------------------------------------
+// Functions
+//-------------------------------------------------------------------------------------------------
+/** Load a dictionary file (words separated by whitespaces, usually one per line) and build the automaton recognizing its words.
+ * @param Pointer_Dictionary The dictionary to load. It must be freed with DictionaryFree(), even if loading failed.
+ * @param Pointer_String_File_Name The dictionary file.
+ * @return -1 if an error occurred,
+ * @return 0 on success.
+ */
+int DictionaryLoad(TDictionary *Pointer_Dictionary, char *Pointer_String_File_Name);
+
+/** Release all memory used by a dictionary.
+ * @param Pointer_Dictionary The dictionary to free.
+ */
+void DictionaryFree(TDictionary *Pointer_Dictionary);
+
+/** Report every occurrence of every dictionary word in a grid, in all directions, including words found several times. The search time only depends on the grid size and on the amount of occurrences.
+ * @param Pointer_Dictionary The dictionary.
+ * @param Pointer_Grid The grid to sweep.
+ * @param Callback Called for each occurrence, the word index refers to the dictionary word table.
+ * @param Pointer_Callback_Parameters Provided as is to the callback.
+ */
+void DictionarySweepGrid(TDictionary *Pointer_Dictionary, TGrid *Pointer_Grid, TAhoCorasickOccurrenceCallback Callback, void *Pointer_Callback_Parameters);
+
+#endif
@@ -1,50 +1,223 @@
 /** @file Grid.h
- * Allow simple access to grid content regardless of its size.
+ * Allow simple access to grid content regardless of its size. Each function works on a grid object, so several grids can be used at the same time (by different threads for instance).
  * @author Adrien RICCIARDI
  */
 #ifndef H_GRID_H
 #define H_GRID_H
 
-#include <Word_List.h>
+#include <stddef.h>
+#include <Word_Table.h>
+
+//-------------------------------------------------------------------------------------------------
+// Types
+//-------------------------------------------------------------------------------------------------
+/** A grid and the memory needed to load it. The memory is kept when a new grid is loaded, so loading many grids with the same object does not allocate memory anymore once the biggest grid has been loaded. */
+typedef struct
+{
+	char *Pointer_Letters; //!< The grid letters to search words from, row after row. The rows are the first strip, they are followed by the columns, diagonals and anti-diagonals strips, each grid line being contiguous so the letters following a cell in any direction can be compared at once (the backward directions read the strips in reverse). With the found bits, a grid uses 4.125 bytes per cell.
+	size_t Allocated_Letters_Count; //!< How many bytes can be stored in the letters buffer.
+	unsigned long long *Pointer_Found_Bits; //!< A bit per cell (in the letters order), set when the cell letter is part of a found word.
+	size_t Allocated_Found_Bits_Count; //!< How many 64-bit words can be stored in the found bits buffer.
+	char *Pointer_File_Content; //!< The loaded file content, the loaded words point to it.
+	size_t Mapping_Size; //!< The size in bytes of the loaded file mapping, or 0 if the file content has been read into the file buffer instead.
+	char *Pointer_File_Buffer; //!< Receive the content of the files that can't be mapped. It grows to fit the biggest read file.
+	size_t File_Buffer_Size; //!< The file buffer size in bytes.
+	int *Pointer_Diagonal_Offsets; //!< Where each diagonal strip starts, followed by where each anti-diagonal strip starts.
+	size_t Allocated_Diagonal_Offsets_Count; //!< How many offsets can be stored in the diagonal offsets buffer.
+	int (*Pointer_Compare_Letters_Function)(const char *Pointer_Letters, const char *Pointer_String_Word, int Length); //!< The fastest letters comparison kernel the processor supports, selected when the grid is initialized.
+	int Rows_Count; //!< How many rows have the loaded grid.
+	int Columns_Count; //!< How many columns have the loaded grid.
+} TGrid;
+
+/** All directions a word can be written to, in the order GridMatchWordWithPosition() tries them. */
+typedef enum
+{
+	GRID_DIRECTION_NORTH,
+	GRID_DIRECTION_NORTH_EAST,
+	GRID_DIRECTION_EAST,
+	GRID_DIRECTION_SOUTH_EAST,
+	GRID_DIRECTION_SOUTH,
+	GRID_DIRECTION_SOUTH_WEST,
+	GRID_DIRECTION_WEST,
+	GRID_DIRECTION_NORTH_WEST,
+	GRID_DIRECTIONS_COUNT
+} TGridDirection;
+
+/** The work done by a cell-by-cell search, to understand why a puzzle takes longer than another. */
+typedef struct
+{
+	long long Visited_Cells_Count; //!< How many grid cells have been tried as a word start.
+	long long Candidate_Pairs_Count; //!< How many (word, cell) pairs have been tried.
+	long long Rejected_Directions_Count; //!< How many direction attempts have been rejected because the word did not fit between the cell and the grid border.
+	long long Compared_Letters_Count; //!< How many letters have been given to the comparison kernel.
+	long long Matches_Count; //!< How many words have been located.
+} TGridSearchCounters;
+
+//-------------------------------------------------------------------------------------------------
+// Constants
+//-------------------------------------------------------------------------------------------------
+/** Encode a word location into a single number. Keys compare in the same order than the cell-by-cell scan would discover the locations (row first, then column, then direction). */
+#define GRID_MAKE_LOCATION_KEY(Row, Column, Columns_Count, Direction) ((((long long) (Row) * (Columns_Count)) + (Column)) * GRID_DIRECTIONS_COUNT + (Direction))
+
+/** Get a grid letter without checking the coordinates, for the loops that already iterate inside the grid (see GridGetLetter() for the checked version). */
+#define GRID_GET_LETTER(Pointer_Grid, Row, Column) ((Pointer_Grid)->Pointer_Letters[(Row) * (Pointer_Grid)->Columns_Count + (Column)])
+
+//-------------------------------------------------------------------------------------------------
+// Variables
+//-------------------------------------------------------------------------------------------------
+/** The name of each direction, indexed by a TGridDirection value. */
+extern const char *Grid_Direction_Names[GRID_DIRECTIONS_COUNT];
 
 //-------------------------------------------------------------------------------------------------
 // Functions
 //-------------------------------------------------------------------------------------------------
-/** Load a grid content and the words to search from a file.
+/** Make a grid object ready to use.
+ * @param Pointer_Grid The grid to initialize.
+ */
+void GridInitialize(TGrid *Pointer_Grid);
+
+/** Release all memory used by a grid. The grid can be loaded again afterwards.
+ * @param Pointer_Grid The grid to free.
+ */
+void GridFree(TGrid *Pointer_Grid);
+
+/** Load a grid content and the words to search from a file. The file is mapped in memory and parsed in place when possible.
+ * @param Pointer_Grid The grid to load the content to. Any previously loaded content is discarded.
  * @param Pointer_String_File_Name The file name to load.
- * @param Pointer_Word_Lists On output, fill the word lists (one per alphabet letter).
+ * @param Pointer_Word_Table On output, contain the words to search, none of them being found. The table must have been initialized, its previous content is discarded. The words point to the grid copy of the file content, they are valid until the grid is loaded again or freed.
+ * @param Pointer_Rows_Count On output, contain the grid row dimension.
+ * @param Pointer_Columns_Count On output, contain the grid column dimension.
+ * @param Pointer_Words_Count On output, contain the amount of words to find in the grid.
+ * @return -1 if an error occurred,
+ * @return 0 on success.
+ */
+int GridLoadFromFile(TGrid *Pointer_Grid, char *Pointer_String_File_Name, TWordTable *Pointer_Word_Table, int *Pointer_Rows_Count, int *Pointer_Columns_Count, int *Pointer_Words_Count);
+
+/** Load a grid content and the words to search from a memory buffer holding a puzzle file content. The buffer is parsed in place : letters are converted to uppercase and words are terminated in the buffer.
+ * @param Pointer_Grid The grid to load the content to. Any previously loaded content is discarded.
+ * @param Pointer_Content The puzzle content. The byte following the content must be writable, it can be overwritten to terminate the last word.
+ * @param Size The puzzle content size in bytes.
+ * @param Pointer_Word_Table On output, contain the words to search, none of them being found. The table must have been initialized, its previous content is discarded. The words point to the buffer, they are valid as long as the buffer is not modified.
  * @param Pointer_Rows_Count On output, contain the grid row dimension.
  * @param Pointer_Columns_Count On output, contain the grid column dimension.
  * @param Pointer_Words_Count On output, contain the amount of words to find in the grid.
  * @return -1 if an error occurred,
  * @return 0 on success.
  */
-int GridLoadFromFile(char *Pointer_String_File_Name, TWordList *Pointer_Word_Lists, int *Pointer_Rows_Count, int *Pointer_Columns_Count, int *Pointer_Words_Count);
+int GridLoadFromMemory(TGrid *Pointer_Grid, char *Pointer_Content, size_t Size, TWordTable *Pointer_Word_Table, int *Pointer_Rows_Count, int *Pointer_Columns_Count, int *Pointer_Words_Count);
+
+/** Load a list of words from a file, without any grid. The words are separated by whitespaces, the words containing other characters than letters or being too long are ignored.
+ * @param Pointer_Grid The grid object keeping the file content the words point to. Its previously loaded content is discarded, it does not contain any grid afterwards.
+ * @param Pointer_String_File_Name The words file.
+ * @param Pointer_Word_Table On output, contain the loaded words. The table must have been initialized, its previous content is discarded.
+ * @param Pointer_Skipped_Words_Count On output, contain how many words have been ignored.
+ * @return -1 if an error occurred,
+ * @return 0 on success.
+ */
+int GridLoadWordsFromFile(TGrid *Pointer_Grid, char *Pointer_String_File_Name, TWordTable *Pointer_Word_Table, int *Pointer_Skipped_Words_Count);
+
+/** Load a grid from letters already in memory, replacing the previously loaded grid. The words table is not modified.
+ * @param Pointer_Grid The grid.
+ * @param Pointer_Letters The grid letters, row after row. They must all be uppercase letters.
+ * @param Rows_Count How many rows the grid has.
+ * @param Columns_Count How many columns the grid has.
+ * @return -1 if no more heap memory is available,
+ * @return 0 on success.
+ */
+int GridLoadFromLetters(TGrid *Pointer_Grid, char *Pointer_Letters, int Rows_Count, int Columns_Count);
 
 /** Get the letter corresponding to a grid coordinate.
+ * @param Pointer_Grid The grid.
  * @param Row The row coordinate.
  * @param Column The column coordinate.
  * @return The corresponding letter (in range A-Z) or 0 if the provided coordinate is invalid.
  */
-char GridGetLetter(int Row, int Column);
+char GridGetLetter(TGrid *Pointer_Grid, int Row, int Column);
+
+/** Change a grid letter, keeping all the copies used by the search up to date. The found letters are not modified.
+ * @param Pointer_Grid The grid.
+ * @param Row The row coordinate.
+ * @param Column The column coordinate.
+ * @param Letter The new letter, in range A-Z or a-z.
+ * @return -1 if the coordinate or the letter is invalid,
+ * @return 0 on success.
+ */
+int GridSetLetter(TGrid *Pointer_Grid, int Row, int Column, char Letter);
 
-/** Try to find the specified word in every allowed direction starting from the provided coordinates.
+/** Get the letters that can be read from a cell in a direction, up to the grid border.
+ * @param Pointer_Grid The grid.
+ * @param Direction The reading direction.
+ * @param Row The cell row.
+ * @param Column The cell column.
+ * @param Pointer_Letters_Count On output, contain how many letters can be read (including the cell one).
+ * @param Pointer_Step On output, contain 1 if the following letters in the direction are stored right after the cell one, or -1 if they are stored right before it (the north, north-east, west and north-west directions read the strip of the opposite direction in reverse).
+ * @return A pointer on the cell letter, the letter at position i in the direction is at index i * Step.
+ */
+char *GridGetDirectionLetters(TGrid *Pointer_Grid, TGridDirection Direction, int Row, int Column, int *Pointer_Letters_Count, int *Pointer_Step);
+
+/** Try to find the specified word in every allowed direction starting from the provided coordinates, without marking its letters as found.
+ * @param Pointer_Grid The grid.
  * @param Pointer_String_Word The word to search.
+ * @param Word_Length The word length.
+ * @param Row The vertical coordinate to start searching from.
+ * @param Column The horizontal coordinate to start searching from.
+ * @return -1 if the word could not be found,
+ * @return The first matching direction (in TGridDirection order) if the word has been found.
+ * @note This function only reads the grid, so it can be called from several threads at the same time.
+ */
+int GridFindWordDirection(TGrid *Pointer_Grid, char *Pointer_String_Word, int Word_Length, int Row, int Column);
+
+/** Same as GridFindWordDirection(), but also count the rejected directions and the compared letters. Only the instrumented searches pay for the counting.
+ * @param Pointer_Grid The grid.
+ * @param Pointer_String_Word The word to search.
+ * @param Word_Length The word length.
+ * @param Row The vertical coordinate to start searching from.
+ * @param Column The horizontal coordinate to start searching from.
+ * @param Pointer_Counters The counters to update.
+ * @return -1 if the word could not be found,
+ * @return The first matching direction (in TGridDirection order) if the word has been found.
+ */
+int GridFindWordDirectionCounted(TGrid *Pointer_Grid, char *Pointer_String_Word, int Word_Length, int Row, int Column, TGridSearchCounters *Pointer_Counters);
+
+/** Try to find the specified word in every allowed direction starting from the provided coordinates, and mark its letters as found if it matches.
+ * @param Pointer_Grid The grid.
+ * @param Pointer_String_Word The word to search.
+ * @param Word_Length The word length.
  * @param Row The vertical coordinate to start searching from.
  * @param Column The horizontal coordinate to start searching from.
  * @return -1 if the word could not be found,
  * @return 0 if the word has been found.
  */
-int GridMatchWordWithPosition(char *Pointer_String_Word, int Row, int Column);
+int GridMatchWordWithPosition(TGrid *Pointer_Grid, char *Pointer_String_Word, int Word_Length, int Row, int Column);
+
+/** Get the row and column increments to apply to move one letter forward in the specified direction.
+ * @param Direction The direction.
+ * @param Pointer_Row_Step On output, contain the row increment (-1, 0 or 1).
+ * @param Pointer_Column_Step On output, contain the column increment (-1, 0 or 1).
+ */
+void GridGetDirectionSteps(TGridDirection Direction, int *Pointer_Row_Step, int *Pointer_Column_Step);
+
+/** Tell that all letters of a word are part of a found word.
+ * @param Pointer_Grid The grid.
+ * @param Row The vertical coordinate of the word first letter.
+ * @param Column The horizontal coordinate of the word first letter.
+ * @param Direction The direction the word is written to.
+ * @param Length The word length.
+ */
+void GridSetWordFound(TGrid *Pointer_Grid, int Row, int Column, TGridDirection Direction, int Length);
 
 /** Call this function when all words have been found, it will return the untouched letters in order.
- * @param Pointer_String_Hidden_Word On output, contain the hidden word string. Provide a buffer with room for CONFIGURATION_HIDDEN_WORD_MAXIMUM_STRING_SIZE bytes.
- * @return -1 if the hidden word is too long to fit in the provided buffer (in this case it is considered as invalid),
- * @return 0 if the hidden word is correct.
+ * @param Pointer_Grid The grid.
+ * @param Pointer_Pointer_String_Hidden_Word On input, point to a heap-allocated buffer (or to NULL). On output, point to the hidden word string. The buffer is reallocated when the hidden word does not fit in it, the caller must free it when it is no more needed.
+ * @param Pointer_Buffer_Size On input, contain the buffer size in bytes (0 if the buffer is NULL). On output, contain the new buffer size.
+ * @return -1 if no more heap memory is available,
+ * @return 0 on success.
  */
-int GridGetHiddenWord(char *Pointer_String_Hidden_Word);
+int GridGetHiddenWord(TGrid *Pointer_Grid, char **Pointer_Pointer_String_Hidden_Word, size_t *Pointer_Buffer_Size);
 
-/** Display the grid content on the console, this is a debug function. */
-void GridDisplay(void);
+/** Display the grid content on the console, this is a debug function.
+ * @param Pointer_Grid The grid to display.
+ */
+void GridDisplay(TGrid *Pointer_Grid);
 
 #endif
@@ -0,0 +1,97 @@
+/** @file Incremental.h
+ * Keep a puzzle solved while its grid letters and its words are edited, for puzzle authoring tools. Only the words and the grid lines affected by an edit are searched again, so edits on big grids take a fraction of a full solve.
+ * Like the solver, each word is located at its first occurrence in the cell-by-cell scan order, and the hidden word is made of the letters that are not covered by a located word.
+ * @author Adrien RICCIARDI
+ */
+#ifndef H_INCREMENTAL_H
+#define H_INCREMENTAL_H
+
+#include <Grid.h>
+#include <Word_Table.h>
+
+//-------------------------------------------------------------------------------------------------
+// Types
+//-------------------------------------------------------------------------------------------------
+/** A puzzle being edited and its solved state. */
+typedef struct
+{
+	TGrid Grid; //!< The edited grid. Its found letters are the letters covered by at least one located word.
+	TWordTable Word_Table; //!< Receive the words of the loaded file, they are copied to the words array right after loading.
+	char *Pointer_Words; //!< The words, CONFIGURATION_WORD_MAXIMUM_STRING_SIZE bytes per word, each one zero-terminated.
+	int *Pointer_Lengths; //!< Each word length.
+	long long *Pointer_Location_Keys; //!< Each word location key (see GRID_MAKE_LOCATION_KEY()), or -1 if the word can't be found in the grid.
+	int Words_Count; //!< How many words the puzzle contains.
+	int Allocated_Words_Count; //!< How many words fit in the words arrays.
+	int *Pointer_Coverage_Counts; //!< How many located words cover each cell (in the grid letters order).
+	size_t Allocated_Coverage_Counts_Count; //!< How many counts fit in the coverage counts buffer.
+	int Missing_Words_Count; //!< How many words can't be found in the grid. The puzzle is valid when no word is missing.
+	char *Pointer_String_Hidden_Word; //!< The hidden word, updated by IncrementalGetHiddenWord().
+	size_t Hidden_Word_Buffer_Size; //!< The hidden word buffer size in bytes.
+} TIncrementalPuzzle;
+
+//-------------------------------------------------------------------------------------------------
+// Functions
+//-------------------------------------------------------------------------------------------------
+/** Make a puzzle object ready to load a puzzle.
+ * @param Pointer_Puzzle The puzzle to initialize.
+ */
+void IncrementalInitialize(TIncrementalPuzzle *Pointer_Puzzle);
+
+/** Release all memory used by a puzzle object.
+ * @param Pointer_Puzzle The puzzle to free.
+ */
+void IncrementalFree(TIncrementalPuzzle *Pointer_Puzzle);
+
+/** Load a puzzle file and locate all its words. Unlike the solver, the puzzle is loaded even if some words can't be found, so it can be fixed by editing it.
+ * @param Pointer_Puzzle The puzzle object.
+ * @param Pointer_String_File_Name The puzzle file.
+ * @return -1 if the file could not be loaded,
+ * @return 0 on success.
+ */
+int IncrementalLoadFromFile(TIncrementalPuzzle *Pointer_Puzzle, char *Pointer_String_File_Name);
+
+/** Change a grid letter, then locate again only the words whose location contained the cell and the words that can now be read through the cell.
+ * @param Pointer_Puzzle The puzzle.
+ * @param Row The cell row, starting from 0.
+ * @param Column The cell column, starting from 0.
+ * @param Letter The new letter, in range A-Z or a-z.
+ * @return -1 if the coordinate or the letter is invalid,
+ * @return 0 on success.
+ */
+int IncrementalSetLetter(TIncrementalPuzzle *Pointer_Puzzle, int Row, int Column, char Letter);
+
+/** Add a word to search, then locate it.
+ * @param Pointer_Puzzle The puzzle.
+ * @param Pointer_String_Word The word, made of letters only (lowercase letters are converted to uppercase).
+ * @return -1 if the word is invalid or if no more heap memory is available,
+ * @return 0 on success.
+ */
+int IncrementalAddWord(TIncrementalPuzzle *Pointer_Puzzle, char *Pointer_String_Word);
+
+/** Remove a word from the searched words. If the word is searched several times, only one of its instances is removed. The last word takes the removed word index.
+ * @param Pointer_Puzzle The puzzle.
+ * @param Pointer_String_Word The word (lowercase letters are converted to uppercase).
+ * @return -1 if the puzzle does not contain this word,
+ * @return 0 on success.
+ */
+int IncrementalRemoveWord(TIncrementalPuzzle *Pointer_Puzzle, char *Pointer_String_Word);
+
+/** Tell where a word has been located.
+ * @param Pointer_Puzzle The puzzle.
+ * @param Word_Index The word index, from 0 to the words count minus 1.
+ * @param Pointer_Row On output, contain the row of the word first letter.
+ * @param Pointer_Column On output, contain the column of the word first letter.
+ * @param Pointer_Direction On output, contain the direction the word is written to.
+ * @return -1 if the word index is invalid or if the word can't be found in the grid,
+ * @return 0 on success.
+ */
+int IncrementalGetWordLocation(TIncrementalPuzzle *Pointer_Puzzle, int Word_Index, int *Pointer_Row, int *Pointer_Column, TGridDirection *Pointer_Direction);
+
+/** Extract the hidden word from the current state, only the cells coverage is read.
+ * @param Pointer_Puzzle The puzzle.
+ * @return NULL if no more heap memory is available,
+ * @return The hidden word, it is valid until the next call.
+ */
+char *IncrementalGetHiddenWord(TIncrementalPuzzle *Pointer_Puzzle);
+
+#endif
@@ -0,0 +1,114 @@
+/** @file Output.h
+ * Write the puzzles results in a human-readable or machine-readable format, through a single big buffer so formatting and system calls do not slow the solving down.
+ * All formats report the rows and columns starting from 1, like the text format.
+ * @author Adrien RICCIARDI
+ */
+#ifndef H_OUTPUT_H
+#define H_OUTPUT_H
+
+#include <Grid.h>
+#include <stddef.h>
+
+//-------------------------------------------------------------------------------------------------
+// Types
+//-------------------------------------------------------------------------------------------------
+/** All available output formats. */
+typedef enum
+{
+	OUTPUT_FORMAT_TEXT, //!< Sentences, as printed by the solver without any option.
+	OUTPUT_FORMAT_JSON, //!< A JSON object per puzzle and per line, containing the grid size, a "words" array and the result.
+	OUTPUT_FORMAT_TSV, //!< Tab-separated lines starting with the record type : "grid" (file, rows, columns), "word" (word, row, column, direction, length), then "result" ("solved" or "failed", hidden word).
+	OUTPUT_FORMAT_BINARY, //!< Records in the processor byte order starting with the record type byte : 'G' (32-bit rows and columns, 32-bit file name length, file name), 'W' (32-bit row and column, 8-bit direction and length, word letters) then 'R' (8-bit solved flag, 32-bit hidden word length, hidden word letters).
+	OUTPUT_FORMATS_COUNT
+} TOutputFormat;
+
+/** A buffered writer. */
+typedef struct
+{
+	int File_Descriptor; //!< Where to write the buffer content when it is full, or -1 to keep the whole output in memory.
+	char *Pointer_Buffer; //!< The output waiting to be written.
+	size_t Buffer_Size; //!< The buffer size in bytes.
+	size_t Used_Size; //!< How many bytes the buffer contains.
+	TOutputFormat Format; //!< How to format the results.
+	int Is_Quiet; //!< Set to report only the puzzles results, without the found words.
+	int Has_Failed; //!< Set when a write or an allocation has failed, the following writes are then ignored.
+	char *Pointer_String_File_Name; //!< The puzzle being reported.
+	int Rows_Count; //!< The reported puzzle grid height.
+	int Columns_Count; //!< The reported puzzle grid width.
+	long long Words_Count; //!< How many words have been reported for the current puzzle.
+} TOutput;
+
+//-------------------------------------------------------------------------------------------------
+// Variables
+//-------------------------------------------------------------------------------------------------
+/** The format names, as provided on the command line. */
+extern const char *Output_Format_Names[OUTPUT_FORMATS_COUNT];
+
+//-------------------------------------------------------------------------------------------------
+// Functions
+//-------------------------------------------------------------------------------------------------
+/** Make a writer ready to use.
+ * @param Pointer_Output The writer to initialize.
+ * @param File_Descriptor Where to write the output, or -1 to keep it in memory (see OutputDetachBuffer()).
+ * @param Format How to format the results.
+ * @param Is_Quiet Set to report only the puzzles results, without the found words.
+ * @return -1 if no more heap memory is available,
+ * @return 0 on success.
+ */
+int OutputInitialize(TOutput *Pointer_Output, int File_Descriptor, TOutputFormat Format, int Is_Quiet);
+
+/** Write the pending output, then release the writer memory.
+ * @param Pointer_Output The writer.
+ * @return -1 if some output could not be written,
+ * @return 0 on success.
+ */
+int OutputFree(TOutput *Pointer_Output);
+
+/** Write the buffer content to the writer file.
+ * @param Pointer_Output The writer.
+ * @return -1 if some output could not be written,
+ * @return 0 on success.
+ */
+int OutputFlush(TOutput *Pointer_Output);
+
+/** Append raw bytes, like the output of another writer, to the output.
+ * @param Pointer_Output The writer.
+ * @param Pointer_Buffer The bytes to write.
+ * @param Size How many bytes to write.
+ */
+void OutputWriteBytes(TOutput *Pointer_Output, const void *Pointer_Buffer, size_t Size);
+
+/** Take the whole content of a memory writer, the writer starts again from an empty buffer.
+ * @param Pointer_Output The writer, it must have been initialized without any file.
+ * @param Pointer_Size On output, contain the content size in bytes.
+ * @return NULL if some output could not be stored,
+ * @return The heap-allocated content, the caller must free it.
+ */
+char *OutputDetachBuffer(TOutput *Pointer_Output, size_t *Pointer_Size);
+
+/** Start reporting a puzzle.
+ * @param Pointer_Output The writer.
+ * @param Pointer_String_File_Name The puzzle file, it must stay valid until OutputEndPuzzle() is called.
+ * @param Rows_Count The grid height.
+ * @param Columns_Count The grid width.
+ */
+void OutputBeginPuzzle(TOutput *Pointer_Output, char *Pointer_String_File_Name, int Rows_Count, int Columns_Count);
+
+/** Report a word found in the current puzzle. Nothing is written in quiet mode.
+ * @param Pointer_Output The writer.
+ * @param Pointer_String_Word The word.
+ * @param Length The word length.
+ * @param Row The word first letter row, starting from 0.
+ * @param Column The word first letter column, starting from 0.
+ * @param Direction The direction the word is written to.
+ */
+void OutputWriteWord(TOutput *Pointer_Output, char *Pointer_String_Word, int Length, int Row, int Column, TGridDirection Direction);
+
+/** Finish reporting a puzzle.
+ * @param Pointer_Output The writer.
+ * @param Is_Solved Set if the puzzle has been successfully processed.
+ * @param Pointer_String_Hidden_Word The puzzle hidden word, or NULL if the puzzle has no hidden word to report (when sweeping a grid with a dictionary for instance).
+ */
+void OutputEndPuzzle(TOutput *Pointer_Output, int Is_Solved, char *Pointer_String_Hidden_Word);
+
+#endif
@@ -0,0 +1,24 @@
+/** @file Parallel_Scan.h
+ * Run the cell-by-cell scan on several threads, each thread searching a band of grid rows.
+ * @author Adrien RICCIARDI
+ */
+#ifndef H_PARALLEL_SCAN_H
+#define H_PARALLEL_SCAN_H
+
+#include <Grid.h>
+
+//-------------------------------------------------------------------------------------------------
+// Functions
+//-------------------------------------------------------------------------------------------------
+/** Find the first location of every word to search, using the same location order than the cell-by-cell scan.
+ * @param Pointer_Grid The grid to search words in.
+ * @param Pointer_Word_Table The words to search. The table is not modified, the words already found are searched too.
+ * @param Threads_Count How many threads to search with. The grid is split in as many row bands.
+ * @param Pointer_Location_Keys On output, contain one location key (see GRID_MAKE_LOCATION_KEY()) per word, or -1 if the word was not found. Words are numbered like in the word table.
+ * @param Pointer_Counters The counters to add the work done by all threads to, or NULL to count nothing. A word can be matched by several threads before the best location is known, so matches may exceed the words count.
+ * @return -1 if an error occurred,
+ * @return 0 on success.
+ */
+int ParallelScanFindWords(TGrid *Pointer_Grid, TWordTable *Pointer_Word_Table, int Threads_Count, long long *Pointer_Location_Keys, TGridSearchCounters *Pointer_Counters);
+
+#endif
@@ -0,0 +1,32 @@
+/** @file Planner.h
+ * Pick the cheapest search strategy for a loaded puzzle. The cost of each strategy is estimated from statistics that take a single pass over the grid and the words to compute : the grid size, the words count, the words lengths and the grid letters histogram.
+ * @author Adrien RICCIARDI
+ */
+#ifndef H_PLANNER_H
+#define H_PLANNER_H
+
+#include <Solver.h>
+
+//-------------------------------------------------------------------------------------------------
+// Types
+//-------------------------------------------------------------------------------------------------
+/** How the planner chose to search a puzzle. */
+typedef struct
+{
+	TSolverStrategy Strategy; //!< The cheapest strategy.
+	int Threads_Count; //!< How many threads the strategy should use.
+	double Estimated_Durations[SOLVER_STRATEGIES_COUNT]; //!< The estimated search duration of each strategy in seconds, with the threads count the planner would use for it. The automatic strategy entry is not used.
+} TPlannerPlan;
+
+//-------------------------------------------------------------------------------------------------
+// Functions
+//-------------------------------------------------------------------------------------------------
+/** Estimate the cost of each strategy on a puzzle and choose the cheapest one.
+ * @param Pointer_Grid The loaded grid.
+ * @param Pointer_Word_Table The words to search.
+ * @param Maximum_Threads_Count How many threads the search can use at most, the planner does not use more threads than the available processors.
+ * @param Pointer_Plan On output, contain the chosen strategy and the estimations it has been chosen from.
+ */
+void PlannerChooseStrategy(TGrid *Pointer_Grid, TWordTable *Pointer_Word_Table, int Maximum_Threads_Count, TPlannerPlan *Pointer_Plan);
+
+#endif
@@ -0,0 +1,32 @@
+/** @file Server.h
+ * Keep the solver resident and solve the puzzles received as a stream, from the standard input or from Unix domain socket connections.
+ * A request is a puzzle file content followed by an empty line. The response is sent as a single line, "solved HIDDEN_WORD" or "failed", followed by an empty line too.
+ * @author Adrien RICCIARDI
+ */
+#ifndef H_SERVER_H
+#define H_SERVER_H
+
+#include <Solver.h>
+
+//-------------------------------------------------------------------------------------------------
+// Functions
+//-------------------------------------------------------------------------------------------------
+/** Solve all puzzles read from the standard input, until the end of the stream is reached. Responses are written to the standard output, error messages are redirected to the standard error so they can't be mistaken for responses.
+ * @param Strategy How to search the words.
+ * @param Threads_Count How many threads the scan strategy can use.
+ * @param Pointer_Cache Where to retrieve and store the puzzles results, or NULL to always search the words.
+ * @return -1 if the stream could not be read,
+ * @return 0 when the end of the stream has been reached.
+ */
+int ServerServeStandardInput(TSolverStrategy Strategy, int Threads_Count, TCache *Pointer_Cache);
+
+/** Listen on a Unix domain socket and solve the puzzles of each connection, all connections being served at the same time by their own thread. This function returns only on error.
+ * @param Pointer_String_Socket_Path The socket file to create. An existing socket with the same name (left by a previous server) is removed, any other kind of existing file makes the function fail.
+ * @param Strategy How to search the words.
+ * @param Threads_Count How many threads the scan strategy can use for each puzzle.
+ * @param Pointer_Cache The results cache shared by all connections, or NULL to always search the words.
+ * @return -1 if the socket could not be created or if the path is used by a file that is not a socket.
+ */
+int ServerServeSocket(char *Pointer_String_Socket_Path, TSolverStrategy Strategy, int Threads_Count, TCache *Pointer_Cache);
+
+#endif
@@ -0,0 +1,22 @@
+/** @file Shift_And.h
+ * Search all words at once with bit-parallel matching : the words are packed in 64-bit words, a bit per letter, and each grid line is streamed through the shift-and algorithm, advancing all words of a 64-bit word with a few operations per grid letter.
+ * @author Adrien RICCIARDI
+ */
+#ifndef H_SHIFT_AND_H
+#define H_SHIFT_AND_H
+
+#include <Grid.h>
+
+//-------------------------------------------------------------------------------------------------
+// Functions
+//-------------------------------------------------------------------------------------------------
+/** Find the first location of every word to search, using the same location order than the cell-by-cell scan.
+ * @param Pointer_Grid The grid to search words in.
+ * @param Pointer_Word_Table The words to search, they must not be longer than 64 letters. The table is not modified, the words already found are searched too.
+ * @param Pointer_Location_Keys On output, contain one location key (see GRID_MAKE_LOCATION_KEY()) per word, or -1 if the word was not found. Words are numbered like in the word table.
+ * @return -1 if no more heap memory is available,
+ * @return 0 on success.
+ */
+int ShiftAndFindWords(TGrid *Pointer_Grid, TWordTable *Pointer_Word_Table, long long *Pointer_Location_Keys);
+
+#endif
@@ -0,0 +1,122 @@
+/** @file Solver.h
+ * Find all words of a puzzle and its hidden word, using one of the available search strategies.
+ * @author Adrien RICCIARDI
+ */
+#ifndef H_SOLVER_H
+#define H_SOLVER_H
+
+#include <Cache.h>
+#include <Grid.h>
+#include <Word_Table.h>
+
+//-------------------------------------------------------------------------------------------------
+// Types
+//-------------------------------------------------------------------------------------------------
+/** All available ways to search the words. */
+typedef enum
+{
+	SOLVER_STRATEGY_SCAN, //!< Try all words starting with a cell letter on each grid cell.
+	SOLVER_STRATEGY_AHO_CORASICK, //!< Stream all grid lines through an automaton recognizing all words at once.
+	SOLVER_STRATEGY_TRIE, //!< Walk the grid and a prefix tree of the words together from each cell and direction.
+	SOLVER_STRATEGY_RABIN_KARP, //!< Slide a rolling hash of each word length along all grid lines.
+	SOLVER_STRATEGY_LETTER_INDEX, //!< Try each word only around the positions of its rarest letter in the grid.
+	SOLVER_STRATEGY_SHIFT_AND, //!< Stream all grid lines through bit-parallel matchers of all words packed in 64-bit masks.
+	SOLVER_STRATEGY_AUTO, //!< Let the planner estimate the cost of each strategy on the puzzle and use the cheapest one (see Planner.h).
+	SOLVER_STRATEGIES_COUNT
+} TSolverStrategy;
+
+/** What solving the last puzzle cost. */
+typedef struct
+{
+	double Loading_Duration; //!< How many seconds loading the puzzle file took.
+	double Solving_Duration; //!< How many seconds finding all words took.
+	double Hidden_Word_Duration; //!< How many seconds extracting the hidden word took.
+	TSolverStrategy Strategy; //!< The strategy the words have been searched with, this is the planner choice when the automatic strategy is selected.
+	TGridSearchCounters Counters; //!< The search work. Only the scan strategy tries cells and directions, the other strategies only count the matches.
+	int Is_Cache_Hit; //!< Set if the results have been read from the cache, the strategy is then the requested one and only the matches are counted.
+} TSolverStatistics;
+
+/** Everything needed to solve a puzzle, and its results. The same object can solve many puzzles in a row, its memory is then reused. The solver has no global state, so several threads can solve puzzles at the same time as long as each one uses its own object. */
+typedef struct
+{
+	TGrid Grid; //!< The puzzle grid.
+	TWordTable Word_Table; //!< The words to find.
+	int Words_Count; //!< How many words the puzzle contains.
+	long long *Pointer_Location_Keys; //!< The location key (see GRID_MAKE_LOCATION_KEY()) of each word of the table, or -1 if the word has not been found.
+	int Allocated_Location_Keys_Count; //!< How many location keys fit in the location keys buffer.
+	char *Pointer_String_Hidden_Word; //!< The hidden word of the last solved puzzle.
+	size_t Hidden_Word_Buffer_Size; //!< The hidden word buffer size in bytes.
+	int Is_Verbose; //!< Set to print the solving steps and each found word, clear to print nothing but the errors.
+	int Is_Statistics_Enabled; //!< Set to measure each solving phase and to count the search work in the statistics field. It is cleared when the puzzle object is initialized.
+	TSolverStatistics Statistics; //!< The last solved puzzle statistics, reset each time a puzzle is loaded. It is filled only when statistics are enabled.
+	TCache *Pointer_Cache; //!< Where to retrieve the results of the puzzles already solved and to store the new ones, or NULL to always search the words. It is cleared when the puzzle object is initialized.
+} TSolverPuzzle;
+
+//-------------------------------------------------------------------------------------------------
+// Variables
+//-------------------------------------------------------------------------------------------------
+/** The strategy names, as provided on the command line. */
+extern const char *Solver_Strategy_Names[SOLVER_STRATEGIES_COUNT];
+
+//-------------------------------------------------------------------------------------------------
+// Functions
+//-------------------------------------------------------------------------------------------------
+/** Get a monotonic time to measure durations with.
+ * @return The time in seconds.
+ */
+double SolverGetTime(void);
+
+/** Make a puzzle object ready to solve puzzles.
+ * @param Pointer_Puzzle The puzzle to initialize.
+ * @param Is_Verbose Set to print the solving steps and each found word, clear to print nothing but the errors.
+ */
+void SolverPuzzleInitialize(TSolverPuzzle *Pointer_Puzzle, int Is_Verbose);
+
+/** Release all memory used by a puzzle object.
+ * @param Pointer_Puzzle The puzzle to free.
+ */
+void SolverPuzzleFree(TSolverPuzzle *Pointer_Puzzle);
+
+/** Solve the grid in the smoothest way and print the hidden word.
+ * @param Pointer_Puzzle The puzzle to solve.
+ * @param Strategy How to search the words.
+ * @param Threads_Count How many threads the scan strategy can use.
+ * @param Remaining_Words_Count The amount of words to find.
+ * @return -1 if the grid logic is invalid,
+ * @return 0 on success.
+ */
+int SolverSolveGrid(TSolverPuzzle *Pointer_Puzzle, TSolverStrategy Strategy, int Threads_Count, int Remaining_Words_Count);
+
+/** Load a puzzle file, find all its words and its hidden word.
+ * @param Pointer_Puzzle The puzzle object to solve the file with. On success, its hidden word field contains the hidden word.
+ * @param Pointer_String_File_Name The puzzle file.
+ * @param Strategy How to search the words.
+ * @param Threads_Count How many threads the scan strategy can use.
+ * @return -1 if the puzzle could not be solved,
+ * @return 0 on success.
+ */
+int SolverSolvePuzzle(TSolverPuzzle *Pointer_Puzzle, char *Pointer_String_File_Name, TSolverStrategy Strategy, int Threads_Count);
+
+/** Find all words and the hidden word of a puzzle already in memory, without touching the file system.
+ * @param Pointer_Puzzle The puzzle object to solve the content with. On success, its hidden word field contains the hidden word.
+ * @param Pointer_Content The puzzle file content. It is parsed in place (see GridLoadFromMemory()), so the byte following the content must be writable.
+ * @param Size The puzzle content size in bytes.
+ * @param Strategy How to search the words.
+ * @param Threads_Count How many threads the scan strategy can use.
+ * @return -1 if the puzzle could not be solved,
+ * @return 0 on success.
+ */
+int SolverSolvePuzzleFromMemory(TSolverPuzzle *Pointer_Puzzle, char *Pointer_Content, size_t Size, TSolverStrategy Strategy, int Threads_Count);
+
+/** Tell where a word of the last solved puzzle has been found.
+ * @param Pointer_Puzzle The solved puzzle.
+ * @param Word_Index The word index in the puzzle word table (see WORD_TABLE_GET_WORD() to retrieve the word).
+ * @param Pointer_Row On output, contain the row of the word first letter.
+ * @param Pointer_Column On output, contain the column of the word first letter.
+ * @param Pointer_Direction On output, contain the direction the word is written to.
+ * @return -1 if the word index is invalid or if the word has not been found,
+ * @return 0 on success.
+ */
+int SolverGetWordLocation(TSolverPuzzle *Pointer_Puzzle, int Word_Index, int *Pointer_Row, int *Pointer_Column, TGridDirection *Pointer_Direction);
+
+#endif
@@ -0,0 +1,22 @@
+/** @file Stream.h
+ * Solve puzzles whose grid does not fit in memory. The grid is read in horizontal bands of rows, each band sharing with the next one as many rows as the longest word length minus one, so every word occurrence is fully contained in at least one band. The next band is read while the current one is searched.
+ * The memory use only depends on the band size and on the grid width. Once all words are located, the hidden word is written while the grid is read again, so it is never stored either.
+ * Words are reported at the same locations and in the same order than when the whole grid is loaded.
+ * @author Adrien RICCIARDI
+ */
+#ifndef H_STREAM_H
+#define H_STREAM_H
+
+//-------------------------------------------------------------------------------------------------
+// Functions
+//-------------------------------------------------------------------------------------------------
+/** Solve a puzzle file band by band and print its results.
+ * @param Pointer_String_File_Name The puzzle file, it must be a regular file because it is read several times.
+ * @param Band_Rows_Count How many new grid rows each band contains.
+ * @param Is_Verbose Set to print the solving steps and each found word, clear to print only the hidden word.
+ * @return -1 if the puzzle could not be solved. If the file can't be read again while the hidden word is written, the letters already written are followed by a closing quote without the final period, and the error message is written on the next line,
+ * @return 0 on success.
+ */
+int StreamSolvePuzzle(char *Pointer_String_File_Name, int Band_Rows_Count, int Is_Verbose);
+
+#endif
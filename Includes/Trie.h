@@ -0,0 +1,22 @@
+/** @file Trie.h
+ * Search all words by walking the grid and a prefix tree of the words together, so words sharing a prefix share the letter comparisons.
+ * @author Adrien RICCIARDI
+ */
+#ifndef H_TRIE_H
+#define H_TRIE_H
+
+#include <Grid.h>
+
+//-------------------------------------------------------------------------------------------------
+// Functions
+//-------------------------------------------------------------------------------------------------
+/** Find the first location of every word to search, using the same location order than the cell-by-cell scan.
+ * @param Pointer_Grid The grid to search words in.
+ * @param Pointer_Word_Table The words to search. The table is not modified, the words already found are searched too.
+ * @param Pointer_Location_Keys On output, contain one location key (see GRID_MAKE_LOCATION_KEY()) per word, or -1 if the word was not found. Words are numbered like in the word table.
+ * @return -1 if no more heap memory is available,
+ * @return 0 on success.
+ */
+int TrieFindWords(TGrid *Pointer_Grid, TWordTable *Pointer_Word_Table, long long *Pointer_Location_Keys);
+
+#endif
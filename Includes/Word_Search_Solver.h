@@ -0,0 +1,32 @@
+/** @file Word_Search_Solver.h
+ * Public interface of the word search solver library (libword-search-solver.a), to solve puzzles from another program.
+ * A TSolverPuzzle object owns a puzzle grid, its words and the results. The library has no global state, so each thread can solve its own puzzles with its own object :
+ * @code
+ * TSolverPuzzle Puzzle;
+ * int i, Row, Column;
+ * TGridDirection Direction;
+ *
+ * SolverPuzzleInitialize(&Puzzle, 0);
+ * if (SolverSolvePuzzle(&Puzzle, "Puzzle.txt", SOLVER_STRATEGY_AHO_CORASICK, 1) == 0)
+ * {
+ *     for (i = 0; i < Puzzle.Word_Table.Words_Count; i++)
+ *     {
+ *         SolverGetWordLocation(&Puzzle, i, &Row, &Column, &Direction);
+ *         printf("%s : row %d, column %d.\n", WORD_TABLE_GET_WORD(&Puzzle.Word_Table, i), Row, Column);
+ *     }
+ *     printf("Hidden word : %s.\n", Puzzle.Pointer_String_Hidden_Word);
+ * }
+ * SolverPuzzleFree(&Puzzle);
+ * @endcode
+ * Puzzles already in memory are solved with SolverSolvePuzzleFromMemory(). SOLVER_STRATEGY_AUTO lets the solver pick the cheapest strategy for each puzzle (see Planner.h).
+ * Puzzle authoring tools can keep a puzzle solved while they edit it with a TIncrementalPuzzle object (see Incremental.h).
+ * Set the Is_Statistics_Enabled field after initializing the object to get the phases durations and the search work of each solved puzzle in its Statistics field.
+ * @author Adrien RICCIARDI
+ */
+#ifndef H_WORD_SEARCH_SOLVER_H
+#define H_WORD_SEARCH_SOLVER_H
+
+#include <Incremental.h>
+#include <Solver.h>
+
+#endif
@@ -0,0 +1,87 @@
+/** @file Word_Table.h
+ * All words of a puzzle, stored as contiguous arrays grouped by first letter. The table memory is a single arena that is kept between puzzles, so a long-running process stops allocating memory once its biggest puzzle has been loaded.
+ * @author Adrien RICCIARDI
+ */
+#ifndef H_WORD_TABLE_H
+#define H_WORD_TABLE_H
+
+#include <Configuration.h>
+#include <stddef.h>
+
+//-------------------------------------------------------------------------------------------------
+// Types
+//-------------------------------------------------------------------------------------------------
+/** The table object. Words are numbered by first letter, then by reverse order of appending inside a letter bucket. */
+typedef struct
+{
+	char *Pointer_Text; //!< The text the words are stored in (the loaded puzzle file content), words are not copied.
+	size_t *Pointer_Offsets; //!< Each word zero-terminated string offset in the text.
+	unsigned char *Pointer_Lengths; //!< Each word length.
+	unsigned long long *Pointer_Found_Bits; //!< A bit per word, set when the word has been found.
+	size_t *Pointer_Appended_Offsets; //!< The offsets of the words in the order they have been appended, before they are sorted by first letter.
+	unsigned char *Pointer_Appended_Lengths; //!< The lengths of the words in the order they have been appended.
+	int Bucket_First_Indexes[CONFIGURATION_ALPHABET_LETTERS_COUNT + 1]; //!< The index of the first word starting with each letter. The last entry is the words count, so a bucket ends where the next one begins.
+	int Words_Count; //!< How many words the table contains.
+	int Found_Words_Count; //!< How many words have been marked as found.
+	void *Pointer_Arena; //!< The single allocation holding all arrays above.
+	int Capacity; //!< How many words fit in the arena.
+} TWordTable;
+
+//-------------------------------------------------------------------------------------------------
+// Constants
+//-------------------------------------------------------------------------------------------------
+/** Get a word zero-terminated string. */
+#define WORD_TABLE_GET_WORD(Pointer_Word_Table, Word_Index) ((Pointer_Word_Table)->Pointer_Text + (Pointer_Word_Table)->Pointer_Offsets[Word_Index])
+
+/** Get a word length. */
+#define WORD_TABLE_GET_LENGTH(Pointer_Word_Table, Word_Index) ((int) (Pointer_Word_Table)->Pointer_Lengths[Word_Index])
+
+/** Tell whether a word has been marked as found. */
+#define WORD_TABLE_IS_WORD_FOUND(Pointer_Word_Table, Word_Index) (((Pointer_Word_Table)->Pointer_Found_Bits[(Word_Index) / 64] >> ((Word_Index) % 64)) & 1)
+
+//-------------------------------------------------------------------------------------------------
+// Functions
+//-------------------------------------------------------------------------------------------------
+/** Make a table ready to use.
+ * @param Pointer_Word_Table The table to initialize.
+ */
+void WordTableInitialize(TWordTable *Pointer_Word_Table);
+
+/** Release all memory used by a table. The table can be used again afterwards.
+ * @param Pointer_Word_Table The table to free.
+ */
+void WordTableFree(TWordTable *Pointer_Word_Table);
+
+/** Remove all words from a table in constant time, the arena is kept for the next words.
+ * @param Pointer_Word_Table The table to empty.
+ * @param Pointer_Text The text the next appended words will be stored in.
+ */
+void WordTableClear(TWordTable *Pointer_Word_Table, char *Pointer_Text);
+
+/** Add a word to the table. The word can't be accessed before WordTableSortWords() has been called.
+ * @param Pointer_Word_Table The table.
+ * @param Pointer_String_Word The zero-terminated word, stored in the table text. Only its offset is kept.
+ * @param Length The word length.
+ * @return -2 if the provided word string is too long,
+ * @return -1 if no more heap memory is available,
+ * @return 0 on success.
+ */
+int WordTableAppend(TWordTable *Pointer_Word_Table, char *Pointer_String_Word, int Length);
+
+/** Group the appended words by first letter and mark them all as not found.
+ * @param Pointer_Word_Table The table.
+ */
+void WordTableSortWords(TWordTable *Pointer_Word_Table);
+
+/** Mark a word as found.
+ * @param Pointer_Word_Table The table.
+ * @param Word_Index The word to mark.
+ */
+void WordTableSetWordFound(TWordTable *Pointer_Word_Table, int Word_Index);
+
+/** Print a table content on the console, this is a debug function.
+ * @param Pointer_Word_Table The table to print.
+ */
+void WordTableDisplay(TWordTable *Pointer_Word_Table);
+
+#endif
@@ -0,0 +1,235 @@
+/** @file Aho_Corasick.c
+ * See Aho_Corasick.h for description.
+ * @author Adrien RICCIARDI
+ */
+#include <Aho_Corasick.h>
+#include <stdlib.h>
+#include <string.h>
+
+//-------------------------------------------------------------------------------------------------
+// Private types
+//-------------------------------------------------------------------------------------------------
+/** What AhoCorasickKeepFirstLocation() needs to keep the first location of each word. */
+typedef struct
+{
+	long long *Pointer_Location_Keys; //!< The first location of each word found so far, or -1.
+	int Columns_Count; //!< The grid width.
+} TAhoCorasickFirstLocations;
+
+//-------------------------------------------------------------------------------------------------
+// Private functions
+//-------------------------------------------------------------------------------------------------
+/** Append a new state without any transition to the automaton trie.
+ * @param Pointer_Automaton The automaton to add a state to.
+ * @return -1 if no more heap memory is available,
+ * @return The new state index on success.
+ */
+static int AhoCorasickAddState(TAhoCorasickAutomaton *Pointer_Automaton)
+{
+	int State, *Pointer_Transitions, *Pointer_First_Words, Allocated_States_Count;
+
+	// Grow the state arrays when they are full
+	if (Pointer_Automaton->States_Count >= Pointer_Automaton->Allocated_States_Count)
+	{
+		Allocated_States_Count = Pointer_Automaton->Allocated_States_Count * 2;
+		Pointer_Transitions = realloc(Pointer_Automaton->Pointer_Transitions, (size_t) Allocated_States_Count * CONFIGURATION_ALPHABET_LETTERS_COUNT * sizeof(int));
+		if (Pointer_Transitions == NULL) return -1;
+		Pointer_Automaton->Pointer_Transitions = Pointer_Transitions;
+		Pointer_First_Words = realloc(Pointer_Automaton->Pointer_First_Words, Allocated_States_Count * sizeof(int));
+		if (Pointer_First_Words == NULL) return -1;
+		Pointer_Automaton->Pointer_First_Words = Pointer_First_Words;
+		Pointer_Automaton->Allocated_States_Count = Allocated_States_Count;
+	}
+
+	// Initialize the state
+	State = Pointer_Automaton->States_Count;
+	memset(&Pointer_Automaton->Pointer_Transitions[State * CONFIGURATION_ALPHABET_LETTERS_COUNT], -1, CONFIGURATION_ALPHABET_LETTERS_COUNT * sizeof(int));
+	Pointer_Automaton->Pointer_First_Words[State] = -1;
+	Pointer_Automaton->States_Count++;
+
+	return State;
+}
+
+/** Keep the location of a word occurrence if the cell-by-cell scan would have found it before the already known locations.
+ * @param Pointer_Parameters The TAhoCorasickFirstLocations to update.
+ * @param Word_Index The found word.
+ * @param Row The word first letter row.
+ * @param Column The word first letter column.
+ * @param Direction The direction the word is written to.
+ */
+static void AhoCorasickKeepFirstLocation(void *Pointer_Parameters, int Word_Index, int Row, int Column, TGridDirection Direction)
+{
+	TAhoCorasickFirstLocations *Pointer_First_Locations = Pointer_Parameters;
+	long long Key;
+
+	Key = GRID_MAKE_LOCATION_KEY(Row, Column, Pointer_First_Locations->Columns_Count, Direction);
+	if ((Pointer_First_Locations->Pointer_Location_Keys[Word_Index] < 0) || (Key < Pointer_First_Locations->Pointer_Location_Keys[Word_Index])) Pointer_First_Locations->Pointer_Location_Keys[Word_Index] = Key;
+}
+
+//-------------------------------------------------------------------------------------------------
+// Public functions
+//-------------------------------------------------------------------------------------------------
+int AhoCorasickBuild(TAhoCorasickAutomaton *Pointer_Automaton, TWordTable *Pointer_Word_Table)
+{
+	int i, Word_Index, Words_Count = Pointer_Word_Table->Words_Count, State, Next_State, Letter, *Pointer_Queue, Queue_Head = 0, Queue_Tail = 0, *Pointer_Transitions;
+	char *Pointer_String_Word;
+
+	// Start with room for a few states, the trie will grow as needed
+	memset(Pointer_Automaton, 0, sizeof(TAhoCorasickAutomaton));
+	Pointer_Automaton->Allocated_States_Count = 64;
+	Pointer_Automaton->Pointer_Transitions = malloc(Pointer_Automaton->Allocated_States_Count * CONFIGURATION_ALPHABET_LETTERS_COUNT * sizeof(int));
+	Pointer_Automaton->Pointer_First_Words = malloc(Pointer_Automaton->Allocated_States_Count * sizeof(int));
+	Pointer_Automaton->Pointer_Next_Words = malloc((Words_Count + 1) * sizeof(int)); // Make sure to never allocate 0 bytes
+	Pointer_Automaton->Pointer_Word_Lengths = malloc((Words_Count + 1) * sizeof(int));
+	if ((Pointer_Automaton->Pointer_Transitions == NULL) || (Pointer_Automaton->Pointer_First_Words == NULL) || (Pointer_Automaton->Pointer_Next_Words == NULL) || (Pointer_Automaton->Pointer_Word_Lengths == NULL)) return -1;
+	if (AhoCorasickAddState(Pointer_Automaton) < 0) return -1; // Create the root state
+
+	// Insert all words into the trie
+	for (Word_Index = 0; Word_Index < Words_Count; Word_Index++)
+	{
+		// Follow the existing prefix, then create the missing states
+		State = 0;
+		Pointer_String_Word = WORD_TABLE_GET_WORD(Pointer_Word_Table, Word_Index);
+		while (*Pointer_String_Word != 0)
+		{
+			Letter = *Pointer_String_Word - 'A';
+			Next_State = Pointer_Automaton->Pointer_Transitions[State * CONFIGURATION_ALPHABET_LETTERS_COUNT + Letter];
+			if (Next_State < 0)
+			{
+				Next_State = AhoCorasickAddState(Pointer_Automaton);
+				if (Next_State < 0) return -1;
+				Pointer_Automaton->Pointer_Transitions[State * CONFIGURATION_ALPHABET_LETTERS_COUNT + Letter] = Next_State;
+			}
+			State = Next_State;
+			Pointer_String_Word++;
+		}
+
+		// Attach the word to its final state
+		Pointer_Automaton->Pointer_Word_Lengths[Word_Index] = WORD_TABLE_GET_LENGTH(Pointer_Word_Table, Word_Index);
+		Pointer_Automaton->Pointer_Next_Words[Word_Index] = Pointer_Automaton->Pointer_First_Words[State];
+		Pointer_Automaton->Pointer_First_Words[State] = Word_Index;
+	}
+
+	// Allocate the remaining per-state arrays now that the states count is known
+	Pointer_Automaton->Pointer_Failure_States = malloc(Pointer_Automaton->States_Count * sizeof(int));
+	Pointer_Automaton->Pointer_Dictionary_States = malloc(Pointer_Automaton->States_Count * sizeof(int));
+	Pointer_Queue = malloc(Pointer_Automaton->States_Count * sizeof(int));
+	if ((Pointer_Automaton->Pointer_Failure_States == NULL) || (Pointer_Automaton->Pointer_Dictionary_States == NULL) || (Pointer_Queue == NULL))
+	{
+		free(Pointer_Queue);
+		return -1;
+	}
+
+	// Compute failure links in breadth-first order, so a state failure link is always known before its children ones, and turn the trie into a complete automaton
+	Pointer_Transitions = Pointer_Automaton->Pointer_Transitions;
+	Pointer_Automaton->Pointer_Failure_States[0] = 0;
+	Pointer_Automaton->Pointer_Dictionary_States[0] = -1;
+	Pointer_Queue[Queue_Tail] = 0;
+	Queue_Tail++;
+	while (Queue_Head < Queue_Tail)
+	{
+		State = Pointer_Queue[Queue_Head];
+		Queue_Head++;
+
+		for (Letter = 0; Letter < CONFIGURATION_ALPHABET_LETTERS_COUNT; Letter++)
+		{
+			Next_State = Pointer_Transitions[State * CONFIGURATION_ALPHABET_LETTERS_COUNT + Letter];
+
+			// Missing transitions go where the failure state would go
+			if (Next_State < 0)
+			{
+				if (State == 0) Pointer_Transitions[Letter] = 0;
+				else Pointer_Transitions[State * CONFIGURATION_ALPHABET_LETTERS_COUNT + Letter] = Pointer_Transitions[Pointer_Automaton->Pointer_Failure_States[State] * CONFIGURATION_ALPHABET_LETTERS_COUNT + Letter];
+				continue;
+			}
+
+			// The child failure state is the parent failure state followed by the same letter
+			if (State == 0) i = 0; // Recycle 'i' variable to store the failure state
+			else i = Pointer_Transitions[Pointer_Automaton->Pointer_Failure_States[State] * CONFIGURATION_ALPHABET_LETTERS_COUNT + Letter];
+			Pointer_Automaton->Pointer_Failure_States[Next_State] = i;
+			if (Pointer_Automaton->Pointer_First_Words[i] >= 0) Pointer_Automaton->Pointer_Dictionary_States[Next_State] = i;
+			else Pointer_Automaton->Pointer_Dictionary_States[Next_State] = Pointer_Automaton->Pointer_Dictionary_States[i];
+
+			Pointer_Queue[Queue_Tail] = Next_State;
+			Queue_Tail++;
+		}
+	}
+
+	free(Pointer_Queue);
+	return 0;
+}
+
+void AhoCorasickFree(TAhoCorasickAutomaton *Pointer_Automaton)
+{
+	free(Pointer_Automaton->Pointer_Transitions);
+	free(Pointer_Automaton->Pointer_Failure_States);
+	free(Pointer_Automaton->Pointer_Dictionary_States);
+	free(Pointer_Automaton->Pointer_First_Words);
+	free(Pointer_Automaton->Pointer_Next_Words);
+	free(Pointer_Automaton->Pointer_Word_Lengths);
+}
+
+void AhoCorasickFindAllOccurrences(TAhoCorasickAutomaton *Pointer_Automaton, TGrid *Pointer_Grid, TAhoCorasickOccurrenceCallback Callback, void *Pointer_Callback_Parameters)
+{
+	int i, Rows_Count = Pointer_Grid->Rows_Count, Columns_Count = Pointer_Grid->Columns_Count, Direction, Row_Step, Column_Step, Row, Column, Letters_Count, Letters_Step, State, Output_State, Word_Index, Position;
+	char *Pointer_Letters;
+
+	// Stream each grid line through the automaton, once per direction
+	for (Direction = 0; Direction < GRID_DIRECTIONS_COUNT; Direction++)
+	{
+		GridGetDirectionSteps(Direction, &Row_Step, &Column_Step);
+
+		for (Row = 0; Row < Rows_Count; Row++)
+		{
+			for (Column = 0; Column < Columns_Count; Column++)
+			{
+				// A line starts on the cells whose predecessor in this direction is outside of the grid
+				if ((Row - Row_Step >= 0) && (Row - Row_Step < Rows_Count) && (Column - Column_Step >= 0) && (Column - Column_Step < Columns_Count)) continue;
+
+				// Walk the line until the grid border, its letters are contiguous in the direction strip (stored in reverse for the backward directions)
+				Pointer_Letters = GridGetDirectionLetters(Pointer_Grid, Direction, Row, Column, &Letters_Count, &Letters_Step);
+				State = 0;
+				for (i = 0; i < Letters_Count; i++)
+				{
+					State = Pointer_Automaton->Pointer_Transitions[State * CONFIGURATION_ALPHABET_LETTERS_COUNT + Pointer_Letters[i * Letters_Step] - 'A'];
+
+					// Report all words ending on this letter
+					if (Pointer_Automaton->Pointer_First_Words[State] >= 0) Output_State = State;
+					else Output_State = Pointer_Automaton->Pointer_Dictionary_States[State];
+					while (Output_State >= 0)
+					{
+						Word_Index = Pointer_Automaton->Pointer_First_Words[Output_State];
+						Position = i - (Pointer_Automaton->Pointer_Word_Lengths[Word_Index] - 1); // All words ending on a state have the same length
+						while (Word_Index >= 0)
+						{
+							Callback(Pointer_Callback_Parameters, Word_Index, Row + Position * Row_Step, Column + Position * Column_Step, Direction);
+							Word_Index = Pointer_Automaton->Pointer_Next_Words[Word_Index];
+						}
+						Output_State = Pointer_Automaton->Pointer_Dictionary_States[Output_State];
+					}
+				}
+			}
+		}
+	}
+}
+
+int AhoCorasickFindWords(TGrid *Pointer_Grid, TWordTable *Pointer_Word_Table, long long *Pointer_Location_Keys)
+{
+	TAhoCorasickAutomaton Automaton;
+	TAhoCorasickFirstLocations First_Locations;
+	int i, Return_Value = -1;
+
+	// Build the automaton from all words
+	if (AhoCorasickBuild(&Automaton, Pointer_Word_Table) != 0) goto Exit;
+	for (i = 0; i < Pointer_Word_Table->Words_Count; i++) Pointer_Location_Keys[i] = -1;
+
+	// Keep only the location the cell-by-cell scan would have found first
+	First_Locations.Pointer_Location_Keys = Pointer_Location_Keys;
+	First_Locations.Columns_Count = Pointer_Grid->Columns_Count;
+	AhoCorasickFindAllOccurrences(&Automaton, Pointer_Grid, AhoCorasickKeepFirstLocation, &First_Locations);
+	Return_Value = 0;
+
+Exit:
+	AhoCorasickFree(&Automaton);
+	return Return_Value;
+}
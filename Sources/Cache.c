@@ -0,0 +1,454 @@
+/** @file Cache.c
+ * See Cache.h for description.
+ * @author Adrien RICCIARDI
+ */
+#include <Cache.h>
+#include <dirent.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <limits.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+//-------------------------------------------------------------------------------------------------
+// Private constants
+//-------------------------------------------------------------------------------------------------
+/** Identify the cache entries files. */
+#define CACHE_ENTRY_MAGIC "WSSC"
+/** Increment this each time the entry format changes, so old entries are ignored. */
+#define CACHE_ENTRY_VERSION 1
+
+/** An entry file name is made of the two key hashes in hexadecimal. */
+#define CACHE_ENTRY_NAME_LENGTH 32
+
+/** The seeds the two key hashes start from. */
+#define CACHE_FIRST_HASH_SEED 0x243F6A8885A308D3ULL
+#define CACHE_SECOND_HASH_SEED 0x13198A2E03707344ULL
+
+/** Once the cache is full, entries are removed until it is filled at this percentage, so the directory is not listed again before a quarter of the cache has been written. */
+#define CACHE_EVICTION_TARGET_PERCENTAGE 75
+/** List the directory after this amount of stores even if the estimated size fits, to account for the entries stored by other processes. */
+#define CACHE_SIZE_REFRESH_STORES_COUNT 1024
+
+//-------------------------------------------------------------------------------------------------
+// Private types
+//-------------------------------------------------------------------------------------------------
+/** The beginning of an entry file. It is followed by the location key of each word, then by the hidden word letters (without terminating zero). */
+typedef struct
+{
+	char Magic[4]; //!< Always CACHE_ENTRY_MAGIC.
+	int Version; //!< Always CACHE_ENTRY_VERSION.
+	unsigned long long Hashes[2]; //!< The key of the puzzle.
+	int Rows_Count; //!< The grid height.
+	int Columns_Count; //!< The grid width.
+	int Words_Count; //!< How many location keys follow the header.
+	int Location_Key_Size; //!< 4 if the location keys of the grid fit in 32 bits, 8 otherwise.
+	long long Hidden_Word_Length; //!< How many letters the hidden word contains.
+} TCacheEntryHeader;
+
+/** An entry found when looking for the least recently used ones. */
+typedef struct
+{
+	char String_Name[CACHE_ENTRY_NAME_LENGTH + 1]; //!< The entry file name.
+	long long Access_Time; //!< When the entry has been used for the last time, in nanoseconds.
+	long long Size; //!< The entry file size in bytes.
+} TCacheEntryFile;
+
+//-------------------------------------------------------------------------------------------------
+// Private functions
+//-------------------------------------------------------------------------------------------------
+/** Mix 8 bytes of the puzzle into both key hashes.
+ * @param Pointer_Key The key being computed.
+ * @param Value The bytes to mix.
+ */
+static inline void CacheMixValue(TCacheKey *Pointer_Key, unsigned long long Value)
+{
+	Pointer_Key->Hashes[0] = (Pointer_Key->Hashes[0] ^ Value) * 0x9E3779B97F4A7C15ULL;
+	Pointer_Key->Hashes[0] ^= Pointer_Key->Hashes[0] >> 32;
+	Pointer_Key->Hashes[1] = (Pointer_Key->Hashes[1] ^ Value) * 0xC2B2AE3D27D4EB4FULL;
+	Pointer_Key->Hashes[1] ^= Pointer_Key->Hashes[1] >> 29;
+}
+
+/** Mix some bytes of the puzzle into both key hashes, 8 bytes at a time.
+ * @param Pointer_Key The key being computed.
+ * @param Pointer_Bytes The bytes to mix.
+ * @param Size How many bytes to mix.
+ */
+static void CacheMixBytes(TCacheKey *Pointer_Key, const char *Pointer_Bytes, size_t Size)
+{
+	unsigned long long Value;
+
+	while (Size >= sizeof(Value))
+	{
+		memcpy(&Value, Pointer_Bytes, sizeof(Value));
+		CacheMixValue(Pointer_Key, Value);
+		Pointer_Bytes += sizeof(Value);
+		Size -= sizeof(Value);
+	}
+
+	// Pad the last bytes with zeros
+	if (Size > 0)
+	{
+		Value = 0;
+		memcpy(&Value, Pointer_Bytes, Size);
+		CacheMixValue(Pointer_Key, Value);
+	}
+}
+
+/** Spread the bits of a hash, so the entries names are evenly distributed.
+ * @param Hash The hash to finalize.
+ * @return The finalized hash.
+ */
+static inline unsigned long long CacheFinalizeHash(unsigned long long Hash)
+{
+	Hash ^= Hash >> 33;
+	Hash *= 0xFF51AFD7ED558CCDULL;
+	Hash ^= Hash >> 33;
+	Hash *= 0xC4CEB9FE1A85EC53ULL;
+	Hash ^= Hash >> 33;
+	return Hash;
+}
+
+/** Build the path of a cache file.
+ * @param Pointer_Cache The cache.
+ * @param Pointer_String_Name The file name.
+ * @param Pointer_String_Path On output, contain the file path. The buffer must be PATH_MAX bytes large.
+ */
+static void CacheGetPath(TCache *Pointer_Cache, const char *Pointer_String_Name, char *Pointer_String_Path)
+{
+	snprintf(Pointer_String_Path, PATH_MAX, "%s/%s", Pointer_Cache->Pointer_String_Directory_Name, Pointer_String_Name);
+}
+
+/** Build the path of the entry file of a puzzle.
+ * @param Pointer_Cache The cache.
+ * @param Pointer_Key The puzzle key.
+ * @param Pointer_String_Path On output, contain the entry file path. The buffer must be PATH_MAX bytes large.
+ */
+static void CacheGetEntryPath(TCache *Pointer_Cache, TCacheKey *Pointer_Key, char *Pointer_String_Path)
+{
+	snprintf(Pointer_String_Path, PATH_MAX, "%s/%016llx%016llx", Pointer_Cache->Pointer_String_Directory_Name, Pointer_Key->Hashes[0], Pointer_Key->Hashes[1]);
+}
+
+/** Read bytes from a file, retrying until all bytes have been read.
+ * @param File_Descriptor The file.
+ * @param Pointer_Buffer On output, contain the read bytes.
+ * @param Size How many bytes to read.
+ * @return -1 if the file could not be read or if it is too short,
+ * @return 0 on success.
+ */
+static int CacheRead(int File_Descriptor, void *Pointer_Buffer, size_t Size)
+{
+	char *Pointer_Bytes = Pointer_Buffer;
+	ssize_t Read_Bytes_Count;
+
+	while (Size > 0)
+	{
+		Read_Bytes_Count = read(File_Descriptor, Pointer_Bytes, Size);
+		if (Read_Bytes_Count < 0)
+		{
+			if (errno == EINTR) continue;
+			return -1;
+		}
+		if (Read_Bytes_Count == 0) return -1;
+
+		Pointer_Bytes += Read_Bytes_Count;
+		Size -= (size_t) Read_Bytes_Count;
+	}
+	return 0;
+}
+
+/** Write bytes to a file, retrying until all bytes have been written.
+ * @param File_Descriptor The file.
+ * @param Pointer_Buffer The bytes to write.
+ * @param Size How many bytes to write.
+ * @return -1 if the file could not be written,
+ * @return 0 on success.
+ */
+static int CacheWrite(int File_Descriptor, const void *Pointer_Buffer, size_t Size)
+{
+	const char *Pointer_Bytes = Pointer_Buffer;
+	ssize_t Written_Bytes_Count;
+
+	while (Size > 0)
+	{
+		Written_Bytes_Count = write(File_Descriptor, Pointer_Bytes, Size);
+		if (Written_Bytes_Count < 0)
+		{
+			if (errno == EINTR) continue;
+			return -1;
+		}
+
+		Pointer_Bytes += Written_Bytes_Count;
+		Size -= (size_t) Written_Bytes_Count;
+	}
+	return 0;
+}
+
+/** Sort entries from the least recently used to the most recently used.
+ * @param Pointer_A The first TCacheEntryFile to compare.
+ * @param Pointer_B The second TCacheEntryFile to compare.
+ * @return A negative number if the first entry has been used before the second one, a positive number if it has been used after, 0 otherwise.
+ */
+static int CacheCompareEntriesAccessTimes(const void *Pointer_A, const void *Pointer_B)
+{
+	const TCacheEntryFile *Pointer_Entry_A = Pointer_A, *Pointer_Entry_B = Pointer_B;
+
+	if (Pointer_Entry_A->Access_Time < Pointer_Entry_B->Access_Time) return -1;
+	if (Pointer_Entry_A->Access_Time > Pointer_Entry_B->Access_Time) return 1;
+	return 0;
+}
+
+/** List the entries to measure the cache size. If it exceeds the maximum size, remove the least recently used entries until the cache is filled at CACHE_EVICTION_TARGET_PERCENTAGE. Another process may remove the same entries at the same time, this is not an error.
+ * @param Pointer_Cache The cache, its size estimate is set to the measured size. The caller must hold the cache mutex.
+ * @return -1 if the cache directory could not be read or if no more heap memory is available,
+ * @return 0 on success.
+ */
+static int CacheEvictEntries(TCache *Pointer_Cache)
+{
+	DIR *Pointer_Directory;
+	struct dirent *Pointer_Directory_Entry;
+	struct stat Status;
+	TCacheEntryFile *Pointer_Entries = NULL, *Pointer_New_Entries;
+	char String_Path[PATH_MAX];
+	int i, Entries_Count = 0, Allocated_Entries_Count = 0, Return_Value = -1;
+	long long Total_Size = 0, Target_Size;
+
+	Pointer_Directory = opendir(Pointer_Cache->Pointer_String_Directory_Name);
+	if (Pointer_Directory == NULL) return -1;
+
+	// List the entries, the temporary files being written are ignored
+	while ((Pointer_Directory_Entry = readdir(Pointer_Directory)) != NULL)
+	{
+		if ((strlen(Pointer_Directory_Entry->d_name) != CACHE_ENTRY_NAME_LENGTH) || (strspn(Pointer_Directory_Entry->d_name, "0123456789abcdef") != CACHE_ENTRY_NAME_LENGTH)) continue;
+		CacheGetPath(Pointer_Cache, Pointer_Directory_Entry->d_name, String_Path);
+		if (stat(String_Path, &Status) != 0) continue;
+
+		if (Entries_Count >= Allocated_Entries_Count)
+		{
+			Allocated_Entries_Count = Allocated_Entries_Count == 0 ? 256 : Allocated_Entries_Count * 2;
+			Pointer_New_Entries = realloc(Pointer_Entries, Allocated_Entries_Count * sizeof(TCacheEntryFile));
+			if (Pointer_New_Entries == NULL) goto Exit;
+			Pointer_Entries = Pointer_New_Entries;
+		}
+		strcpy(Pointer_Entries[Entries_Count].String_Name, Pointer_Directory_Entry->d_name);
+		Pointer_Entries[Entries_Count].Access_Time = (long long) Status.st_mtim.tv_sec * 1000000000LL + Status.st_mtim.tv_nsec;
+		Pointer_Entries[Entries_Count].Size = Status.st_size;
+		Total_Size += Status.st_size;
+		Entries_Count++;
+	}
+
+	// Remove the oldest entries first, leaving room for the next entries
+	if (Total_Size > Pointer_Cache->Maximum_Size)
+	{
+		Target_Size = Pointer_Cache->Maximum_Size / 100 * CACHE_EVICTION_TARGET_PERCENTAGE;
+		qsort(Pointer_Entries, Entries_Count, sizeof(TCacheEntryFile), CacheCompareEntriesAccessTimes);
+		for (i = 0; (i < Entries_Count) && (Total_Size > Target_Size); i++)
+		{
+			CacheGetPath(Pointer_Cache, Pointer_Entries[i].String_Name, String_Path);
+			if ((unlink(String_Path) == 0) || (errno == ENOENT)) Total_Size -= Pointer_Entries[i].Size;
+		}
+	}
+	Pointer_Cache->Estimated_Size = Total_Size;
+	Pointer_Cache->Stores_Count = 0;
+	Return_Value = 0;
+
+Exit:
+	closedir(Pointer_Directory);
+	free(Pointer_Entries);
+	return Return_Value;
+}
+
+//-------------------------------------------------------------------------------------------------
+// Public functions
+//-------------------------------------------------------------------------------------------------
+int CacheInitialize(TCache *Pointer_Cache, char *Pointer_String_Directory_Name, long long Maximum_Size)
+{
+	// Make sure all cache files paths fit
+	if (strlen(Pointer_String_Directory_Name) + CACHE_ENTRY_NAME_LENGTH + 2 > PATH_MAX)
+	{
+		printf("Error : the cache directory path \"%s\" is too long.\n", Pointer_String_Directory_Name);
+		return -1;
+	}
+	if ((mkdir(Pointer_String_Directory_Name, 0777) != 0) && (errno != EEXIST))
+	{
+		printf("Error : could not create the cache directory \"%s\" (%s).\n", Pointer_String_Directory_Name, strerror(errno));
+		return -1;
+	}
+
+	Pointer_Cache->Pointer_String_Directory_Name = strdup(Pointer_String_Directory_Name);
+	if (Pointer_Cache->Pointer_String_Directory_Name == NULL)
+	{
+		printf("Error : not enough memory to store the cache directory name.\n");
+		return -1;
+	}
+	Pointer_Cache->Maximum_Size = Maximum_Size;
+	pthread_mutex_init(&Pointer_Cache->Mutex, NULL);
+
+	// Measure the entries left by the previous runs
+	if (CacheEvictEntries(Pointer_Cache) != 0)
+	{
+		printf("Error : could not read the cache directory \"%s\".\n", Pointer_String_Directory_Name);
+		CacheFree(Pointer_Cache);
+		return -1;
+	}
+	return 0;
+}
+
+void CacheFree(TCache *Pointer_Cache)
+{
+	free(Pointer_Cache->Pointer_String_Directory_Name);
+	Pointer_Cache->Pointer_String_Directory_Name = NULL;
+	pthread_mutex_destroy(&Pointer_Cache->Mutex);
+}
+
+void CacheComputeKey(TGrid *Pointer_Grid, TWordTable *Pointer_Word_Table, TCacheKey *Pointer_Key)
+{
+	int Word_Index;
+
+	Pointer_Key->Hashes[0] = CACHE_FIRST_HASH_SEED;
+	Pointer_Key->Hashes[1] = CACHE_SECOND_HASH_SEED;
+
+	// The grid letters are already uppercase, the size tells where the rows end
+	CacheMixValue(Pointer_Key, ((unsigned long long) Pointer_Grid->Rows_Count << 32) | (unsigned int) Pointer_Grid->Columns_Count);
+	CacheMixBytes(Pointer_Key, Pointer_Grid->Pointer_Letters, (size_t) Pointer_Grid->Rows_Count * Pointer_Grid->Columns_Count);
+
+	// The words are hashed in the table order, which is also the order of the stored location keys
+	CacheMixValue(Pointer_Key, (unsigned long long) Pointer_Word_Table->Words_Count);
+	for (Word_Index = 0; Word_Index < Pointer_Word_Table->Words_Count; Word_Index++)
+	{
+		CacheMixValue(Pointer_Key, (unsigned long long) WORD_TABLE_GET_LENGTH(Pointer_Word_Table, Word_Index));
+		CacheMixBytes(Pointer_Key, WORD_TABLE_GET_WORD(Pointer_Word_Table, Word_Index), WORD_TABLE_GET_LENGTH(Pointer_Word_Table, Word_Index));
+	}
+
+	Pointer_Key->Hashes[0] = CacheFinalizeHash(Pointer_Key->Hashes[0]);
+	Pointer_Key->Hashes[1] = CacheFinalizeHash(Pointer_Key->Hashes[1]);
+}
+
+int CacheLoad(TCache *Pointer_Cache, TCacheKey *Pointer_Key, TGrid *Pointer_Grid, TWordTable *Pointer_Word_Table, long long *Pointer_Location_Keys, char **Pointer_Pointer_String_Hidden_Word, size_t *Pointer_Buffer_Size)
+{
+	TCacheEntryHeader Header;
+	char String_Path[PATH_MAX], *Pointer_String;
+	unsigned char *Pointer_Keys = NULL;
+	unsigned int Location_Key_32;
+	long long Location_Key, Keys_Count = (long long) Pointer_Grid->Rows_Count * Pointer_Grid->Columns_Count * GRID_DIRECTIONS_COUNT;
+	size_t Keys_Size;
+	int File_Descriptor, Word_Index, Is_Hit = 0;
+
+	CacheGetEntryPath(Pointer_Cache, Pointer_Key, String_Path);
+	File_Descriptor = open(String_Path, O_RDONLY);
+	if (File_Descriptor < 0) return 0;
+
+	// Hashes may collide, make sure the entry describes a puzzle of the same shape
+	if (CacheRead(File_Descriptor, &Header, sizeof(Header)) != 0) goto Exit;
+	if ((memcmp(Header.Magic, CACHE_ENTRY_MAGIC, sizeof(Header.Magic)) != 0) || (Header.Version != CACHE_ENTRY_VERSION) || (Header.Hashes[0] != Pointer_Key->Hashes[0]) || (Header.Hashes[1] != Pointer_Key->Hashes[1])) goto Exit;
+	if ((Header.Rows_Count != Pointer_Grid->Rows_Count) || (Header.Columns_Count != Pointer_Grid->Columns_Count) || (Header.Words_Count != Pointer_Word_Table->Words_Count)) goto Exit;
+	if (((Header.Location_Key_Size != 4) && (Header.Location_Key_Size != 8)) || (Header.Hidden_Word_Length < 0) || (Header.Hidden_Word_Length > (long long) Pointer_Grid->Rows_Count * Pointer_Grid->Columns_Count)) goto Exit;
+
+	// Read all locations at once
+	Keys_Size = (size_t) Header.Words_Count * Header.Location_Key_Size;
+	Pointer_Keys = malloc(Keys_Size + 1); // Make sure to never allocate 0 bytes
+	if ((Pointer_Keys == NULL) || (CacheRead(File_Descriptor, Pointer_Keys, Keys_Size) != 0)) goto Exit;
+	for (Word_Index = 0; Word_Index < Header.Words_Count; Word_Index++)
+	{
+		if (Header.Location_Key_Size == 4)
+		{
+			memcpy(&Location_Key_32, &Pointer_Keys[(size_t) Word_Index * 4], 4);
+			Location_Key = Location_Key_32;
+		}
+		else memcpy(&Location_Key, &Pointer_Keys[(size_t) Word_Index * 8], 8);
+		if ((Location_Key < 0) || (Location_Key >= Keys_Count)) goto Exit;
+		Pointer_Location_Keys[Word_Index] = Location_Key;
+	}
+
+	// Grow the hidden word buffer if needed
+	if ((size_t) Header.Hidden_Word_Length + 1 > *Pointer_Buffer_Size)
+	{
+		Pointer_String = realloc(*Pointer_Pointer_String_Hidden_Word, (size_t) Header.Hidden_Word_Length + 1);
+		if (Pointer_String == NULL) goto Exit;
+		*Pointer_Pointer_String_Hidden_Word = Pointer_String;
+		*Pointer_Buffer_Size = (size_t) Header.Hidden_Word_Length + 1;
+	}
+	if (CacheRead(File_Descriptor, *Pointer_Pointer_String_Hidden_Word, (size_t) Header.Hidden_Word_Length) != 0) goto Exit;
+	(*Pointer_Pointer_String_Hidden_Word)[Header.Hidden_Word_Length] = 0;
+
+	// Mark the entry as the most recently used one
+	futimens(File_Descriptor, NULL);
+	Is_Hit = 1;
+
+Exit:
+	close(File_Descriptor);
+	free(Pointer_Keys);
+	return Is_Hit;
+}
+
+int CacheStore(TCache *Pointer_Cache, TCacheKey *Pointer_Key, TGrid *Pointer_Grid, TWordTable *Pointer_Word_Table, long long *Pointer_Location_Keys, char *Pointer_String_Hidden_Word)
+{
+	TCacheEntryHeader Header;
+	char String_Temporary_Path[PATH_MAX], String_Path[PATH_MAX];
+	unsigned char *Pointer_Buffer;
+	unsigned int Location_Key_32;
+	size_t Size, Offset;
+	int File_Descriptor, Word_Index, Return_Value = -1;
+
+	memset(&Header, 0, sizeof(Header));
+	memcpy(Header.Magic, CACHE_ENTRY_MAGIC, sizeof(Header.Magic));
+	Header.Version = CACHE_ENTRY_VERSION;
+	Header.Hashes[0] = Pointer_Key->Hashes[0];
+	Header.Hashes[1] = Pointer_Key->Hashes[1];
+	Header.Rows_Count = Pointer_Grid->Rows_Count;
+	Header.Columns_Count = Pointer_Grid->Columns_Count;
+	Header.Words_Count = Pointer_Word_Table->Words_Count;
+	Header.Location_Key_Size = (long long) Pointer_Grid->Rows_Count * Pointer_Grid->Columns_Count * GRID_DIRECTIONS_COUNT <= 0xFFFFFFFFLL ? 4 : 8; // Most grids only need half the space
+	Header.Hidden_Word_Length = (long long) strlen(Pointer_String_Hidden_Word);
+
+	// Build the whole entry to write it at once
+	Size = sizeof(Header) + (size_t) Header.Words_Count * Header.Location_Key_Size + (size_t) Header.Hidden_Word_Length;
+	Pointer_Buffer = malloc(Size);
+	if (Pointer_Buffer == NULL) return -1;
+	memcpy(Pointer_Buffer, &Header, sizeof(Header));
+	Offset = sizeof(Header);
+	for (Word_Index = 0; Word_Index < Header.Words_Count; Word_Index++)
+	{
+		if (Header.Location_Key_Size == 4)
+		{
+			Location_Key_32 = (unsigned int) Pointer_Location_Keys[Word_Index];
+			memcpy(&Pointer_Buffer[Offset], &Location_Key_32, 4);
+		}
+		else memcpy(&Pointer_Buffer[Offset], &Pointer_Location_Keys[Word_Index], 8);
+		Offset += Header.Location_Key_Size;
+	}
+	memcpy(&Pointer_Buffer[Offset], Pointer_String_Hidden_Word, (size_t) Header.Hidden_Word_Length);
+
+	// Readers must never see a partially written entry, so the entry is renamed only once it is complete
+	CacheGetPath(Pointer_Cache, ".entry-XXXXXX", String_Temporary_Path);
+	File_Descriptor = mkstemp(String_Temporary_Path);
+	if (File_Descriptor < 0) goto Exit;
+	if (CacheWrite(File_Descriptor, Pointer_Buffer, Size) != 0)
+	{
+		close(File_Descriptor);
+		unlink(String_Temporary_Path);
+		goto Exit;
+	}
+	close(File_Descriptor);
+	CacheGetEntryPath(Pointer_Cache, Pointer_Key, String_Path);
+	if (rename(String_Temporary_Path, String_Path) != 0)
+	{
+		unlink(String_Temporary_Path);
+		goto Exit;
+	}
+
+	// List the directory only when it seems full, so storing many entries does not read the whole directory each time
+	pthread_mutex_lock(&Pointer_Cache->Mutex);
+	Pointer_Cache->Estimated_Size += (long long) Size;
+	Pointer_Cache->Stores_Count++;
+	if ((Pointer_Cache->Estimated_Size > Pointer_Cache->Maximum_Size) || (Pointer_Cache->Stores_Count >= CACHE_SIZE_REFRESH_STORES_COUNT)) Return_Value = CacheEvictEntries(Pointer_Cache);
+	else Return_Value = 0;
+	pthread_mutex_unlock(&Pointer_Cache->Mutex);
+
+Exit:
+	free(Pointer_Buffer);
+	return Return_Value;
+}
@@ -0,0 +1,40 @@
+/** @file Dictionary.c
+ * See Dictionary.h for description.
+ * @author Adrien RICCIARDI
+ */
+#include <Dictionary.h>
+#include <stdio.h>
+#include <string.h>
+
+//-------------------------------------------------------------------------------------------------
+// Public functions
+//-------------------------------------------------------------------------------------------------
+int DictionaryLoad(TDictionary *Pointer_Dictionary, char *Pointer_String_File_Name)
+{
+	GridInitialize(&Pointer_Dictionary->File_Holder);
+	WordTableInitialize(&Pointer_Dictionary->Word_Table);
+	memset(&Pointer_Dictionary->Automaton, 0, sizeof(Pointer_Dictionary->Automaton));
+	Pointer_Dictionary->Skipped_Words_Count = 0;
+
+	if (GridLoadWordsFromFile(&Pointer_Dictionary->File_Holder, Pointer_String_File_Name, &Pointer_Dictionary->Word_Table, &Pointer_Dictionary->Skipped_Words_Count) != 0) return -1;
+
+	if (AhoCorasickBuild(&Pointer_Dictionary->Automaton, &Pointer_Dictionary->Word_Table) != 0)
+	{
+		printf("Error : not enough memory to build the dictionary automaton.\n");
+		return -1;
+	}
+
+	return 0;
+}
+
+void DictionaryFree(TDictionary *Pointer_Dictionary)
+{
+	AhoCorasickFree(&Pointer_Dictionary->Automaton);
+	WordTableFree(&Pointer_Dictionary->Word_Table);
+	GridFree(&Pointer_Dictionary->File_Holder);
+}
+
+void DictionarySweepGrid(TDictionary *Pointer_Dictionary, TGrid *Pointer_Grid, TAhoCorasickOccurrenceCallback Callback, void *Pointer_Callback_Parameters)
+{
+	AhoCorasickFindAllOccurrences(&Pointer_Dictionary->Automaton, Pointer_Grid, Callback, Pointer_Callback_Parameters);
+}
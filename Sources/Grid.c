@@ -3,440 +3,990 @@
  * @author Adrien RICCIARDI
  */
 #include <errno.h>
+#include <fcntl.h>
 #include <Grid.h>
 #include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#if defined(__x86_64__) || defined(__i386__)
+	#include <immintrin.h>
+	#define GRID_IS_X86_PROCESSOR 1
+#endif
 
 //-------------------------------------------------------------------------------------------------
-// Private types
+// Private constants
 //-------------------------------------------------------------------------------------------------
-/** A grid cell, containing a letter and a flag telling whether the letter is part of a searched word. */
-typedef struct
+/** The row increment of each direction, indexed by a TGridDirection value. */
+static const int Grid_Direction_Row_Steps[GRID_DIRECTIONS_COUNT] = { -1, -1, 0, 1, 1, 1, 0, -1 };
+/** The column increment of each direction, indexed by a TGridDirection value. */
+static const int Grid_Direction_Column_Steps[GRID_DIRECTIONS_COUNT] = { 0, 1, 1, 1, 0, -1, -1, -1 };
+
+/** The comparison kernels load this amount of bytes at once, so this amount of readable bytes must follow the last strip letter and the searched word. */
+#define GRID_VECTOR_SIZE 32
+
+/** How many strips copies of the grid are stored : rows, columns, diagonals and anti-diagonals. The rows strip is the grid letters themselves. */
+#define GRID_STRIPS_COUNT 4
+
+/** Tell whether a direction reads its strip backward, these directions share the strip of the opposite direction. */
+#define GRID_IS_DIRECTION_BACKWARD(Direction) (((Direction) == GRID_DIRECTION_NORTH) || ((Direction) == GRID_DIRECTION_NORTH_EAST) || ((Direction) == GRID_DIRECTION_WEST) || ((Direction) == GRID_DIRECTION_NORTH_WEST))
+
+/** The class of a character that separates the grid rows and the words. */
+#define GRID_CHARACTER_CLASS_SEPARATOR 1
+
+/** Classify each file character : 0 for a forbidden character, GRID_CHARACTER_CLASS_SEPARATOR for a whitespace, or the uppercase version of a letter. */
+static const unsigned char Grid_Character_Classes[256] =
 {
-	char Letter;
-	int Is_Letter_Present_In_Word;
-} TGridCell;
+	0, 0, 0, 0, 0, 0, 0, 0, 0, GRID_CHARACTER_CLASS_SEPARATOR, GRID_CHARACTER_CLASS_SEPARATOR, GRID_CHARACTER_CLASS_SEPARATOR, GRID_CHARACTER_CLASS_SEPARATOR, GRID_CHARACTER_CLASS_SEPARATOR, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	GRID_CHARACTER_CLASS_SEPARATOR, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 'A', 'B', 'C', 'D', 'E', 'F', 'G', 'H', 'I', 'J', 'K', 'L', 'M', 'N', 'O',
+	'P', 'Q', 'R', 'S', 'T', 'U', 'V', 'W', 'X', 'Y', 'Z', 0, 0, 0, 0, 0,
+	0, 'A', 'B', 'C', 'D', 'E', 'F', 'G', 'H', 'I', 'J', 'K', 'L', 'M', 'N', 'O',
+	'P', 'Q', 'R', 'S', 'T', 'U', 'V', 'W', 'X', 'Y', 'Z', 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+};
 
 //-------------------------------------------------------------------------------------------------
-// Private variables
+// Public constants
 //-------------------------------------------------------------------------------------------------
-/** The grid containing the letters to search words from. */
-static TGridCell Grid_Cells[CONFIGURATION_GRID_MAXIMUM_SIZE * CONFIGURATION_GRID_MAXIMUM_SIZE];
+/** The name of each direction, indexed by a TGridDirection value. */
+const char *Grid_Direction_Names[GRID_DIRECTIONS_COUNT] =
+{
+	"north",
+	"north-east",
+	"east",
+	"south-east",
+	"south",
+	"south-west",
+	"west",
+	"north-west"
+};
 
-/** How many rows have the loaded grid. */
-static int Grid_Rows_Count = 0;
-/** How many columns have the loaded grid. */
-static int Grid_Columns_Count = 0;
+//-------------------------------------------------------------------------------------------------
+// Private types
+//-------------------------------------------------------------------------------------------------
+/** A word prepared to be compared with the strips. */
+typedef struct
+{
+	char String_Word[CONFIGURATION_WORD_MAXIMUM_STRING_SIZE + GRID_VECTOR_SIZE]; //!< The word copied to a buffer the kernels can read a whole vector past the word end from (only filled for words longer than 8 letters).
+	char String_Reversed_Word[CONFIGURATION_WORD_MAXIMUM_STRING_SIZE + GRID_VECTOR_SIZE]; //!< The word letters in reverse order, compared by the backward directions.
+	char *Pointer_String_Original_Word; //!< The word as provided by the caller.
+	unsigned long long Packed_Word; //!< The word letters copied to an integer, the unused bytes being zero (only used by words of up to 8 letters).
+	unsigned long long Packed_Reversed_Word; //!< The reversed word letters copied to an integer, like the packed word.
+	unsigned long long Packed_Mask; //!< The bytes of the packed words to compare.
+	int Length; //!< The word length.
+	int Is_Reversed_Word_Ready; //!< Set once the reversed word has been computed. It is computed only when a backward direction may match, so most candidates never pay for it.
+} TGridSearchedWord;
 
 //-------------------------------------------------------------------------------------------------
 // Private functions
 //-------------------------------------------------------------------------------------------------
-/** Make sure the provided string does contain only uppercase letters (convert lowercase ones if needed).
- * @param Pointer_String The string to check, it can be modified on output if some lowercase letters were converted to uppercase.
- * @return 0 if the string is fine,
- * @return 1 if the string contains invalid characters.
+/** Find the next whitespace-separated token of the file content, uppercase its letters in place and check that it contains only letters.
+ * @param Pointer_Pointer_Character On input, point to the first character to parse. On output, point to the character following the token.
+ * @param Pointer_End The first character following the file content.
+ * @param Pointer_Length On output, contain the token length.
+ * @param Pointer_Is_Valid On output, tell whether the token contains only letters.
+ * @return NULL if the end of the file has been reached without finding any token,
+ * @return A pointer on the token first character.
+ */
+static char *GridReadToken(char **Pointer_Pointer_Character, char *Pointer_End, size_t *Pointer_Length, int *Pointer_Is_Valid)
+{
+	char *Pointer_Character = *Pointer_Pointer_Character, *Pointer_Token;
+	unsigned char Class;
+	int Is_Valid = 1;
+
+	// Skip leading whitespaces
+	while ((Pointer_Character < Pointer_End) && (Grid_Character_Classes[(unsigned char) *Pointer_Character] == GRID_CHARACTER_CLASS_SEPARATOR)) Pointer_Character++;
+	if (Pointer_Character == Pointer_End)
+	{
+		*Pointer_Pointer_Character = Pointer_Character;
+		return NULL;
+	}
+
+	// Convert all characters until the next whitespace, only writing the lowercase ones to avoid touching the mapped pages needlessly
+	Pointer_Token = Pointer_Character;
+	while (Pointer_Character < Pointer_End)
+	{
+		Class = Grid_Character_Classes[(unsigned char) *Pointer_Character];
+		if (Class == GRID_CHARACTER_CLASS_SEPARATOR) break;
+		if (Class == 0) Is_Valid = 0;
+		else if (Class != (unsigned char) *Pointer_Character) *Pointer_Character = (char) Class;
+		Pointer_Character++;
+	}
+
+	*Pointer_Pointer_Character = Pointer_Character;
+	*Pointer_Length = (size_t) (Pointer_Character - Pointer_Token);
+	*Pointer_Is_Valid = Is_Valid;
+	return Pointer_Token;
+}
+
+/** Release the previously loaded file content, the words loaded from it can't be used anymore.
+ * @param Pointer_Grid The grid.
+ */
+static void GridUnmapFile(TGrid *Pointer_Grid)
+{
+	if (Pointer_Grid->Mapping_Size > 0) munmap(Pointer_Grid->Pointer_File_Content, Pointer_Grid->Mapping_Size);
+	Pointer_Grid->Pointer_File_Content = NULL;
+	Pointer_Grid->Mapping_Size = 0;
+}
+
+/** Make the whole file content available in memory, followed by a writable byte. The file is mapped when possible, otherwise it is read into the grid file buffer.
+ * @param Pointer_Grid The grid.
+ * @param Pointer_String_File_Name The file name, only used to display errors.
+ * @param File_Descriptor The opened file.
+ * @param Pointer_Size On output, contain the file size in bytes.
+ * @return -1 if an error occurred,
+ * @return 0 on success.
  */
-static int GridValidateString(char *Pointer_String)
+static int GridMapFile(TGrid *Pointer_Grid, char *Pointer_String_File_Name, int File_Descriptor, size_t *Pointer_Size)
 {
-	char Character;
+	struct stat Status;
+	void *Pointer_Mapping;
+	size_t Size = 0, New_Size;
+	ssize_t Read_Bytes_Count;
+	char *Pointer_Buffer;
 
-	// Only uppercase letters are allowed in the string
-	while (*Pointer_String != 0)
+	if (fstat(File_Descriptor, &Status) != 0)
 	{
-		// Cache the next character
-		Character = *Pointer_String;
+		printf("Error : could not read the file \"%s\" (%s).\n", Pointer_String_File_Name, strerror(errno));
+		return -1;
+	}
 
-		// Convert lowercase character to uppercase if needed
-		if ((Character >= 'a') && (Character <= 'z'))
+	// A private writable mapping allows to convert the letters and to terminate the words in place without modifying the file. The byte following the content is writable only if the content does not end on a page boundary
+	if (S_ISREG(Status.st_mode) && (Status.st_size > 0) && (Status.st_size % sysconf(_SC_PAGESIZE) != 0))
+	{
+		Pointer_Mapping = mmap(NULL, (size_t) Status.st_size, PROT_READ | PROT_WRITE, MAP_PRIVATE, File_Descriptor, 0);
+		if (Pointer_Mapping != MAP_FAILED)
 		{
-			Character -= 32;
-			*Pointer_String = Character;
+			Pointer_Grid->Pointer_File_Content = Pointer_Mapping;
+			Pointer_Grid->Mapping_Size = (size_t) Status.st_size;
+			*Pointer_Size = (size_t) Status.st_size;
+			return 0;
 		}
+	}
 
-		// Is this a valid character ?
-		if ((Character < 'A') || (Character > 'Z')) return 1;
-		Pointer_String++;
+	// Read the whole content otherwise (pipes for instance)
+	while (1)
+	{
+		// Keep room for the byte following the content
+		if (Size + 1 >= Pointer_Grid->File_Buffer_Size)
+		{
+			if (Pointer_Grid->File_Buffer_Size == 0) New_Size = 65536;
+			else New_Size = Pointer_Grid->File_Buffer_Size * 2;
+			Pointer_Buffer = realloc(Pointer_Grid->Pointer_File_Buffer, New_Size);
+			if (Pointer_Buffer == NULL)
+			{
+				printf("Error : not enough memory to read the file \"%s\".\n", Pointer_String_File_Name);
+				return -1;
+			}
+			Pointer_Grid->Pointer_File_Buffer = Pointer_Buffer;
+			Pointer_Grid->File_Buffer_Size = New_Size;
+		}
+
+		Read_Bytes_Count = read(File_Descriptor, &Pointer_Grid->Pointer_File_Buffer[Size], Pointer_Grid->File_Buffer_Size - 1 - Size);
+		if (Read_Bytes_Count < 0)
+		{
+			if (errno == EINTR) continue;
+			printf("Error : could not read the file \"%s\" (%s).\n", Pointer_String_File_Name, strerror(errno));
+			return -1;
+		}
+		if (Read_Bytes_Count == 0) break;
+		Size += (size_t) Read_Bytes_Count;
 	}
 
+	Pointer_Grid->Pointer_File_Content = Pointer_Grid->Pointer_File_Buffer;
+	*Pointer_Size = Size;
 	return 0;
 }
 
-/** Tell that the letter at the specified location is part of a word.
- * @param Row The vertical coordinate.
- * @param Column The horizontal coordinate.
+/** Make sure the grid letters buffer can store the provided amount of letters, growing it if needed.
+ * @param Pointer_Grid The grid.
+ * @param Letters_Count How many letters must fit.
+ * @return -1 if no more heap memory is available,
+ * @return 0 on success.
  */
-void GridSetLetterFound(int Row, int Column)
+static int GridReserveLetters(TGrid *Pointer_Grid, size_t Letters_Count)
 {
-	// Make sure provided coordinates are valid
-	if ((Row < 0) || (Row >= Grid_Rows_Count) || (Column < 0) || (Column >= Grid_Columns_Count))
+	size_t New_Count;
+	char *Pointer_Letters;
+
+	if (Letters_Count <= Pointer_Grid->Allocated_Letters_Count) return 0;
+
+	// Double the buffer size to make reading big grids row by row cheap
+	New_Count = Pointer_Grid->Allocated_Letters_Count * 2;
+	if (New_Count < Letters_Count) New_Count = Letters_Count;
+	Pointer_Letters = realloc(Pointer_Grid->Pointer_Letters, New_Count);
+	if (Pointer_Letters == NULL) return -1;
+
+	Pointer_Grid->Pointer_Letters = Pointer_Letters;
+	Pointer_Grid->Allocated_Letters_Count = New_Count;
+	return 0;
+}
+
+/** Mark all cells of the loaded grid as not being part of a found word.
+ * @param Pointer_Grid The grid.
+ * @return -1 if no more heap memory is available,
+ * @return 0 on success.
+ */
+static int GridClearFoundBits(TGrid *Pointer_Grid)
+{
+	size_t Count;
+	unsigned long long *Pointer_Found_Bits;
+
+	Count = ((size_t) Pointer_Grid->Rows_Count * Pointer_Grid->Columns_Count + 63) / 64;
+	if (Count > Pointer_Grid->Allocated_Found_Bits_Count)
 	{
-		printf("Error : the invalid coordinates %dx%d have been specified, returning 0.\n", Column, Row);
-		return;
+		Pointer_Found_Bits = realloc(Pointer_Grid->Pointer_Found_Bits, Count * sizeof(unsigned long long));
+		if (Pointer_Found_Bits == NULL) return -1;
+		Pointer_Grid->Pointer_Found_Bits = Pointer_Found_Bits;
+		Pointer_Grid->Allocated_Found_Bits_Count = Count;
+	}
+
+	if (Count > 0) memset(Pointer_Grid->Pointer_Found_Bits, 0, Count * sizeof(unsigned long long));
+	return 0;
+}
+
+/** Compare a word to the letters of a strip, one letter at a time. This kernel works on any processor.
+ * @param Pointer_Letters The strip letters.
+ * @param Pointer_String_Word The word to compare.
+ * @param Length How many letters to compare.
+ * @return 1 if all letters are equal,
+ * @return 0 if at least one letter differs.
+ */
+static int GridCompareLettersScalar(const char *Pointer_Letters, const char *Pointer_String_Word, int Length)
+{
+	int i;
+
+	for (i = 0; i < Length; i++)
+	{
+		if (Pointer_Letters[i] != Pointer_String_Word[i]) return 0;
+	}
+	return 1;
+}
+
+#ifdef GRID_IS_X86_PROCESSOR
+/** Compare a word to the letters of a strip, 16 letters at a time. GRID_VECTOR_SIZE bytes must be readable from both pointers.
+ * @param Pointer_Letters The strip letters.
+ * @param Pointer_String_Word The word to compare.
+ * @param Length How many letters to compare.
+ * @return 1 if all letters are equal,
+ * @return 0 if at least one letter differs.
+ */
+__attribute__((target("sse2"))) static int GridCompareLettersSse2(const char *Pointer_Letters, const char *Pointer_String_Word, int Length)
+{
+	unsigned int Mask;
+
+	while (Length > 0)
+	{
+		// Get a bit set for each equal letter
+		Mask = (unsigned int) _mm_movemask_epi8(_mm_cmpeq_epi8(_mm_loadu_si128((const __m128i *) Pointer_Letters), _mm_loadu_si128((const __m128i *) Pointer_String_Word)));
+		// Ignore the bytes following the word
+		if (Length < 16) Mask |= 0xFFFF << Length;
+		if ((Mask & 0xFFFF) != 0xFFFF) return 0;
+
+		Pointer_Letters += 16;
+		Pointer_String_Word += 16;
+		Length -= 16;
+	}
+	return 1;
+}
+
+/** Compare a word to the letters of a strip, 32 letters at a time. GRID_VECTOR_SIZE bytes must be readable from both pointers.
+ * @param Pointer_Letters The strip letters.
+ * @param Pointer_String_Word The word to compare.
+ * @param Length How many letters to compare.
+ * @return 1 if all letters are equal,
+ * @return 0 if at least one letter differs.
+ */
+__attribute__((target("avx2"))) static int GridCompareLettersAvx2(const char *Pointer_Letters, const char *Pointer_String_Word, int Length)
+{
+	unsigned int Mask;
+
+	while (Length > 0)
+	{
+		// Get a bit set for each equal letter
+		Mask = (unsigned int) _mm256_movemask_epi8(_mm256_cmpeq_epi8(_mm256_loadu_si256((const __m256i *) Pointer_Letters), _mm256_loadu_si256((const __m256i *) Pointer_String_Word)));
+		// Ignore the bytes following the word
+		if (Length < 32) Mask |= 0xFFFFFFFFU << Length;
+		if (Mask != 0xFFFFFFFFU) return 0;
+
+		Pointer_Letters += 32;
+		Pointer_String_Word += 32;
+		Length -= 32;
+	}
+	return 1;
+}
+#endif
+
+/** Find where the letters following a cell in a direction are stored in the strips.
+ * @param Pointer_Grid The grid, its strips must have been built.
+ * @param Direction The direction to read the letters to.
+ * @param Row The cell row.
+ * @param Column The cell column.
+ * @param Pointer_Remaining_Letters_Count On output, contain how many letters (including the cell one) can be read before reaching the grid border.
+ * @return The cell letter offset in the strips buffer. The following letters are stored after it for the forward directions, and before it for the backward ones (see GRID_IS_DIRECTION_BACKWARD()).
+ * @note The function is always inlined, so the direction switch disappears when the direction is a constant.
+ */
+static inline __attribute__((always_inline)) size_t GridGetStripOffset(TGrid *Pointer_Grid, TGridDirection Direction, int Row, int Column, int *Pointer_Remaining_Letters_Count)
+{
+	int Rows_Count = Pointer_Grid->Rows_Count, Columns_Count = Pointer_Grid->Columns_Count, Index, Position, Length;
+	size_t Offset, Cells_Count = (size_t) Rows_Count * Columns_Count;
+
+	switch (Direction)
+	{
+		// Rows, stored from west to east
+		case GRID_DIRECTION_EAST:
+			*Pointer_Remaining_Letters_Count = Columns_Count - Column;
+			return (size_t) Row * Columns_Count + Column;
+		case GRID_DIRECTION_WEST:
+			*Pointer_Remaining_Letters_Count = Column + 1;
+			return (size_t) Row * Columns_Count + Column;
+
+		// Columns, stored from north to south after the rows
+		case GRID_DIRECTION_SOUTH:
+			*Pointer_Remaining_Letters_Count = Rows_Count - Row;
+			return Cells_Count + (size_t) Column * Rows_Count + Row;
+		case GRID_DIRECTION_NORTH:
+			*Pointer_Remaining_Letters_Count = Row + 1;
+			return Cells_Count + (size_t) Column * Rows_Count + Row;
+
+		// Diagonals, stored from north west to south east after the columns
+		case GRID_DIRECTION_SOUTH_EAST:
+		case GRID_DIRECTION_NORTH_WEST:
+			Index = Column - Row + Rows_Count - 1;
+			Position = Row < Column ? Row : Column;
+			Offset = 2 * Cells_Count + Pointer_Grid->Pointer_Diagonal_Offsets[Index];
+			Length = Pointer_Grid->Pointer_Diagonal_Offsets[Index + 1] - Pointer_Grid->Pointer_Diagonal_Offsets[Index];
+			break;
+
+		// Anti-diagonals, stored from north east to south west after the diagonals
+		default:
+			Index = Row + Column;
+			Position = Index - Columns_Count + 1; // The row the anti-diagonal starts from
+			if (Position < 0) Position = 0;
+			Position = Row - Position;
+			Index += Rows_Count + Columns_Count; // Anti-diagonal offsets follow the diagonal ones
+			Offset = 3 * Cells_Count + Pointer_Grid->Pointer_Diagonal_Offsets[Index];
+			Length = Pointer_Grid->Pointer_Diagonal_Offsets[Index + 1] - Pointer_Grid->Pointer_Diagonal_Offsets[Index];
+			break;
 	}
 
-	Grid_Cells[Row * Grid_Columns_Count + Column].Is_Letter_Present_In_Word = 1;
+	// The diagonal directions going backward read the same strip toward its beginning
+	if ((Direction == GRID_DIRECTION_NORTH_WEST) || (Direction == GRID_DIRECTION_NORTH_EAST)) *Pointer_Remaining_Letters_Count = Position + 1;
+	else *Pointer_Remaining_Letters_Count = Length - Position;
+	return Offset + Position;
+}
+
+/** Copy the letters of a grid line to its strip.
+ * @param Pointer_Grid The grid, its diagonal offsets must have been computed.
+ * @param Direction The line direction.
+ * @param Row The line first cell row.
+ * @param Column The line first cell column.
+ */
+static void GridCopyLineToStrip(TGrid *Pointer_Grid, TGridDirection Direction, int Row, int Column)
+{
+	int Letters_Count, Cell_Step, i;
+	char *Pointer_Strip, *Pointer_Letter;
+
+	Pointer_Strip = &Pointer_Grid->Pointer_Letters[GridGetStripOffset(Pointer_Grid, Direction, Row, Column, &Letters_Count)];
+	Pointer_Letter = &Pointer_Grid->Pointer_Letters[Row * Pointer_Grid->Columns_Count + Column];
+	Cell_Step = Grid_Direction_Row_Steps[Direction] * Pointer_Grid->Columns_Count + Grid_Direction_Column_Steps[Direction];
+
+	for (i = 0; i < Letters_Count; i++)
+	{
+		Pointer_Strip[i] = *Pointer_Letter;
+		Pointer_Letter += Cell_Step;
+	}
+}
+
+/** Store the grid letters once per line orientation (rows, columns, diagonals and anti-diagonals), each grid line in a contiguous strip. The backward directions read the same strips in reverse. The letters buffer already stores the rows, the other strips are appended to it, so a grid uses 4 bytes per cell (plus a found bit).
+ * @param Pointer_Grid The loaded grid.
+ * @return -1 if no more heap memory is available,
+ * @return 0 on success.
+ */
+static int GridBuildStrips(TGrid *Pointer_Grid)
+{
+	int Rows_Count = Pointer_Grid->Rows_Count, Columns_Count = Pointer_Grid->Columns_Count, Diagonals_Count, i, First_Row, First_Column, Length, Offset, Row, Column, Direction, Row_Step, Column_Step;
+	size_t Size, Offsets_Count;
+	char *Pointer_Letters;
+	int *Pointer_Offsets;
+
+	// An empty grid has no strip
+	if ((Rows_Count == 0) || (Columns_Count == 0)) return 0;
+
+	// Make room for the other strips after the rows, the kernels may read a whole vector past the last letter. Do not double the buffer like when reading the rows, the strips size is final
+	Size = (size_t) GRID_STRIPS_COUNT * Rows_Count * Columns_Count + GRID_VECTOR_SIZE;
+	if (Size > Pointer_Grid->Allocated_Letters_Count)
+	{
+		Pointer_Letters = realloc(Pointer_Grid->Pointer_Letters, Size);
+		if (Pointer_Letters == NULL) return -1;
+		Pointer_Grid->Pointer_Letters = Pointer_Letters;
+		Pointer_Grid->Allocated_Letters_Count = Size;
+	}
+	memset(&Pointer_Grid->Pointer_Letters[Size - GRID_VECTOR_SIZE], 0, GRID_VECTOR_SIZE);
+
+	// Each offsets array has one more entry than the amount of diagonals, so each diagonal length can be computed
+	Diagonals_Count = Rows_Count + Columns_Count - 1;
+	Offsets_Count = 2 * ((size_t) Diagonals_Count + 1);
+	if (Offsets_Count > Pointer_Grid->Allocated_Diagonal_Offsets_Count)
+	{
+		Pointer_Offsets = realloc(Pointer_Grid->Pointer_Diagonal_Offsets, Offsets_Count * sizeof(int));
+		if (Pointer_Offsets == NULL) return -1;
+		Pointer_Grid->Pointer_Diagonal_Offsets = Pointer_Offsets;
+		Pointer_Grid->Allocated_Diagonal_Offsets_Count = Offsets_Count;
+	}
+
+	// Diagonals are numbered from the north east corner to the south west one, anti-diagonals from the north west corner to the south east one
+	Pointer_Offsets = Pointer_Grid->Pointer_Diagonal_Offsets;
+	Offset = 0;
+	for (i = 0; i < Diagonals_Count; i++)
+	{
+		First_Row = Rows_Count - 1 - i;
+		if (First_Row < 0) First_Row = 0;
+		First_Column = i - (Rows_Count - 1);
+		if (First_Column < 0) First_Column = 0;
+		Length = Rows_Count - First_Row < Columns_Count - First_Column ? Rows_Count - First_Row : Columns_Count - First_Column;
+
+		Pointer_Offsets[i] = Offset;
+		Offset += Length;
+	}
+	Pointer_Offsets[Diagonals_Count] = Offset;
+
+	Pointer_Offsets = &Pointer_Grid->Pointer_Diagonal_Offsets[Diagonals_Count + 1];
+	Offset = 0;
+	for (i = 0; i < Diagonals_Count; i++)
+	{
+		First_Row = i - (Columns_Count - 1);
+		if (First_Row < 0) First_Row = 0;
+		First_Column = i - First_Row;
+		Length = Rows_Count - First_Row < First_Column + 1 ? Rows_Count - First_Row : First_Column + 1;
+
+		Pointer_Offsets[i] = Offset;
+		Offset += Length;
+	}
+	Pointer_Offsets[Diagonals_Count] = Offset;
+
+	// Copy each grid line to its strip, a line starts from each cell having no previous letter in the direction (the rows are already in place)
+	for (Direction = 0; Direction < GRID_DIRECTIONS_COUNT; Direction++)
+	{
+		if (GRID_IS_DIRECTION_BACKWARD(Direction) || (Direction == GRID_DIRECTION_EAST)) continue;
+		Row_Step = Grid_Direction_Row_Steps[Direction];
+		Column_Step = Grid_Direction_Column_Steps[Direction];
+		for (Row = 0; Row < Rows_Count; Row++)
+		{
+			// All cells of the first row met by the direction start a line
+			if ((Row_Step != 0) && ((Row - Row_Step < 0) || (Row - Row_Step >= Rows_Count)))
+			{
+				for (Column = 0; Column < Columns_Count; Column++) GridCopyLineToStrip(Pointer_Grid, Direction, Row, Column);
+			}
+			// Only the first column met by the direction starts a line on the other rows
+			else if (Column_Step != 0) GridCopyLineToStrip(Pointer_Grid, Direction, Row, Column_Step > 0 ? 0 : Columns_Count - 1);
+		}
+	}
+
+	return 0;
+}
+
+/** Try to find a word in a single direction from a cell. The function is always inlined with a constant direction, so each direction gets its own code with the strip offset computation specialized for its steps.
+ * @param Pointer_Grid The grid.
+ * @param Direction The direction to try.
+ * @param Pointer_Word The prepared word. Its reversed forms are computed here the first time a backward direction needs them.
+ * @param Row The vertical coordinate to start searching from.
+ * @param Column The horizontal coordinate to start searching from.
+ * @param Pointer_Counters The counters to update, or NULL to count nothing.
+ * @return 1 if the word has been found,
+ * @return 0 if the word could not be found.
+ */
+static inline __attribute__((always_inline)) int GridMatchWordDirection(TGrid *Pointer_Grid, TGridDirection Direction, TGridSearchedWord *Pointer_Word, int Row, int Column, TGridSearchCounters *Pointer_Counters)
+{
+	int Remaining_Letters_Count, Word_Length = Pointer_Word->Length, i;
+	size_t Offset;
+	unsigned long long Packed_Letters, Packed_Word;
+	char *Pointer_String_Word;
+
+	// Can the word fit between the location and the grid border ? This is the only bounds check, the letters are then read from a contiguous strip
+	Offset = GridGetStripOffset(Pointer_Grid, Direction, Row, Column, &Remaining_Letters_Count);
+	if (Remaining_Letters_Count < Word_Length)
+	{
+		if (Pointer_Counters != NULL) Pointer_Counters->Rejected_Directions_Count++;
+		return 0;
+	}
+
+	// A word read backward from the cell is the reversed word read forward from its last letter
+	if (GRID_IS_DIRECTION_BACKWARD(Direction))
+	{
+		Offset -= Word_Length - 1;
+
+		// Check the word last letter before reversing the word, most candidates stop here
+		if (Pointer_Grid->Pointer_Letters[Offset] != Pointer_Word->Pointer_String_Original_Word[Word_Length - 1])
+		{
+			if (Pointer_Counters != NULL) Pointer_Counters->Compared_Letters_Count++;
+			return 0;
+		}
+		if (!Pointer_Word->Is_Reversed_Word_Ready)
+		{
+			for (i = 0; i < Word_Length; i++) Pointer_Word->String_Reversed_Word[i] = Pointer_Word->Pointer_String_Original_Word[Word_Length - 1 - i];
+			if (Word_Length <= (int) sizeof(Packed_Letters)) memcpy(&Pointer_Word->Packed_Reversed_Word, Pointer_Word->String_Reversed_Word, Word_Length);
+			Pointer_Word->Is_Reversed_Word_Ready = 1;
+		}
+		Pointer_String_Word = Pointer_Word->String_Reversed_Word;
+		Packed_Word = Pointer_Word->Packed_Reversed_Word;
+	}
+	else
+	{
+		Pointer_String_Word = Pointer_Word->String_Word;
+		Packed_Word = Pointer_Word->Packed_Word;
+	}
+
+	// Does the searched word match ?
+	if (Pointer_Counters != NULL) Pointer_Counters->Compared_Letters_Count += Word_Length;
+	if (Word_Length <= (int) sizeof(Packed_Letters))
+	{
+		// Short words are compared with a single integer comparison, the strips are followed by enough bytes to always read a whole integer
+		memcpy(&Packed_Letters, &Pointer_Grid->Pointer_Letters[Offset], sizeof(Packed_Letters));
+		return (Packed_Letters & Pointer_Word->Packed_Mask) == Packed_Word;
+	}
+	return Pointer_Grid->Pointer_Compare_Letters_Function(&Pointer_Grid->Pointer_Letters[Offset], Pointer_String_Word, Word_Length);
+}
+
+/** Try a direction with its specialized code, returning from the calling function if the word is found. */
+#define GRID_TRY_DIRECTION(Direction) if (GridMatchWordDirection(Pointer_Grid, Direction, &Word, Row, Column, Pointer_Counters)) return Direction
+
+/** Try to find a word in every direction from a cell. The function is inlined in both public callers, so the counting code disappears when no counters are provided.
+ * @param Pointer_Grid The grid.
+ * @param Pointer_String_Word The word to search.
+ * @param Word_Length The word length.
+ * @param Row The vertical coordinate to start searching from.
+ * @param Column The horizontal coordinate to start searching from.
+ * @param Pointer_Counters The counters to update, or NULL to count nothing.
+ * @return -1 if the word could not be found,
+ * @return The first matching direction (in TGridDirection order) if the word has been found.
+ */
+static inline __attribute__((always_inline)) int GridSearchWordDirection(TGrid *Pointer_Grid, char *Pointer_String_Word, int Word_Length, int Row, int Column, TGridSearchCounters *Pointer_Counters)
+{
+	TGridSearchedWord Word;
+
+	if (Word_Length >= CONFIGURATION_WORD_MAXIMUM_STRING_SIZE) return -1;
+	Word.Pointer_String_Original_Word = Pointer_String_Word;
+	Word.Length = Word_Length;
+	Word.Is_Reversed_Word_Ready = 0;
+
+	// Pack short words in an integer, copy longer ones to a buffer the kernels can read a whole vector past the word end from
+	if (Word_Length <= (int) sizeof(Word.Packed_Word))
+	{
+		Word.Packed_Word = 0;
+		Word.Packed_Reversed_Word = 0;
+		Word.Packed_Mask = 0;
+		memcpy(&Word.Packed_Word, Pointer_String_Word, Word_Length);
+		memset(&Word.Packed_Mask, 0xFF, Word_Length); // Select the same bytes than the word ones whatever the processor byte order
+	}
+	else memcpy(Word.String_Word, Pointer_String_Word, Word_Length);
+
+	// Keep the TGridDirection order, the first matching direction is reported
+	GRID_TRY_DIRECTION(GRID_DIRECTION_NORTH);
+	GRID_TRY_DIRECTION(GRID_DIRECTION_NORTH_EAST);
+	GRID_TRY_DIRECTION(GRID_DIRECTION_EAST);
+	GRID_TRY_DIRECTION(GRID_DIRECTION_SOUTH_EAST);
+	GRID_TRY_DIRECTION(GRID_DIRECTION_SOUTH);
+	GRID_TRY_DIRECTION(GRID_DIRECTION_SOUTH_WEST);
+	GRID_TRY_DIRECTION(GRID_DIRECTION_WEST);
+	GRID_TRY_DIRECTION(GRID_DIRECTION_NORTH_WEST);
+	return -1;
 }
 
 //-------------------------------------------------------------------------------------------------
 // Public functions
 //-------------------------------------------------------------------------------------------------
-int GridLoadFromFile(char *Pointer_String_File_Name, TWordList *Pointer_Word_Lists, int *Pointer_Rows_Count, int *Pointer_Columns_Count, int *Pointer_Words_Count)
+void GridInitialize(TGrid *Pointer_Grid)
 {
-	FILE *Pointer_File = NULL;
-	int i, Return_Value = -1, Words_Count = 0;
-	char String_Temporary[256];
-	size_t Length;
-	TGridCell *Pointer_Grid_Cell = Grid_Cells;
+	memset(Pointer_Grid, 0, sizeof(TGrid));
+
+	// Use the widest vectors the processor supports
+	Pointer_Grid->Pointer_Compare_Letters_Function = GridCompareLettersScalar;
+	#ifdef GRID_IS_X86_PROCESSOR
+		__builtin_cpu_init();
+		if (__builtin_cpu_supports("avx2")) Pointer_Grid->Pointer_Compare_Letters_Function = GridCompareLettersAvx2;
+		else if (__builtin_cpu_supports("sse2")) Pointer_Grid->Pointer_Compare_Letters_Function = GridCompareLettersSse2;
+	#endif
+}
+
+void GridFree(TGrid *Pointer_Grid)
+{
+	GridUnmapFile(Pointer_Grid);
+	free(Pointer_Grid->Pointer_Letters);
+	free(Pointer_Grid->Pointer_Found_Bits);
+	free(Pointer_Grid->Pointer_File_Buffer);
+	free(Pointer_Grid->Pointer_Diagonal_Offsets);
+	GridInitialize(Pointer_Grid);
+}
+
+int GridLoadFromFile(TGrid *Pointer_Grid, char *Pointer_String_File_Name, TWordTable *Pointer_Word_Table, int *Pointer_Rows_Count, int *Pointer_Columns_Count, int *Pointer_Words_Count)
+{
+	int File_Descriptor, Return_Value = -1;
+	size_t Size;
+
+	// Forget any previously loaded grid and words, their memory will be reused
+	WordTableClear(Pointer_Word_Table, NULL);
+	GridUnmapFile(Pointer_Grid);
+	Pointer_Grid->Rows_Count = 0;
+	Pointer_Grid->Columns_Count = 0;
 
 	// Try to open the file
-	Pointer_File = fopen(Pointer_String_File_Name, "r");
-	if (Pointer_File == NULL)
+	File_Descriptor = open(Pointer_String_File_Name, O_RDONLY);
+	if (File_Descriptor < 0)
 	{
 		printf("Error : could not open the file \"%s\" (%s).\n", Pointer_String_File_Name, strerror(errno));
 		return -1;
 	}
+	if (GridMapFile(Pointer_Grid, Pointer_String_File_Name, File_Descriptor, &Size) != 0) goto Exit;
+
+	Return_Value = GridLoadFromMemory(Pointer_Grid, Pointer_Grid->Pointer_File_Content, Size, Pointer_Word_Table, Pointer_Rows_Count, Pointer_Columns_Count, Pointer_Words_Count);
+
+Exit:
+	close(File_Descriptor);
+	return Return_Value;
+}
+
+int GridLoadFromMemory(TGrid *Pointer_Grid, char *Pointer_Content, size_t Size, TWordTable *Pointer_Word_Table, int *Pointer_Rows_Count, int *Pointer_Columns_Count, int *Pointer_Words_Count)
+{
+	int Words_Count = 0, Is_Valid;
+	size_t Length;
+	char *Pointer_Character, *Pointer_End, *Pointer_Token;
+
+	// Forget any previously loaded grid and words, their memory will be reused
+	Pointer_Grid->Rows_Count = 0;
+	Pointer_Grid->Columns_Count = 0;
+	Pointer_Character = Pointer_Content;
+	Pointer_End = Pointer_Character + Size;
+	WordTableClear(Pointer_Word_Table, Pointer_Character);
 
 	// Load grid content
 	while (1)
 	{
 		// Retrieve the next grid row
-		errno = 0;
-		if (fscanf(Pointer_File, "%s", String_Temporary) != 1)
+		Pointer_Token = GridReadToken(&Pointer_Character, Pointer_End, &Length, &Is_Valid);
+		// The end of the file is reached
+		if (Pointer_Token == NULL)
 		{
-			if (errno != 0)
-			{
-				printf("Error : could not read the file \"%s\" (%s).\n", Pointer_String_File_Name, strerror(errno));
-				goto Exit;
-			}
-			// The end of the file is reached
-			else
-			{
-				printf("Error : end of file has been reached without reaching the list of words to find.\n");
-				goto Exit;
-			}
+			printf("Error : end of file has been reached without reaching the list of words to find.\n");
+			return -1;
 		}
 
 		// Go to the next step if the separator has been found
-		if (strcmp(String_Temporary, "-") == 0) break;
+		if ((Length == 1) && (*Pointer_Token == '-')) break;
 
 		// Determine the column size
-		Length = strlen(String_Temporary);
 		if (Length > CONFIGURATION_GRID_MAXIMUM_SIZE)
 		{
 			printf("Error : grid row size can't be greater than %d characters.\n", CONFIGURATION_GRID_MAXIMUM_SIZE);
-			goto Exit;
+			return -1;
+		}
+		if (Pointer_Grid->Rows_Count >= CONFIGURATION_GRID_MAXIMUM_SIZE)
+		{
+			printf("Error : grid can't have more than %d rows.\n", CONFIGURATION_GRID_MAXIMUM_SIZE);
+			return -1;
 		}
 
 		// Does the line contain only the allowed characters ?
-		if (GridValidateString(String_Temporary) != 0)
+		if (!Is_Valid)
 		{
-			printf("Error : the grid line \"%s\" contains invalid characters (only letters are allowed).\n", String_Temporary);
-			goto Exit;
+			printf("Error : the grid line \"%.*s\" contains invalid characters (only letters are allowed).\n", (int) Length, Pointer_Token);
+			return -1;
 		}
 
 		// Set the grid width if this is the first row read
-		if (Grid_Columns_Count == 0) Grid_Columns_Count = Length;
+		if (Pointer_Grid->Columns_Count == 0) Pointer_Grid->Columns_Count = Length;
 		// Grid width has already been found, make sure this line has the correct length
-		else if ((int) Length != Grid_Columns_Count)
+		else if ((int) Length != Pointer_Grid->Columns_Count)
 		{
 			printf("Error : all grid lines must be of the same length.\n");
-			goto Exit;
+			return -1;
 		}
 
-		// Fill the current grid row with the read content
-		for (i = 0; i < Grid_Columns_Count; i++)
+		// Make room for the new row
+		if (GridReserveLetters(Pointer_Grid, (size_t) (Pointer_Grid->Rows_Count + 1) * Pointer_Grid->Columns_Count) != 0)
 		{
-			Pointer_Grid_Cell->Letter = String_Temporary[i];
-			Pointer_Grid_Cell++;
+			printf("Error : not enough memory to store the grid.\n");
+			return -1;
 		}
-		Grid_Rows_Count++;
+
+		// Fill the current grid row with the read content
+		memcpy(&Pointer_Grid->Pointer_Letters[(size_t) Pointer_Grid->Rows_Count * Pointer_Grid->Columns_Count], Pointer_Token, Pointer_Grid->Columns_Count);
+		Pointer_Grid->Rows_Count++;
 	}
 
-	// Initialize all word lists before adding words to them
-	for (i = 0; i < CONFIGURATION_ALPHABET_LETTERS_COUNT; i++) WordListInitialize(&Pointer_Word_Lists[i]);
+	// No letter is part of a found word yet, and make the letters following each cell contiguous in all directions
+	if ((GridClearFoundBits(Pointer_Grid) != 0) || (GridBuildStrips(Pointer_Grid) != 0))
+	{
+		printf("Error : not enough memory to store the grid.\n");
+		return -1;
+	}
 
 	// Read one word at a time
 	while (1)
 	{
 		// Retrieve the next word
-		errno = 0;
-		if (fscanf(Pointer_File, "%s", String_Temporary) != 1)
-		{
-			if (errno != 0)
-			{
-				printf("Error : could not read the file \"%s\" (%s).\n", Pointer_String_File_Name, strerror(errno));
-				goto Exit;
-			}
-			// The end of the file is reached
-			else break;
-		}
+		Pointer_Token = GridReadToken(&Pointer_Character, Pointer_End, &Length, &Is_Valid);
+		// The end of the file is reached
+		if (Pointer_Token == NULL) break;
 
 		// Is the next word size valid ?
-		Length = strlen(String_Temporary);
-		if (Length == 0)
+		if (Length >= CONFIGURATION_WORD_MAXIMUM_STRING_SIZE)
 		{
-			printf("Error : a searched word can't be empty.\n");
-			goto Exit;
-		}
-		if (Length >= CONFIGURATION_WORD_LIST_ITEM_MAXIMUM_STRING_SIZE)
-		{
-			printf("Error : the searched word \"%s\" is too long.\n", String_Temporary);
-			goto Exit;
+			printf("Error : the searched word \"%.*s\" is too long.\n", (int) Length, Pointer_Token);
+			return -1;
 		}
 
 		// Does the word contain only the allowed characters ?
-		if (GridValidateString(String_Temporary) != 0)
+		if (!Is_Valid)
 		{
-			printf("Error : the word \"%s\" contains invalid characters (only letters are allowed).\n", String_Temporary);
-			goto Exit;
+			printf("Error : the word \"%.*s\" contains invalid characters (only letters are allowed).\n", (int) Length, Pointer_Token);
+			return -1;
 		}
 
-		// The word is valid, insert it to the correct list
-		i = String_Temporary[0] - 'A'; // Recycle 'i' variable to compute the destination list
-		if (WordListInsert(&Pointer_Word_Lists[i], String_Temporary) != 0)
+		// Terminate the word in place (the separator following the word, or the byte following the file content, is overwritten), so the word table can point to it
+		Pointer_Token[Length] = 0;
+		if (Pointer_Character < Pointer_End) Pointer_Character++;
+
+		// The word is valid, add it to the table
+		if (WordTableAppend(Pointer_Word_Table, Pointer_Token, (int) Length) != 0)
 		{
-			printf("Error : failed to insert the word in the list of the letter '%c'.\n", String_Temporary[0]);
-			goto Exit;
+			printf("Error : not enough memory to store the word \"%s\".\n", Pointer_Token);
+			return -1;
 		}
 		Words_Count++;
 	}
+	WordTableSortWords(Pointer_Word_Table);
 
-	*Pointer_Rows_Count = Grid_Rows_Count;
-	*Pointer_Columns_Count = Grid_Columns_Count;
+	*Pointer_Rows_Count = Pointer_Grid->Rows_Count;
+	*Pointer_Columns_Count = Pointer_Grid->Columns_Count;
 	*Pointer_Words_Count = Words_Count;
 
-	// Everything went fine, display some statistics
-	printf("Successfully loaded a %dx%d grid and %d words to search.\n", Grid_Columns_Count, Grid_Rows_Count, Words_Count);
+	return 0;
+}
+
+int GridLoadWordsFromFile(TGrid *Pointer_Grid, char *Pointer_String_File_Name, TWordTable *Pointer_Word_Table, int *Pointer_Skipped_Words_Count)
+{
+	int File_Descriptor, Return_Value = -1, Is_Valid, Skipped_Words_Count = 0;
+	size_t Size, Length;
+	char *Pointer_Character, *Pointer_End, *Pointer_Token;
+
+	// Forget any previously loaded grid and words, this grid only holds the words file content
+	WordTableClear(Pointer_Word_Table, NULL);
+	GridUnmapFile(Pointer_Grid);
+	Pointer_Grid->Rows_Count = 0;
+	Pointer_Grid->Columns_Count = 0;
+
+	File_Descriptor = open(Pointer_String_File_Name, O_RDONLY);
+	if (File_Descriptor < 0)
+	{
+		printf("Error : could not open the file \"%s\" (%s).\n", Pointer_String_File_Name, strerror(errno));
+		return -1;
+	}
+	if (GridMapFile(Pointer_Grid, Pointer_String_File_Name, File_Descriptor, &Size) != 0) goto Exit;
+	Pointer_Character = Pointer_Grid->Pointer_File_Content;
+	Pointer_End = Pointer_Character + Size;
+	WordTableClear(Pointer_Word_Table, Pointer_Character);
+
+	while ((Pointer_Token = GridReadToken(&Pointer_Character, Pointer_End, &Length, &Is_Valid)) != NULL)
+	{
+		// Big word lists often contain words that can't be in a grid, ignore them instead of rejecting the whole list
+		if (!Is_Valid || (Length >= CONFIGURATION_WORD_MAXIMUM_STRING_SIZE))
+		{
+			Skipped_Words_Count++;
+			continue;
+		}
+
+		// Terminate the word in place, like the puzzle words
+		Pointer_Token[Length] = 0;
+		if (Pointer_Character < Pointer_End) Pointer_Character++;
+
+		if (WordTableAppend(Pointer_Word_Table, Pointer_Token, (int) Length) != 0)
+		{
+			printf("Error : not enough memory to store the word \"%s\".\n", Pointer_Token);
+			goto Exit;
+		}
+	}
+	WordTableSortWords(Pointer_Word_Table);
+
+	*Pointer_Skipped_Words_Count = Skipped_Words_Count;
 	Return_Value = 0;
 
 Exit:
-	if (Pointer_File != NULL) fclose(Pointer_File);
+	close(File_Descriptor);
 	return Return_Value;
 }
 
-char GridGetLetter(int Row, int Column)
+int GridLoadFromLetters(TGrid *Pointer_Grid, char *Pointer_Letters, int Rows_Count, int Columns_Count)
+{
+	size_t Letters_Count = (size_t) Rows_Count * Columns_Count;
+
+	Pointer_Grid->Rows_Count = Rows_Count;
+	Pointer_Grid->Columns_Count = Columns_Count;
+	if (GridReserveLetters(Pointer_Grid, Letters_Count) != 0) return -1;
+	if (Letters_Count > 0) memcpy(Pointer_Grid->Pointer_Letters, Pointer_Letters, Letters_Count);
+
+	// No letter is part of a found word yet, and make the letters following each cell contiguous in all directions
+	if ((GridClearFoundBits(Pointer_Grid) != 0) || (GridBuildStrips(Pointer_Grid) != 0)) return -1;
+	return 0;
+}
+
+char GridGetLetter(TGrid *Pointer_Grid, int Row, int Column)
 {
 	// Make sure provided coordinates are valid
-	if ((Row < 0) || (Row >= Grid_Rows_Count) || (Column < 0) || (Column >= Grid_Columns_Count))
+	if ((Row < 0) || (Row >= Pointer_Grid->Rows_Count) || (Column < 0) || (Column >= Pointer_Grid->Columns_Count))
 	{
 		printf("Error : the invalid coordinates %dx%d have been specified, returning 0.\n", Column, Row);
 		return 0;
 	}
 
-	return Grid_Cells[Row * Grid_Columns_Count + Column].Letter;
+	return Pointer_Grid->Pointer_Letters[Row * Pointer_Grid->Columns_Count + Column];
 }
 
-int GridMatchWordWithPosition(char *Pointer_String_Word, int Row, int Column)
+int GridSetLetter(TGrid *Pointer_Grid, int Row, int Column, char Letter)
 {
-	int Word_Length, i;
-	char String_Temporary[CONFIGURATION_WORD_LIST_ITEM_MAXIMUM_STRING_SIZE], *Pointer_String_Temporary;
-
-	// Cache word to search length
-	Word_Length = (int) strlen(Pointer_String_Word);
+	int Direction, Remaining_Letters_Count;
 
-	// Can the word be compared to the location's north ?
-	if ((Row + 1) - Word_Length >= 0)
+	// Make sure provided coordinates and letter are valid
+	if ((Row < 0) || (Row >= Pointer_Grid->Rows_Count) || (Column < 0) || (Column >= Pointer_Grid->Columns_Count))
 	{
-		// Retrieve the characters of the word to compare
-		Pointer_String_Temporary = String_Temporary;
-		for (i = 0; i < Word_Length; i++)
-		{
-			*Pointer_String_Temporary = GridGetLetter(Row - i, Column);
-			Pointer_String_Temporary++;
-		}
-		*Pointer_String_Temporary = 0;
-
-		// Does the searched word match ?
-		if (strncmp(Pointer_String_Word, String_Temporary, Word_Length) == 0)
-		{
-			for (i = 0; i < Word_Length; i++) GridSetLetterFound(Row - i, Column);
-			return 0;
-		}
+		printf("Error : the invalid coordinates %dx%d have been specified.\n", Column, Row);
+		return -1;
 	}
-
-	// Can the word be compared to the location's north east ?
-	if ((Row + 1 >= Word_Length) && (Grid_Columns_Count - Column >= Word_Length)) // There is enough room vertically and vertically for the whole word to fit
+	if ((Letter >= 'a') && (Letter <= 'z')) Letter -= 'a' - 'A';
+	if ((Letter < 'A') || (Letter > 'Z'))
 	{
-		// Retrieve the characters of the word to compare
-		Pointer_String_Temporary = String_Temporary;
-		for (i = 0; i < Word_Length; i++)
-		{
-			*Pointer_String_Temporary = GridGetLetter(Row - i, Column + i);
-			Pointer_String_Temporary++;
-		}
-		*Pointer_String_Temporary = 0;
-
-		// Does the searched word match ?
-		if (strncmp(Pointer_String_Word, String_Temporary, Word_Length) == 0)
-		{
-			for (i = 0; i < Word_Length; i++) GridSetLetterFound(Row - i, Column + i);
-			return 0;
-		}
+		printf("Error : the character '%c' is not a letter.\n", Letter);
+		return -1;
 	}
 
-	// Can the word be compared to the location's east ?
-	if (Column + Word_Length <= Grid_Columns_Count)
+	// The letter is stored once in each strip, the rows strip being the grid letters
+	for (Direction = 0; Direction < GRID_DIRECTIONS_COUNT; Direction++)
 	{
-		// Retrieve the characters of the word to compare
-		Pointer_String_Temporary = String_Temporary;
-		for (i = 0; i < Word_Length; i++)
-		{
-			*Pointer_String_Temporary = GridGetLetter(Row, Column + i);
-			Pointer_String_Temporary++;
-		}
-		*Pointer_String_Temporary = 0;
-
-		// Does the searched word match ?
-		if (strncmp(Pointer_String_Word, String_Temporary, Word_Length) == 0)
-		{
-			for (i = 0; i < Word_Length; i++) GridSetLetterFound(Row, Column + i);
-			return 0;
-		}
+		if (!GRID_IS_DIRECTION_BACKWARD(Direction)) Pointer_Grid->Pointer_Letters[GridGetStripOffset(Pointer_Grid, Direction, Row, Column, &Remaining_Letters_Count)] = Letter;
 	}
 
-	// Can the word be compared to the location's south east ?
-	if ((Grid_Rows_Count - Row >= Word_Length) && (Grid_Columns_Count - Column >= Word_Length)) // There is enough room vertically and vertically for the whole word to fit
-	{
-		// Retrieve the characters of the word to compare
-		Pointer_String_Temporary = String_Temporary;
-		for (i = 0; i < Word_Length; i++)
-		{
-			*Pointer_String_Temporary = GridGetLetter(Row + i, Column + i);
-			Pointer_String_Temporary++;
-		}
-		*Pointer_String_Temporary = 0;
+	return 0;
+}
 
-		// Does the searched word match ?
-		if (strncmp(Pointer_String_Word, String_Temporary, Word_Length) == 0)
-		{
-			for (i = 0; i < Word_Length; i++) GridSetLetterFound(Row + i, Column + i);
-			return 0;
-		}
-	}
+char *GridGetDirectionLetters(TGrid *Pointer_Grid, TGridDirection Direction, int Row, int Column, int *Pointer_Letters_Count, int *Pointer_Step)
+{
+	if (GRID_IS_DIRECTION_BACKWARD(Direction)) *Pointer_Step = -1;
+	else *Pointer_Step = 1;
+	return &Pointer_Grid->Pointer_Letters[GridGetStripOffset(Pointer_Grid, Direction, Row, Column, Pointer_Letters_Count)];
+}
 
-	// Can the word be compared to the location's south ?
-	if (Grid_Rows_Count - Row >= Word_Length)
-	{
-		// Retrieve the characters of the word to compare
-		Pointer_String_Temporary = String_Temporary;
-		for (i = 0; i < Word_Length; i++)
-		{
-			*Pointer_String_Temporary = GridGetLetter(Row + i, Column);
-			Pointer_String_Temporary++;
-		}
-		*Pointer_String_Temporary = 0;
+int GridFindWordDirection(TGrid *Pointer_Grid, char *Pointer_String_Word, int Word_Length, int Row, int Column)
+{
+	return GridSearchWordDirection(Pointer_Grid, Pointer_String_Word, Word_Length, Row, Column, NULL);
+}
 
-		// Does the searched word match ?
-		if (strncmp(Pointer_String_Word, String_Temporary, Word_Length) == 0)
-		{
-			for (i = 0; i < Word_Length; i++) GridSetLetterFound(Row + i, Column);
-			return 0;
-		}
-	}
+int GridFindWordDirectionCounted(TGrid *Pointer_Grid, char *Pointer_String_Word, int Word_Length, int Row, int Column, TGridSearchCounters *Pointer_Counters)
+{
+	return GridSearchWordDirection(Pointer_Grid, Pointer_String_Word, Word_Length, Row, Column, Pointer_Counters);
+}
 
-	// Can the word be compared to the location's south west
-	if ((Grid_Rows_Count - Row >= Word_Length) && (Column + 1 >= Word_Length))
-	{
-		// Retrieve the characters of the word to compare
-		Pointer_String_Temporary = String_Temporary;
-		for (i = 0; i < Word_Length; i++)
-		{
-			*Pointer_String_Temporary = GridGetLetter(Row + i, Column - i);
-			Pointer_String_Temporary++;
-		}
-		*Pointer_String_Temporary = 0;
+int GridMatchWordWithPosition(TGrid *Pointer_Grid, char *Pointer_String_Word, int Word_Length, int Row, int Column)
+{
+	int Direction;
 
-		// Does the searched word match ?
-		if (strncmp(Pointer_String_Word, String_Temporary, Word_Length) == 0)
-		{
-			for (i = 0; i < Word_Length; i++) GridSetLetterFound(Row + i, Column - i);
-			return 0;
-		}
-	}
+	Direction = GridFindWordDirection(Pointer_Grid, Pointer_String_Word, Word_Length, Row, Column);
+	if (Direction < 0) return -1;
 
-	// Can the word be compared to the location's west
-	if (Column + 1 >= Word_Length)
-	{
-		// Retrieve the characters of the word to compare
-		Pointer_String_Temporary = String_Temporary;
-		for (i = 0; i < Word_Length; i++)
-		{
-			*Pointer_String_Temporary = GridGetLetter(Row, Column - i);
-			Pointer_String_Temporary++;
-		}
-		*Pointer_String_Temporary = 0;
+	GridSetWordFound(Pointer_Grid, Row, Column, Direction, Word_Length);
+	return 0;
+}
 
-		// Does the searched word match ?
-		if (strncmp(Pointer_String_Word, String_Temporary, Word_Length) == 0)
-		{
-			for (i = 0; i < Word_Length; i++) GridSetLetterFound(Row, Column - i);
-			return 0;
-		}
-	}
+void GridGetDirectionSteps(TGridDirection Direction, int *Pointer_Row_Step, int *Pointer_Column_Step)
+{
+	*Pointer_Row_Step = Grid_Direction_Row_Steps[Direction];
+	*Pointer_Column_Step = Grid_Direction_Column_Steps[Direction];
+}
 
-	// Can the word be compared to the location's north west
-	if ((Row + 1 >= Word_Length) && (Column + 1 >= Word_Length))
-	{
-		// Retrieve the characters of the word to compare
-		Pointer_String_Temporary = String_Temporary;
-		for (i = 0; i < Word_Length; i++)
-		{
-			*Pointer_String_Temporary = GridGetLetter(Row - i, Column - i);
-			Pointer_String_Temporary++;
-		}
-		*Pointer_String_Temporary = 0;
+void GridSetWordFound(TGrid *Pointer_Grid, int Row, int Column, TGridDirection Direction, int Length)
+{
+	int i, Last_Row, Last_Column, Cell_Step;
+	size_t Cell_Index;
 
-		// Does the searched word match ?
-		if (strncmp(Pointer_String_Word, String_Temporary, Word_Length) == 0)
-		{
-			for (i = 0; i < Word_Length; i++) GridSetLetterFound(Row - i, Column - i);
-			return 0;
-		}
+	// Make sure the whole word is inside the grid, so the letters loop does not need to check each coordinate
+	Last_Row = Row + (Length - 1) * Grid_Direction_Row_Steps[Direction];
+	Last_Column = Column + (Length - 1) * Grid_Direction_Column_Steps[Direction];
+	if ((Row < 0) || (Row >= Pointer_Grid->Rows_Count) || (Column < 0) || (Column >= Pointer_Grid->Columns_Count) || (Last_Row < 0) || (Last_Row >= Pointer_Grid->Rows_Count) || (Last_Column < 0) || (Last_Column >= Pointer_Grid->Columns_Count))
+	{
+		printf("Error : the invalid coordinates %dx%d have been specified.\n", Column, Row);
+		return;
 	}
 
-	return -1;
+	// Set one bit per letter, moving by a constant stride in the bitset
+	Cell_Index = (size_t) Row * Pointer_Grid->Columns_Count + Column;
+	Cell_Step = Grid_Direction_Row_Steps[Direction] * Pointer_Grid->Columns_Count + Grid_Direction_Column_Steps[Direction];
+	for (i = 0; i < Length; i++)
+	{
+		Pointer_Grid->Pointer_Found_Bits[Cell_Index / 64] |= 1ULL << (Cell_Index % 64);
+		Cell_Index += Cell_Step;
+	}
 }
 
-int GridGetHiddenWord(char *Pointer_String_Hidden_Word)
+int GridGetHiddenWord(TGrid *Pointer_Grid, char **Pointer_Pointer_String_Hidden_Word, size_t *Pointer_Buffer_Size)
 {
-	int Row, Column, Size = 0;
-	TGridCell *Pointer_Cell;
-
-	// Make sure to not exceed output string size
-	for (Row = 0; Row < Grid_Rows_Count; Row++)
+	size_t i, Cells_Count, Bits_Count, Size, First_Cell_Index;
+	unsigned long long Bits;
+	char *Pointer_String;
+
+	// The cells that are not part of a found word have their bit cleared, the last bitset word may contain bits beyond the grid end
+	Cells_Count = (size_t) Pointer_Grid->Rows_Count * Pointer_Grid->Columns_Count;
+	Bits_Count = (Cells_Count + 63) / 64;
+
+	// Count the hidden word letters to allocate the string only once
+	Size = Cells_Count;
+	for (i = 0; i < Bits_Count; i++) Size -= (size_t) __builtin_popcountll(Pointer_Grid->Pointer_Found_Bits[i]);
+	if (Size + 1 > *Pointer_Buffer_Size)
 	{
-		for (Column = 0; Column < Grid_Columns_Count; Column++)
-		{
-			// Cache cell access
-			Pointer_Cell = &Grid_Cells[Row * Grid_Columns_Count + Column];
+		Pointer_String = realloc(*Pointer_Pointer_String_Hidden_Word, Size + 1);
+		if (Pointer_String == NULL) return -1;
+		*Pointer_Pointer_String_Hidden_Word = Pointer_String;
+		*Pointer_Buffer_Size = Size + 1;
+	}
 
-			// Is this letter part of the hidden word ?
-			if (!Pointer_Cell->Is_Letter_Present_In_Word)
-			{
-				// Make sure there is enough room in the string buffer
-				if (Size >= CONFIGURATION_HIDDEN_WORD_MAXIMUM_STRING_SIZE - 1) return -1;
+	// Jump from a hidden letter to the next one, skipping the found cells 64 at a time
+	Pointer_String = *Pointer_Pointer_String_Hidden_Word;
+	for (i = 0; i < Bits_Count; i++)
+	{
+		Bits = ~Pointer_Grid->Pointer_Found_Bits[i];
+		First_Cell_Index = i * 64;
+		if (Cells_Count - First_Cell_Index < 64) Bits &= (1ULL << (Cells_Count - First_Cell_Index)) - 1;
 
-				// Append the character to the string
-				*Pointer_String_Hidden_Word = Pointer_Cell->Letter;
-				Pointer_String_Hidden_Word++;
-				Size++;
-			}
+		while (Bits != 0)
+		{
+			*Pointer_String = Pointer_Grid->Pointer_Letters[First_Cell_Index + (size_t) __builtin_ctzll(Bits)];
+			Pointer_String++;
+			Bits &= Bits - 1; // Clear the lowest set bit
 		}
 	}
-
-	// Terminate string
-	*Pointer_String_Hidden_Word = 0;
+	*Pointer_String = 0;
 
 	return 0;
 }
 
-void GridDisplay(void)
+void GridDisplay(TGrid *Pointer_Grid)
 {
 	int Row, Column;
 
-	for (Row = 0; Row < Grid_Rows_Count; Row++)
+	for (Row = 0; Row < Pointer_Grid->Rows_Count; Row++)
 	{
-		for (Column = 0; Column < Grid_Columns_Count; Column++) putchar(Grid_Cells[Row * Grid_Columns_Count + Column].Letter);
+		for (Column = 0; Column < Pointer_Grid->Columns_Count; Column++) putchar(Pointer_Grid->Pointer_Letters[Row * Pointer_Grid->Columns_Count + Column]);
 		putchar('\n');
 	}
 }
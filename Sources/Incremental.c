@@ -0,0 +1,401 @@
+/** @file Incremental.c
+ * See Incremental.h for description.
+ * @author Adrien RICCIARDI
+ */
+#include <Aho_Corasick.h>
+#include <Incremental.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+//-------------------------------------------------------------------------------------------------
+// Private functions
+//-------------------------------------------------------------------------------------------------
+/** Make sure the words arrays can store the provided amount of words, growing them if needed.
+ * @param Pointer_Puzzle The puzzle.
+ * @param Words_Count How many words must fit.
+ * @return -1 if no more heap memory is available,
+ * @return 0 on success.
+ */
+static int IncrementalReserveWords(TIncrementalPuzzle *Pointer_Puzzle, int Words_Count)
+{
+	int Allocated_Words_Count;
+	char *Pointer_Words;
+	int *Pointer_Lengths;
+	long long *Pointer_Location_Keys;
+
+	if (Words_Count <= Pointer_Puzzle->Allocated_Words_Count) return 0;
+
+	// Grow by doubling, so adding words one by one stays cheap
+	Allocated_Words_Count = Pointer_Puzzle->Allocated_Words_Count * 2;
+	if (Allocated_Words_Count < Words_Count) Allocated_Words_Count = Words_Count;
+	if (Allocated_Words_Count < 16) Allocated_Words_Count = 16;
+
+	Pointer_Words = realloc(Pointer_Puzzle->Pointer_Words, (size_t) Allocated_Words_Count * CONFIGURATION_WORD_MAXIMUM_STRING_SIZE);
+	if (Pointer_Words == NULL) return -1;
+	Pointer_Puzzle->Pointer_Words = Pointer_Words;
+	Pointer_Lengths = realloc(Pointer_Puzzle->Pointer_Lengths, Allocated_Words_Count * sizeof(int));
+	if (Pointer_Lengths == NULL) return -1;
+	Pointer_Puzzle->Pointer_Lengths = Pointer_Lengths;
+	Pointer_Location_Keys = realloc(Pointer_Puzzle->Pointer_Location_Keys, Allocated_Words_Count * sizeof(long long));
+	if (Pointer_Location_Keys == NULL) return -1;
+	Pointer_Puzzle->Pointer_Location_Keys = Pointer_Location_Keys;
+	Pointer_Puzzle->Allocated_Words_Count = Allocated_Words_Count;
+
+	return 0;
+}
+
+/** Add or remove a word location from the cells coverage, marking the cells as found when they become covered and as not found when they are not covered anymore.
+ * @param Pointer_Puzzle The puzzle.
+ * @param Location_Key The word location.
+ * @param Length The word length.
+ * @param Delta 1 to cover the word cells, -1 to uncover them.
+ */
+static void IncrementalCoverWord(TIncrementalPuzzle *Pointer_Puzzle, long long Location_Key, int Length, int Delta)
+{
+	int i, Columns_Count = Pointer_Puzzle->Grid.Columns_Count, Row_Step, Column_Step, Cell_Step, Count;
+	size_t Cell_Index;
+
+	GridGetDirectionSteps(Location_Key % GRID_DIRECTIONS_COUNT, &Row_Step, &Column_Step);
+	Cell_Step = Row_Step * Columns_Count + Column_Step;
+	Cell_Index = (size_t) (Location_Key / GRID_DIRECTIONS_COUNT);
+
+	for (i = 0; i < Length; i++)
+	{
+		Count = Pointer_Puzzle->Pointer_Coverage_Counts[Cell_Index] + Delta;
+		Pointer_Puzzle->Pointer_Coverage_Counts[Cell_Index] = Count;
+
+		// Only the transitions between covered and not covered change the hidden word
+		if ((Count == 1) && (Delta > 0)) Pointer_Puzzle->Grid.Pointer_Found_Bits[Cell_Index / 64] |= 1ULL << (Cell_Index % 64);
+		else if (Count == 0) Pointer_Puzzle->Grid.Pointer_Found_Bits[Cell_Index / 64] &= ~(1ULL << (Cell_Index % 64));
+		Cell_Index += Cell_Step;
+	}
+}
+
+/** Move a word to a new location, updating the cells coverage and the missing words count.
+ * @param Pointer_Puzzle The puzzle.
+ * @param Word_Index The word.
+ * @param Location_Key The new word location, or -1 if the word can't be found anymore.
+ */
+static void IncrementalSetWordLocation(TIncrementalPuzzle *Pointer_Puzzle, int Word_Index, long long Location_Key)
+{
+	long long Previous_Location_Key = Pointer_Puzzle->Pointer_Location_Keys[Word_Index];
+	int Length = Pointer_Puzzle->Pointer_Lengths[Word_Index];
+
+	if (Location_Key == Previous_Location_Key) return;
+
+	if (Previous_Location_Key >= 0) IncrementalCoverWord(Pointer_Puzzle, Previous_Location_Key, Length, -1);
+	else Pointer_Puzzle->Missing_Words_Count--;
+	if (Location_Key >= 0) IncrementalCoverWord(Pointer_Puzzle, Location_Key, Length, 1);
+	else Pointer_Puzzle->Missing_Words_Count++;
+
+	Pointer_Puzzle->Pointer_Location_Keys[Word_Index] = Location_Key;
+}
+
+/** Find the first location of a word in the whole grid, trying only the cells containing the word first letter.
+ * @param Pointer_Grid The grid.
+ * @param Pointer_String_Word The word.
+ * @param Length The word length.
+ * @return -1 if the word can't be found,
+ * @return The word location key.
+ */
+static long long IncrementalLocateWord(TGrid *Pointer_Grid, char *Pointer_String_Word, int Length)
+{
+	char *Pointer_Letter, *Pointer_End;
+	size_t Cell_Index;
+	int Row, Column, Direction;
+
+	// The letters are stored row after row, so the cells are visited in the scan order
+	Pointer_Letter = Pointer_Grid->Pointer_Letters;
+	Pointer_End = Pointer_Letter + (size_t) Pointer_Grid->Rows_Count * Pointer_Grid->Columns_Count;
+	while ((Pointer_Letter < Pointer_End) && ((Pointer_Letter = memchr(Pointer_Letter, Pointer_String_Word[0], Pointer_End - Pointer_Letter)) != NULL))
+	{
+		Cell_Index = (size_t) (Pointer_Letter - Pointer_Grid->Pointer_Letters);
+		Row = (int) (Cell_Index / Pointer_Grid->Columns_Count);
+		Column = (int) (Cell_Index % Pointer_Grid->Columns_Count);
+		Direction = GridFindWordDirection(Pointer_Grid, Pointer_String_Word, Length, Row, Column);
+		if (Direction >= 0) return GRID_MAKE_LOCATION_KEY(Row, Column, Pointer_Grid->Columns_Count, Direction);
+		Pointer_Letter++;
+	}
+
+	return -1;
+}
+
+/** Find the first location of a word among its occurrences that contain a cell, reading only the grid lines going through the cell.
+ * @param Pointer_Grid The grid.
+ * @param Pointer_String_Word The word.
+ * @param Length The word length.
+ * @param Row The cell row.
+ * @param Column The cell column.
+ * @return -1 if no occurrence of the word contains the cell,
+ * @return The first occurrence location key.
+ */
+static long long IncrementalLocateWordThroughCell(TGrid *Pointer_Grid, char *Pointer_String_Word, int Length, int Row, int Column)
+{
+	int Position, Direction, Row_Step, Column_Step, First_Row, First_Column, Letters_Count, Letters_Step, i;
+	long long Key, Best_Key = -1;
+	char Letter, *Pointer_Letters;
+
+	// The cell can only be one of the word letters that are equal to the cell letter
+	Letter = GRID_GET_LETTER(Pointer_Grid, Row, Column);
+	for (Position = 0; Position < Length; Position++)
+	{
+		if (Pointer_String_Word[Position] != Letter) continue;
+
+		for (Direction = 0; Direction < GRID_DIRECTIONS_COUNT; Direction++)
+		{
+			// Go back to the cell the word would start from
+			GridGetDirectionSteps(Direction, &Row_Step, &Column_Step);
+			First_Row = Row - Position * Row_Step;
+			First_Column = Column - Position * Column_Step;
+			if ((First_Row < 0) || (First_Row >= Pointer_Grid->Rows_Count) || (First_Column < 0) || (First_Column >= Pointer_Grid->Columns_Count)) continue;
+
+			Key = GRID_MAKE_LOCATION_KEY(First_Row, First_Column, Pointer_Grid->Columns_Count, Direction);
+			if ((Best_Key >= 0) && (Key >= Best_Key)) continue;
+
+			Pointer_Letters = GridGetDirectionLetters(Pointer_Grid, Direction, First_Row, First_Column, &Letters_Count, &Letters_Step);
+			if (Letters_Count < Length) continue;
+			for (i = 0; i < Length; i++)
+			{
+				if (Pointer_Letters[i * Letters_Step] != Pointer_String_Word[i]) break;
+			}
+			if (i == Length) Best_Key = Key;
+		}
+	}
+
+	return Best_Key;
+}
+
+/** Tell whether a word location contains a cell.
+ * @param Location_Key The word location.
+ * @param Length The word length.
+ * @param Columns_Count The grid width.
+ * @param Row The cell row.
+ * @param Column The cell column.
+ * @return 1 if the word contains the cell,
+ * @return 0 if it does not.
+ */
+static int IncrementalIsCellInWord(long long Location_Key, int Length, int Columns_Count, int Row, int Column)
+{
+	int First_Row, First_Column, Row_Step, Column_Step, Position;
+
+	First_Row = (int) (Location_Key / GRID_DIRECTIONS_COUNT / Columns_Count);
+	First_Column = (int) (Location_Key / GRID_DIRECTIONS_COUNT % Columns_Count);
+	GridGetDirectionSteps(Location_Key % GRID_DIRECTIONS_COUNT, &Row_Step, &Column_Step);
+
+	// Find the cell position in the word from one coordinate, then check the other one
+	if (Row_Step != 0) Position = (Row - First_Row) * Row_Step;
+	else if (Row != First_Row) return 0;
+	else Position = (Column - First_Column) * Column_Step;
+	if ((Position < 0) || (Position >= Length)) return 0;
+
+	return (First_Row + Position * Row_Step == Row) && (First_Column + Position * Column_Step == Column);
+}
+
+/** Convert a word to uppercase letters, making sure it can be searched.
+ * @param Pointer_String_Word The word to convert.
+ * @param Pointer_String_Converted_Word On output, contain the converted word. The buffer must be CONFIGURATION_WORD_MAXIMUM_STRING_SIZE bytes large.
+ * @return -1 if the word is empty, too long or if it contains other characters than letters,
+ * @return The word length on success.
+ */
+static int IncrementalConvertWord(char *Pointer_String_Word, char *Pointer_String_Converted_Word)
+{
+	int Length = 0;
+	char Character;
+
+	while (*Pointer_String_Word != 0)
+	{
+		if (Length >= CONFIGURATION_WORD_MAXIMUM_STRING_SIZE - 1) return -1;
+
+		Character = *Pointer_String_Word;
+		if ((Character >= 'a') && (Character <= 'z')) Character -= 'a' - 'A';
+		if ((Character < 'A') || (Character > 'Z')) return -1;
+		Pointer_String_Converted_Word[Length] = Character;
+		Length++;
+		Pointer_String_Word++;
+	}
+	Pointer_String_Converted_Word[Length] = 0;
+
+	if (Length == 0) return -1;
+	return Length;
+}
+
+//-------------------------------------------------------------------------------------------------
+// Public functions
+//-------------------------------------------------------------------------------------------------
+void IncrementalInitialize(TIncrementalPuzzle *Pointer_Puzzle)
+{
+	memset(Pointer_Puzzle, 0, sizeof(TIncrementalPuzzle));
+	GridInitialize(&Pointer_Puzzle->Grid);
+	WordTableInitialize(&Pointer_Puzzle->Word_Table);
+}
+
+void IncrementalFree(TIncrementalPuzzle *Pointer_Puzzle)
+{
+	GridFree(&Pointer_Puzzle->Grid);
+	WordTableFree(&Pointer_Puzzle->Word_Table);
+	free(Pointer_Puzzle->Pointer_Words);
+	free(Pointer_Puzzle->Pointer_Lengths);
+	free(Pointer_Puzzle->Pointer_Location_Keys);
+	free(Pointer_Puzzle->Pointer_Coverage_Counts);
+	free(Pointer_Puzzle->Pointer_String_Hidden_Word);
+	memset(Pointer_Puzzle, 0, sizeof(TIncrementalPuzzle));
+}
+
+int IncrementalLoadFromFile(TIncrementalPuzzle *Pointer_Puzzle, char *Pointer_String_File_Name)
+{
+	int Rows_Count, Columns_Count, Words_Count, Word_Index, Length, Return_Value = -1;
+	size_t Cells_Count;
+	int *Pointer_Coverage_Counts;
+	long long *Pointer_Location_Keys = NULL;
+
+	// GridLoadFromFile() clears all found letters
+	Pointer_Puzzle->Words_Count = 0;
+	Pointer_Puzzle->Missing_Words_Count = 0;
+	if (GridLoadFromFile(&Pointer_Puzzle->Grid, Pointer_String_File_Name, &Pointer_Puzzle->Word_Table, &Rows_Count, &Columns_Count, &Words_Count) != 0) return -1;
+	Words_Count = Pointer_Puzzle->Word_Table.Words_Count;
+
+	// Make room for the words and the cells coverage
+	Cells_Count = (size_t) Rows_Count * Columns_Count + 1; // Make sure to never allocate 0 bytes
+	if (Cells_Count > Pointer_Puzzle->Allocated_Coverage_Counts_Count)
+	{
+		Pointer_Coverage_Counts = realloc(Pointer_Puzzle->Pointer_Coverage_Counts, Cells_Count * sizeof(int));
+		if (Pointer_Coverage_Counts == NULL) goto Exit;
+		Pointer_Puzzle->Pointer_Coverage_Counts = Pointer_Coverage_Counts;
+		Pointer_Puzzle->Allocated_Coverage_Counts_Count = Cells_Count;
+	}
+	memset(Pointer_Puzzle->Pointer_Coverage_Counts, 0, Cells_Count * sizeof(int));
+	if (IncrementalReserveWords(Pointer_Puzzle, Words_Count) != 0) goto Exit;
+
+	// Locate all words at once, then keep a copy of them so they can be edited
+	Pointer_Location_Keys = malloc((Words_Count + 1) * sizeof(long long)); // Make sure to never allocate 0 bytes
+	if (Pointer_Location_Keys == NULL) goto Exit;
+	if (AhoCorasickFindWords(&Pointer_Puzzle->Grid, &Pointer_Puzzle->Word_Table, Pointer_Location_Keys) != 0) goto Exit;
+
+	Pointer_Puzzle->Words_Count = Words_Count;
+	Pointer_Puzzle->Missing_Words_Count = Words_Count;
+	for (Word_Index = 0; Word_Index < Words_Count; Word_Index++)
+	{
+		Length = WORD_TABLE_GET_LENGTH(&Pointer_Puzzle->Word_Table, Word_Index);
+		memcpy(&Pointer_Puzzle->Pointer_Words[Word_Index * CONFIGURATION_WORD_MAXIMUM_STRING_SIZE], WORD_TABLE_GET_WORD(&Pointer_Puzzle->Word_Table, Word_Index), Length + 1);
+		Pointer_Puzzle->Pointer_Lengths[Word_Index] = Length;
+		Pointer_Puzzle->Pointer_Location_Keys[Word_Index] = -1;
+		IncrementalSetWordLocation(Pointer_Puzzle, Word_Index, Pointer_Location_Keys[Word_Index]);
+	}
+	Return_Value = 0;
+
+Exit:
+	if (Return_Value != 0) printf("Error : not enough memory to keep the puzzle \"%s\" solved state.\n", Pointer_String_File_Name);
+	free(Pointer_Location_Keys);
+	return Return_Value;
+}
+
+int IncrementalSetLetter(TIncrementalPuzzle *Pointer_Puzzle, int Row, int Column, char Letter)
+{
+	int Word_Index, Length;
+	char *Pointer_String_Word;
+	long long Location_Key, Through_Location_Key;
+	TGrid *Pointer_Grid = &Pointer_Puzzle->Grid;
+
+	// Nothing to search again if the letter does not change
+	if ((Letter >= 'a') && (Letter <= 'z')) Letter -= 'a' - 'A';
+	if ((Row >= 0) && (Row < Pointer_Grid->Rows_Count) && (Column >= 0) && (Column < Pointer_Grid->Columns_Count) && (GRID_GET_LETTER(Pointer_Grid, Row, Column) == Letter)) return 0;
+	if (GridSetLetter(Pointer_Grid, Row, Column, Letter) != 0) return -1;
+
+	for (Word_Index = 0; Word_Index < Pointer_Puzzle->Words_Count; Word_Index++)
+	{
+		Pointer_String_Word = &Pointer_Puzzle->Pointer_Words[Word_Index * CONFIGURATION_WORD_MAXIMUM_STRING_SIZE];
+		Length = Pointer_Puzzle->Pointer_Lengths[Word_Index];
+		Location_Key = Pointer_Puzzle->Pointer_Location_Keys[Word_Index];
+
+		// The word has been broken by the edit, its next occurrence can be anywhere
+		if ((Location_Key >= 0) && IncrementalIsCellInWord(Location_Key, Length, Pointer_Grid->Columns_Count, Row, Column))
+		{
+			IncrementalSetWordLocation(Pointer_Puzzle, Word_Index, IncrementalLocateWord(Pointer_Grid, Pointer_String_Word, Length));
+			continue;
+		}
+
+		// Otherwise the word location is still valid, but the edit may have created an occurrence located before it
+		Through_Location_Key = IncrementalLocateWordThroughCell(Pointer_Grid, Pointer_String_Word, Length, Row, Column);
+		if ((Through_Location_Key >= 0) && ((Location_Key < 0) || (Through_Location_Key < Location_Key))) IncrementalSetWordLocation(Pointer_Puzzle, Word_Index, Through_Location_Key);
+	}
+
+	return 0;
+}
+
+int IncrementalAddWord(TIncrementalPuzzle *Pointer_Puzzle, char *Pointer_String_Word)
+{
+	int Length, Word_Index = Pointer_Puzzle->Words_Count;
+	char String_Word[CONFIGURATION_WORD_MAXIMUM_STRING_SIZE];
+
+	Length = IncrementalConvertWord(Pointer_String_Word, String_Word);
+	if (Length < 0)
+	{
+		printf("Error : the word \"%s\" is too long or it contains other characters than letters.\n", Pointer_String_Word);
+		return -1;
+	}
+	if (IncrementalReserveWords(Pointer_Puzzle, Word_Index + 1) != 0)
+	{
+		printf("Error : not enough memory to add the word \"%s\".\n", Pointer_String_Word);
+		return -1;
+	}
+
+	// The new word is missing until it is located
+	memcpy(&Pointer_Puzzle->Pointer_Words[Word_Index * CONFIGURATION_WORD_MAXIMUM_STRING_SIZE], String_Word, Length + 1);
+	Pointer_Puzzle->Pointer_Lengths[Word_Index] = Length;
+	Pointer_Puzzle->Pointer_Location_Keys[Word_Index] = -1;
+	Pointer_Puzzle->Words_Count++;
+	Pointer_Puzzle->Missing_Words_Count++;
+	IncrementalSetWordLocation(Pointer_Puzzle, Word_Index, IncrementalLocateWord(&Pointer_Puzzle->Grid, String_Word, Length));
+
+	return 0;
+}
+
+int IncrementalRemoveWord(TIncrementalPuzzle *Pointer_Puzzle, char *Pointer_String_Word)
+{
+	int Word_Index, Last_Word_Index;
+	char String_Word[CONFIGURATION_WORD_MAXIMUM_STRING_SIZE];
+
+	if (IncrementalConvertWord(Pointer_String_Word, String_Word) < 0) return -1;
+
+	for (Word_Index = 0; Word_Index < Pointer_Puzzle->Words_Count; Word_Index++)
+	{
+		if (strcmp(&Pointer_Puzzle->Pointer_Words[Word_Index * CONFIGURATION_WORD_MAXIMUM_STRING_SIZE], String_Word) != 0) continue;
+
+		// Release the word cells, then fill the hole with the last word
+		IncrementalSetWordLocation(Pointer_Puzzle, Word_Index, -1);
+		Pointer_Puzzle->Missing_Words_Count--;
+		Last_Word_Index = Pointer_Puzzle->Words_Count - 1;
+		if (Word_Index != Last_Word_Index)
+		{
+			memcpy(&Pointer_Puzzle->Pointer_Words[Word_Index * CONFIGURATION_WORD_MAXIMUM_STRING_SIZE], &Pointer_Puzzle->Pointer_Words[Last_Word_Index * CONFIGURATION_WORD_MAXIMUM_STRING_SIZE], CONFIGURATION_WORD_MAXIMUM_STRING_SIZE);
+			Pointer_Puzzle->Pointer_Lengths[Word_Index] = Pointer_Puzzle->Pointer_Lengths[Last_Word_Index];
+			Pointer_Puzzle->Pointer_Location_Keys[Word_Index] = Pointer_Puzzle->Pointer_Location_Keys[Last_Word_Index];
+		}
+		Pointer_Puzzle->Words_Count--;
+		return 0;
+	}
+
+	return -1;
+}
+
+int IncrementalGetWordLocation(TIncrementalPuzzle *Pointer_Puzzle, int Word_Index, int *Pointer_Row, int *Pointer_Column, TGridDirection *Pointer_Direction)
+{
+	long long Location_Key;
+
+	if ((Word_Index < 0) || (Word_Index >= Pointer_Puzzle->Words_Count)) return -1;
+	Location_Key = Pointer_Puzzle->Pointer_Location_Keys[Word_Index];
+	if (Location_Key < 0) return -1;
+
+	*Pointer_Direction = Location_Key % GRID_DIRECTIONS_COUNT;
+	*Pointer_Row = (int) (Location_Key / GRID_DIRECTIONS_COUNT / Pointer_Puzzle->Grid.Columns_Count);
+	*Pointer_Column = (int) (Location_Key / GRID_DIRECTIONS_COUNT % Pointer_Puzzle->Grid.Columns_Count);
+	return 0;
+}
+
+char *IncrementalGetHiddenWord(TIncrementalPuzzle *Pointer_Puzzle)
+{
+	// The grid found letters always reflect the coverage, so the usual extraction can be used
+	if (GridGetHiddenWord(&Pointer_Puzzle->Grid, &Pointer_Puzzle->Pointer_String_Hidden_Word, &Pointer_Puzzle->Hidden_Word_Buffer_Size) != 0) return NULL;
+	return Pointer_Puzzle->Pointer_String_Hidden_Word;
+}
@@ -0,0 +1,132 @@
+/** @file Letter_Index.c
+ * See Letter_Index.h for description.
+ * @author Adrien RICCIARDI
+ */
+#include <Letter_Index.h>
+#include <stdlib.h>
+#include <string.h>
+
+//-------------------------------------------------------------------------------------------------
+// Private types
+//-------------------------------------------------------------------------------------------------
+/** The grid cells grouped by letter. */
+typedef struct
+{
+	int *Pointer_Cell_Indexes; //!< All grid cell indexes (row * columns count + column), sorted by letter then in the cell-by-cell scan order.
+	int First_Indexes[CONFIGURATION_ALPHABET_LETTERS_COUNT + 1]; //!< Where the cells of each letter begin in the cell indexes array. The last entry is the cells count.
+} TLetterIndex;
+
+//-------------------------------------------------------------------------------------------------
+// Private functions
+//-------------------------------------------------------------------------------------------------
+/** Gather the positions of each letter of the grid.
+ * @param Pointer_Index The index to build.
+ * @param Pointer_Grid The grid to index.
+ * @return -1 if no more heap memory is available,
+ * @return 0 on success.
+ */
+static int LetterIndexBuild(TLetterIndex *Pointer_Index, TGrid *Pointer_Grid)
+{
+	int Cells_Count = Pointer_Grid->Rows_Count * Pointer_Grid->Columns_Count, Next_Indexes[CONFIGURATION_ALPHABET_LETTERS_COUNT], Letter, i;
+
+	Pointer_Index->Pointer_Cell_Indexes = malloc((Cells_Count + 1) * sizeof(int)); // Make sure to never allocate 0 bytes
+	if (Pointer_Index->Pointer_Cell_Indexes == NULL) return -1;
+
+	// The letters histogram gives where each letter cells begin
+	memset(Next_Indexes, 0, sizeof(Next_Indexes));
+	for (i = 0; i < Cells_Count; i++) Next_Indexes[Pointer_Grid->Pointer_Letters[i] - 'A']++;
+	Pointer_Index->First_Indexes[0] = 0;
+	for (Letter = 0; Letter < CONFIGURATION_ALPHABET_LETTERS_COUNT; Letter++)
+	{
+		Pointer_Index->First_Indexes[Letter + 1] = Pointer_Index->First_Indexes[Letter] + Next_Indexes[Letter];
+		Next_Indexes[Letter] = Pointer_Index->First_Indexes[Letter];
+	}
+
+	// Cells are visited in the scan order, so each letter cells stay sorted
+	for (i = 0; i < Cells_Count; i++)
+	{
+		Letter = Pointer_Grid->Pointer_Letters[i] - 'A';
+		Pointer_Index->Pointer_Cell_Indexes[Next_Indexes[Letter]] = i;
+		Next_Indexes[Letter]++;
+	}
+
+	return 0;
+}
+
+//-------------------------------------------------------------------------------------------------
+// Public functions
+//-------------------------------------------------------------------------------------------------
+int LetterIndexFindWords(TGrid *Pointer_Grid, TWordTable *Pointer_Word_Table, long long *Pointer_Location_Keys)
+{
+	TLetterIndex Index;
+	int Word_Index, Words_Count = Pointer_Word_Table->Words_Count, Rows_Count = Pointer_Grid->Rows_Count, Columns_Count = Pointer_Grid->Columns_Count, Length, Anchor, Anchor_Count, Letter_Count, i, j, End_Index, Cell_Index, Anchor_Row, Anchor_Column, Row, Column, Direction, Row_Step, Column_Step, Last_Row, Last_Column, Cell_Step;
+	long long Key, Best_Key;
+	char *Pointer_String_Word, *Pointer_Anchor_Letter;
+
+	if (LetterIndexBuild(&Index, Pointer_Grid) != 0) return -1;
+
+	for (Word_Index = 0; Word_Index < Words_Count; Word_Index++)
+	{
+		Pointer_String_Word = WORD_TABLE_GET_WORD(Pointer_Word_Table, Word_Index);
+		Length = WORD_TABLE_GET_LENGTH(Pointer_Word_Table, Word_Index);
+
+		// Anchor the word on its letter having the less occurrences in the grid
+		Anchor = 0;
+		Anchor_Count = Columns_Count * Rows_Count + 1;
+		for (i = 0; i < Length; i++)
+		{
+			Letter_Count = Index.First_Indexes[Pointer_String_Word[i] - 'A' + 1] - Index.First_Indexes[Pointer_String_Word[i] - 'A'];
+			if (Letter_Count < Anchor_Count)
+			{
+				Anchor = i;
+				Anchor_Count = Letter_Count;
+			}
+		}
+
+		// Try all directions around each anchor letter position, the word starts Anchor letters before it
+		Best_Key = -1;
+		End_Index = Index.First_Indexes[Pointer_String_Word[Anchor] - 'A' + 1];
+		for (j = Index.First_Indexes[Pointer_String_Word[Anchor] - 'A']; j < End_Index; j++)
+		{
+			Cell_Index = Index.Pointer_Cell_Indexes[j];
+
+			// Anchor positions are sorted, so once the earliest possible word start is after the best location, no better location can be found
+			if ((Best_Key >= 0) && ((long long) (Cell_Index - Anchor * (Columns_Count + 1)) * GRID_DIRECTIONS_COUNT > Best_Key)) break;
+
+			Pointer_Anchor_Letter = &Pointer_Grid->Pointer_Letters[Cell_Index];
+			Anchor_Row = Cell_Index / Columns_Count;
+			Anchor_Column = Cell_Index % Columns_Count;
+			for (Direction = 0; Direction < GRID_DIRECTIONS_COUNT; Direction++)
+			{
+				// Make sure the whole word fits in the grid
+				GridGetDirectionSteps(Direction, &Row_Step, &Column_Step);
+				Row = Anchor_Row - Anchor * Row_Step;
+				Column = Anchor_Column - Anchor * Column_Step;
+				Last_Row = Row + (Length - 1) * Row_Step;
+				Last_Column = Column + (Length - 1) * Column_Step;
+				if ((Row < 0) || (Row >= Rows_Count) || (Column < 0) || (Column >= Columns_Count) || (Last_Row < 0) || (Last_Row >= Rows_Count) || (Last_Column < 0) || (Last_Column >= Columns_Count)) continue;
+
+				// Do not compare the letters if this location can't be better than the best one
+				Key = GRID_MAKE_LOCATION_KEY(Row, Column, Columns_Count, Direction);
+				if ((Best_Key >= 0) && (Key >= Best_Key)) continue;
+
+				// Extend the comparison from the anchor to the word end, then to the word beginning
+				Cell_Step = Row_Step * Columns_Count + Column_Step;
+				for (i = Anchor + 1; i < Length; i++)
+				{
+					if (Pointer_Anchor_Letter[(i - Anchor) * Cell_Step] != Pointer_String_Word[i]) break;
+				}
+				if (i < Length) continue;
+				for (i = Anchor - 1; i >= 0; i--)
+				{
+					if (Pointer_Anchor_Letter[(i - Anchor) * Cell_Step] != Pointer_String_Word[i]) break;
+				}
+				if (i < 0) Best_Key = Key;
+			}
+		}
+		Pointer_Location_Keys[Word_Index] = Best_Key;
+	}
+
+	free(Index.Pointer_Cell_Indexes);
+	return 0;
+}
@@ -2,125 +2,824 @@
  * Word search solver entry point.
  * @author Adrien RICCIARDI
  */
-#include <Grid.h>
+#include <Dictionary.h>
+#include <dirent.h>
+#include <Incremental.h>
+#include <Output.h>
+#include <pthread.h>
+#include <Server.h>
+#include <Solver.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <Stream.h>
 #include <string.h>
-#include <Word_List.h>
+#include <sys/stat.h>
+#include <unistd.h>
 
 //-------------------------------------------------------------------------------------------------
-// Private variables
+// Private types
 //-------------------------------------------------------------------------------------------------
-/** Store a list of words to find for each alphabet letter. */
-static TWordList Main_Word_Lists[CONFIGURATION_ALPHABET_LETTERS_COUNT];
+/** A puzzle of a batch and its result. */
+typedef struct
+{
+	char *Pointer_String_File_Name; //!< The puzzle file.
+	int Is_Solved; //!< Set if all words and the hidden word have been found.
+	int Rows_Count; //!< The grid height.
+	int Columns_Count; //!< The grid width.
+	int Words_Count; //!< How many words the puzzle contains.
+	char *Pointer_String_Hidden_Word; //!< A copy of the hidden word, or NULL if the puzzle could not be solved.
+	double Duration; //!< How many seconds the puzzle took to be loaded and solved.
+	char *Pointer_Output; //!< The puzzle result already formatted by the worker, or NULL when the summary line is printed instead.
+	size_t Output_Size; //!< The formatted result size in bytes.
+	TSolverStatistics Statistics; //!< What solving the puzzle cost, when statistics are enabled.
+	int Is_Done; //!< Set when a worker has finished with this puzzle.
+} TMainBatchPuzzle;
+
+/** What is shared by all workers solving a batch of puzzles. */
+typedef struct
+{
+	TMainBatchPuzzle *Pointer_Puzzles; //!< All puzzles to solve.
+	int Puzzles_Count; //!< How many puzzles to solve.
+	int Next_Puzzle_Index; //!< The next puzzle to give to a worker.
+	int Next_Printed_Puzzle_Index; //!< The next puzzle to print the summary of, so summaries are printed in the puzzles order whatever the workers timing.
+	int Solved_Puzzles_Count; //!< How many puzzles have been successfully solved.
+	TSolverStrategy Strategy; //!< How to search the words.
+	TOutput *Pointer_Output; //!< Where to write the formatted results, or NULL to print a summary line per puzzle.
+	int Is_Statistics_Enabled; //!< Set to print the statistics of each puzzle.
+	TCache *Pointer_Cache; //!< The results cache shared by all workers, or NULL.
+	pthread_mutex_t Mutex; //!< Protect all the fields above but the puzzles array.
+} TMainBatch;
 
-/** The loaded grid height. */
-static int Main_Grid_Rows_Count;
-/** The loaded grid width. */
-static int Main_Grid_Columns_Count;
+/** What is needed to print the dictionary words found in a grid. */
+typedef struct
+{
+	TWordTable *Pointer_Word_Table; //!< The dictionary words.
+	TOutput *Pointer_Output; //!< Where to write the occurrences.
+} TMainSweep;
 
 //-------------------------------------------------------------------------------------------------
 // Private functions
 //-------------------------------------------------------------------------------------------------
-/** Solve the grid in the smoothest way and print the hidden word.
- * @param Remaining_Words_Count The amount of words to find.
- * @return -1 if the grid logic is invalid,
+/** Append a puzzle file to a batch.
+ * @param Pointer_Pointer_Puzzles The batch puzzles array, it is reallocated when it is full.
+ * @param Pointer_Puzzles_Count On input, contain how many puzzles the array contains. On output, contain the new puzzles count.
+ * @param Pointer_String_File_Name The puzzle file name, it is copied.
+ * @return -1 if no more heap memory is available,
+ * @return 0 on success.
+ */
+static int MainBatchAddFile(TMainBatchPuzzle **Pointer_Pointer_Puzzles, int *Pointer_Puzzles_Count, const char *Pointer_String_File_Name)
+{
+	TMainBatchPuzzle *Pointer_Puzzles, *Pointer_Puzzle;
+	int Count = *Pointer_Puzzles_Count;
+
+	// Grow the array each time its size reaches a power of two
+	if ((Count & (Count - 1)) == 0)
+	{
+		Pointer_Puzzles = realloc(*Pointer_Pointer_Puzzles, (Count == 0 ? 1 : Count * 2) * sizeof(TMainBatchPuzzle));
+		if (Pointer_Puzzles == NULL) return -1;
+		*Pointer_Pointer_Puzzles = Pointer_Puzzles;
+	}
+
+	Pointer_Puzzle = &(*Pointer_Pointer_Puzzles)[Count];
+	memset(Pointer_Puzzle, 0, sizeof(TMainBatchPuzzle));
+	Pointer_Puzzle->Pointer_String_File_Name = strdup(Pointer_String_File_Name);
+	if (Pointer_Puzzle->Pointer_String_File_Name == NULL) return -1;
+	*Pointer_Puzzles_Count = Count + 1;
+
+	return 0;
+}
+
+/** Sort file names in alphabetical order.
+ * @param Pointer_A The first string pointer to compare.
+ * @param Pointer_B The second string pointer to compare.
+ * @return The strcmp() result.
+ */
+static int MainCompareFileNames(const void *Pointer_A, const void *Pointer_B)
+{
+	return strcmp(*(char * const *) Pointer_A, *(char * const *) Pointer_B);
+}
+
+/** Append all regular files of a directory to a batch, in alphabetical order. Hidden files and subdirectories are ignored.
+ * @param Pointer_Pointer_Puzzles The batch puzzles array, it is reallocated when it is full.
+ * @param Pointer_Puzzles_Count On input, contain how many puzzles the array contains. On output, contain the new puzzles count.
+ * @param Pointer_String_Directory_Name The directory to add the files of.
+ * @return -1 if an error occurred,
+ * @return 0 on success.
+ */
+static int MainBatchAddDirectory(TMainBatchPuzzle **Pointer_Pointer_Puzzles, int *Pointer_Puzzles_Count, const char *Pointer_String_Directory_Name)
+{
+	DIR *Pointer_Directory;
+	struct dirent *Pointer_Entry;
+	struct stat Status;
+	char **Pointer_Pointer_File_Names = NULL, **Pointer_Pointer_Strings, *Pointer_String_Path;
+	int i, File_Names_Count = 0, Return_Value = -1;
+
+	Pointer_Directory = opendir(Pointer_String_Directory_Name);
+	if (Pointer_Directory == NULL)
+	{
+		printf("Error : could not open the directory \"%s\".\n", Pointer_String_Directory_Name);
+		return -1;
+	}
+
+	// Gather the regular files paths
+	while ((Pointer_Entry = readdir(Pointer_Directory)) != NULL)
+	{
+		if (Pointer_Entry->d_name[0] == '.') continue;
+
+		Pointer_String_Path = malloc(strlen(Pointer_String_Directory_Name) + strlen(Pointer_Entry->d_name) + 2);
+		if (Pointer_String_Path == NULL) goto Exit;
+		sprintf(Pointer_String_Path, "%s/%s", Pointer_String_Directory_Name, Pointer_Entry->d_name);
+		if ((stat(Pointer_String_Path, &Status) != 0) || !S_ISREG(Status.st_mode))
+		{
+			free(Pointer_String_Path);
+			continue;
+		}
+
+		Pointer_Pointer_Strings = realloc(Pointer_Pointer_File_Names, (File_Names_Count + 1) * sizeof(char *));
+		if (Pointer_Pointer_Strings == NULL)
+		{
+			free(Pointer_String_Path);
+			goto Exit;
+		}
+		Pointer_Pointer_File_Names = Pointer_Pointer_Strings;
+		Pointer_Pointer_File_Names[File_Names_Count] = Pointer_String_Path;
+		File_Names_Count++;
+	}
+
+	// Add them in a predictable order
+	qsort(Pointer_Pointer_File_Names, File_Names_Count, sizeof(char *), MainCompareFileNames);
+	for (i = 0; i < File_Names_Count; i++)
+	{
+		if (MainBatchAddFile(Pointer_Pointer_Puzzles, Pointer_Puzzles_Count, Pointer_Pointer_File_Names[i]) != 0) goto Exit;
+	}
+	Return_Value = 0;
+
+Exit:
+	if (Return_Value != 0) printf("Error : not enough memory to list the directory \"%s\" files.\n", Pointer_String_Directory_Name);
+	for (i = 0; i < File_Names_Count; i++) free(Pointer_Pointer_File_Names[i]);
+	free(Pointer_Pointer_File_Names);
+	closedir(Pointer_Directory);
+	return Return_Value;
+}
+
+/** Append all puzzle files listed in a text file (one file name per line) to a batch.
+ * @param Pointer_Pointer_Puzzles The batch puzzles array, it is reallocated when it is full.
+ * @param Pointer_Puzzles_Count On input, contain how many puzzles the array contains. On output, contain the new puzzles count.
+ * @param Pointer_String_List_File_Name The file containing the puzzle file names.
+ * @return -1 if an error occurred,
  * @return 0 on success.
  */
-int MainSolveGrid(int Remaining_Words_Count)
+static int MainBatchAddListFile(TMainBatchPuzzle **Pointer_Pointer_Puzzles, int *Pointer_Puzzles_Count, const char *Pointer_String_List_File_Name)
+{
+	FILE *Pointer_File;
+	char *Pointer_String_Line = NULL;
+	size_t Line_Buffer_Size = 0;
+	ssize_t Length;
+	int Return_Value = 0;
+
+	Pointer_File = fopen(Pointer_String_List_File_Name, "r");
+	if (Pointer_File == NULL)
+	{
+		printf("Error : could not open the list file \"%s\".\n", Pointer_String_List_File_Name);
+		return -1;
+	}
+
+	while ((Length = getline(&Pointer_String_Line, &Line_Buffer_Size, Pointer_File)) >= 0)
+	{
+		// Remove the trailing new line characters and ignore empty lines
+		while ((Length > 0) && ((Pointer_String_Line[Length - 1] == '\n') || (Pointer_String_Line[Length - 1] == '\r'))) Length--;
+		if (Length == 0) continue;
+		Pointer_String_Line[Length] = 0;
+
+		if (MainBatchAddFile(Pointer_Pointer_Puzzles, Pointer_Puzzles_Count, Pointer_String_Line) != 0)
+		{
+			printf("Error : not enough memory to store the list file \"%s\" content.\n", Pointer_String_List_File_Name);
+			Return_Value = -1;
+			break;
+		}
+	}
+
+	free(Pointer_String_Line);
+	fclose(Pointer_File);
+	return Return_Value;
+}
+
+/** Print what solving a puzzle cost.
+ * @param Pointer_String_File_Name The puzzle file.
+ * @param Pointer_Statistics The puzzle statistics.
+ */
+static void MainPrintStatistics(char *Pointer_String_File_Name, TSolverStatistics *Pointer_Statistics)
+{
+	TGridSearchCounters *Pointer_Counters = &Pointer_Statistics->Counters;
+
+	printf("Statistics of \"%s\" : %s strategy%s, loading %.3f ms, solving %.3f ms, hidden word %.3f ms, %lld visited cell(s), %lld candidate (word, cell) pair(s), %lld direction(s) rejected by the grid bounds, %lld compared letter(s), %lld match(es).\n", Pointer_String_File_Name, Solver_Strategy_Names[Pointer_Statistics->Strategy], Pointer_Statistics->Is_Cache_Hit ? " (results read from the cache)" : "",
+		Pointer_Statistics->Loading_Duration * 1000.0, Pointer_Statistics->Solving_Duration * 1000.0, Pointer_Statistics->Hidden_Word_Duration * 1000.0, Pointer_Counters->Visited_Cells_Count, Pointer_Counters->Candidate_Pairs_Count, Pointer_Counters->Rejected_Directions_Count, Pointer_Counters->Compared_Letters_Count, Pointer_Counters->Matches_Count);
+}
+
+/** Write a puzzle result and the location of each of its words.
+ * @param Pointer_Output The writer.
+ * @param Pointer_Puzzle The puzzle object the puzzle has been solved with.
+ * @param Pointer_String_File_Name The puzzle file.
+ * @param Is_Solved Set if the puzzle has been solved, the puzzle object content is ignored otherwise.
+ */
+static void MainWritePuzzleResult(TOutput *Pointer_Output, TSolverPuzzle *Pointer_Puzzle, char *Pointer_String_File_Name, int Is_Solved)
 {
-	int Row, Column;
-	char Character;
-	TWordList *Pointer_Word_List;
-	TWordListItem *Pointer_Word_List_Item;
+	int Word_Index, Row, Column;
+	TGridDirection Direction;
+
+	if (!Is_Solved)
+	{
+		OutputBeginPuzzle(Pointer_Output, Pointer_String_File_Name, 0, 0);
+		OutputEndPuzzle(Pointer_Output, 0, NULL);
+		return;
+	}
 
-	// Check each grid character only once
-	for (Row = 0; Row < Main_Grid_Rows_Count; Row++)
+	OutputBeginPuzzle(Pointer_Output, Pointer_String_File_Name, Pointer_Puzzle->Grid.Rows_Count, Pointer_Puzzle->Grid.Columns_Count);
+	for (Word_Index = 0; Word_Index < Pointer_Puzzle->Word_Table.Words_Count; Word_Index++)
 	{
-		for (Column = 0; Column < Main_Grid_Columns_Count; Column++)
+		if (SolverGetWordLocation(Pointer_Puzzle, Word_Index, &Row, &Column, &Direction) != 0) continue;
+		OutputWriteWord(Pointer_Output, WORD_TABLE_GET_WORD(&Pointer_Puzzle->Word_Table, Word_Index), WORD_TABLE_GET_LENGTH(&Pointer_Puzzle->Word_Table, Word_Index), Row, Column, Direction);
+	}
+	OutputEndPuzzle(Pointer_Output, 1, Pointer_Puzzle->Pointer_String_Hidden_Word);
+}
+
+/** Solve batch puzzles until there is no more puzzle to solve, and print the summaries of the puzzles that are done in the batch order.
+ * @param Pointer_Parameters The TMainBatch to solve.
+ * @return Always NULL.
+ */
+static void *MainBatchWorkerThread(void *Pointer_Parameters)
+{
+	TMainBatch *Pointer_Batch = Pointer_Parameters;
+	TMainBatchPuzzle *Pointer_Batch_Puzzle;
+	TSolverPuzzle Puzzle;
+	TOutput Output;
+	int Puzzle_Index, Is_Output_Enabled = 0;
+	double Start_Time;
+
+	// Keep the same puzzle object for all puzzles solved by this worker, so grid and word list memory is allocated only once
+	SolverPuzzleInitialize(&Puzzle, 0);
+	Puzzle.Is_Statistics_Enabled = Pointer_Batch->Is_Statistics_Enabled;
+	Puzzle.Pointer_Cache = Pointer_Batch->Pointer_Cache;
+
+	// Format the results outside of the lock, in a buffer reused for all puzzles of this worker
+	if (Pointer_Batch->Pointer_Output != NULL)
+	{
+		if (OutputInitialize(&Output, -1, Pointer_Batch->Pointer_Output->Format, Pointer_Batch->Pointer_Output->Is_Quiet) != 0)
 		{
-			// Cache the character corresponding to the current location
-			Character = GridGetLetter(Row, Column);
+			printf("Error : not enough memory to format the results.\n");
+			goto Exit;
+		}
+		Is_Output_Enabled = 1;
+	}
 
-			// Determine the word list to use according to the letter value
-			Pointer_Word_List = &Main_Word_Lists[Character - 'A'];
+	while (1)
+	{
+		// Take the next puzzle
+		pthread_mutex_lock(&Pointer_Batch->Mutex);
+		Puzzle_Index = Pointer_Batch->Next_Puzzle_Index;
+		if (Puzzle_Index < Pointer_Batch->Puzzles_Count) Pointer_Batch->Next_Puzzle_Index++;
+		pthread_mutex_unlock(&Pointer_Batch->Mutex);
+		if (Puzzle_Index >= Pointer_Batch->Puzzles_Count) break;
+		Pointer_Batch_Puzzle = &Pointer_Batch->Pointer_Puzzles[Puzzle_Index];
 
-			// Check all possible words
-			Pointer_Word_List_Item = Pointer_Word_List->Pointer_Head_Item;
-			while (Pointer_Word_List_Item != NULL)
+		// Solve it
+		Start_Time = SolverGetTime();
+		if (SolverSolvePuzzle(&Puzzle, Pointer_Batch_Puzzle->Pointer_String_File_Name, Pointer_Batch->Strategy, 1) == 0)
+		{
+			Pointer_Batch_Puzzle->Pointer_String_Hidden_Word = strdup(Puzzle.Pointer_String_Hidden_Word);
+			if (Pointer_Batch_Puzzle->Pointer_String_Hidden_Word != NULL) Pointer_Batch_Puzzle->Is_Solved = 1;
+		}
+		Pointer_Batch_Puzzle->Duration = SolverGetTime() - Start_Time;
+		Pointer_Batch_Puzzle->Rows_Count = Puzzle.Grid.Rows_Count;
+		Pointer_Batch_Puzzle->Columns_Count = Puzzle.Grid.Columns_Count;
+		Pointer_Batch_Puzzle->Words_Count = Puzzle.Words_Count;
+		Pointer_Batch_Puzzle->Statistics = Puzzle.Statistics;
+		if (Is_Output_Enabled)
+		{
+			MainWritePuzzleResult(&Output, &Puzzle, Pointer_Batch_Puzzle->Pointer_String_File_Name, Pointer_Batch_Puzzle->Is_Solved);
+			Pointer_Batch_Puzzle->Pointer_Output = OutputDetachBuffer(&Output, &Pointer_Batch_Puzzle->Output_Size);
+			if (Pointer_Batch_Puzzle->Pointer_Output == NULL) printf("Error : not enough memory to format the puzzle \"%s\" results.\n", Pointer_Batch_Puzzle->Pointer_String_File_Name);
+		}
+
+		// Print all summaries that can be printed in order
+		pthread_mutex_lock(&Pointer_Batch->Mutex);
+		Pointer_Batch_Puzzle->Is_Done = 1;
+		if (Pointer_Batch_Puzzle->Is_Solved) Pointer_Batch->Solved_Puzzles_Count++;
+		while ((Pointer_Batch->Next_Printed_Puzzle_Index < Pointer_Batch->Puzzles_Count) && Pointer_Batch->Pointer_Puzzles[Pointer_Batch->Next_Printed_Puzzle_Index].Is_Done)
+		{
+			Pointer_Batch_Puzzle = &Pointer_Batch->Pointer_Puzzles[Pointer_Batch->Next_Printed_Puzzle_Index];
+			if (Pointer_Batch->Pointer_Output != NULL)
 			{
-				if (GridMatchWordWithPosition(Pointer_Word_List_Item->String_Word, Row, Column) == 0)
-				{
-					Remaining_Words_Count--;
-					printf("Found word \"%s\" at row %d and column %d (%d word(s) remaining to be found).\n", Pointer_Word_List_Item->String_Word, Row + 1, Column + 1, Remaining_Words_Count);
-					Pointer_Word_List_Item = WordListRemove(Pointer_Word_List, Pointer_Word_List_Item); // The function returns the item following the one that has been deleted
-				}
-				// Proceed to next word
-				else Pointer_Word_List_Item = Pointer_Word_List_Item->Pointer_Next_Item;
+				if (Pointer_Batch_Puzzle->Pointer_Output != NULL) OutputWriteBytes(Pointer_Batch->Pointer_Output, Pointer_Batch_Puzzle->Pointer_Output, Pointer_Batch_Puzzle->Output_Size);
 			}
+			else if (Pointer_Batch_Puzzle->Is_Solved) printf("%s : solved, %dx%d grid, %d words, hidden word \"%s\", %.3f ms.\n", Pointer_Batch_Puzzle->Pointer_String_File_Name, Pointer_Batch_Puzzle->Columns_Count, Pointer_Batch_Puzzle->Rows_Count, Pointer_Batch_Puzzle->Words_Count, Pointer_Batch_Puzzle->Pointer_String_Hidden_Word, Pointer_Batch_Puzzle->Duration * 1000.0);
+			else printf("%s : failed, %.3f ms.\n", Pointer_Batch_Puzzle->Pointer_String_File_Name, Pointer_Batch_Puzzle->Duration * 1000.0);
+			if (Pointer_Batch->Is_Statistics_Enabled) MainPrintStatistics(Pointer_Batch_Puzzle->Pointer_String_File_Name, &Pointer_Batch_Puzzle->Statistics);
+
+			// The result is not needed anymore
+			free(Pointer_Batch_Puzzle->Pointer_String_Hidden_Word);
+			Pointer_Batch_Puzzle->Pointer_String_Hidden_Word = NULL;
+			free(Pointer_Batch_Puzzle->Pointer_Output);
+			Pointer_Batch_Puzzle->Pointer_Output = NULL;
+			Pointer_Batch->Next_Printed_Puzzle_Index++;
+		}
+		pthread_mutex_unlock(&Pointer_Batch->Mutex);
+	}
+
+Exit:
+	if (Is_Output_Enabled) OutputFree(&Output);
+	SolverPuzzleFree(&Puzzle);
+	return NULL;
+}
+
+/** Solve many puzzles with a pool of worker threads, then print statistics.
+ * @param Pointer_Puzzles The puzzles to solve.
+ * @param Puzzles_Count How many puzzles to solve.
+ * @param Strategy How to search the words.
+ * @param Workers_Count How many puzzles can be solved at the same time.
+ * @param Pointer_Output Where to write the formatted results, or NULL to print a summary line per puzzle.
+ * @param Is_Statistics_Enabled Set to print the statistics of each puzzle.
+ * @param Pointer_Cache The results cache, or NULL.
+ * @return -1 if a puzzle could not be solved,
+ * @return 0 if all puzzles have been solved.
+ */
+static int MainSolveBatch(TMainBatchPuzzle *Pointer_Puzzles, int Puzzles_Count, TSolverStrategy Strategy, int Workers_Count, TOutput *Pointer_Output, int Is_Statistics_Enabled, TCache *Pointer_Cache)
+{
+	TMainBatch Batch;
+	pthread_t *Pointer_Threads;
+	int i, Started_Threads_Count = 0;
+	double Start_Time, Duration;
+
+	Batch.Pointer_Puzzles = Pointer_Puzzles;
+	Batch.Puzzles_Count = Puzzles_Count;
+	Batch.Next_Puzzle_Index = 0;
+	Batch.Next_Printed_Puzzle_Index = 0;
+	Batch.Solved_Puzzles_Count = 0;
+	Batch.Strategy = Strategy;
+	Batch.Pointer_Output = Pointer_Output;
+	Batch.Is_Statistics_Enabled = Is_Statistics_Enabled;
+	Batch.Pointer_Cache = Pointer_Cache;
+	pthread_mutex_init(&Batch.Mutex, NULL);
+
+	// Do not create workers that would have nothing to do
+	if (Workers_Count > Puzzles_Count) Workers_Count = Puzzles_Count;
+	Pointer_Threads = malloc((Workers_Count + 1) * sizeof(pthread_t)); // Make sure to never allocate 0 bytes
+	if (Pointer_Threads == NULL)
+	{
+		printf("Error : not enough memory to start the workers.\n");
+		return -1;
+	}
+
+	// Start the workers, the current thread waits for them so that the batch is processed even if some threads could not be created
+	Start_Time = SolverGetTime();
+	for (i = 0; i < Workers_Count; i++)
+	{
+		if (pthread_create(&Pointer_Threads[i], NULL, MainBatchWorkerThread, &Batch) != 0)
+		{
+			printf("Error : failed to start a worker thread.\n");
+			break;
 		}
+		Started_Threads_Count++;
 	}
+	if (Started_Threads_Count == 0) MainBatchWorkerThread(&Batch);
+	for (i = 0; i < Started_Threads_Count; i++) pthread_join(Pointer_Threads[i], NULL);
+	Duration = SolverGetTime() - Start_Time;
+
+	printf("Solved %d of %d puzzle(s) in %.3f s (%.1f puzzles per second).\n", Batch.Solved_Puzzles_Count, Puzzles_Count, Duration, Duration > 0 ? Puzzles_Count / Duration : 0.0);
 
+	free(Pointer_Threads);
+	pthread_mutex_destroy(&Batch.Mutex);
+	if (Batch.Solved_Puzzles_Count != Puzzles_Count) return -1;
 	return 0;
 }
 
+/** Report a dictionary word occurrence.
+ * @param Pointer_Parameters The TMainSweep the occurrence belongs to.
+ * @param Word_Index The word index in the dictionary.
+ * @param Row The word first letter row.
+ * @param Column The word first letter column.
+ * @param Direction The direction the word is written to.
+ */
+static void MainPrintOccurrence(void *Pointer_Parameters, int Word_Index, int Row, int Column, TGridDirection Direction)
+{
+	TMainSweep *Pointer_Sweep = Pointer_Parameters;
+
+	OutputWriteWord(Pointer_Sweep->Pointer_Output, WORD_TABLE_GET_WORD(Pointer_Sweep->Pointer_Word_Table, Word_Index), WORD_TABLE_GET_LENGTH(Pointer_Sweep->Pointer_Word_Table, Word_Index), Row, Column, Direction);
+}
+
+/** Report every occurrence of every dictionary word in the grids of the provided puzzles. The puzzles words are ignored.
+ * @param Pointer_Puzzles The puzzles to sweep.
+ * @param Puzzles_Count How many puzzles to sweep.
+ * @param Pointer_String_Dictionary_File_Name The dictionary file, it is loaded only once for all puzzles.
+ * @param Pointer_Output Where to write the occurrences.
+ * @return -1 if a puzzle or the dictionary could not be loaded,
+ * @return 0 on success.
+ */
+static int MainSweepPuzzles(TMainBatchPuzzle *Pointer_Puzzles, int Puzzles_Count, char *Pointer_String_Dictionary_File_Name, TOutput *Pointer_Output)
+{
+	TDictionary Dictionary;
+	TSolverPuzzle Puzzle;
+	TMainSweep Sweep;
+	int i, Rows_Count, Columns_Count, Return_Value = -1;
+
+	SolverPuzzleInitialize(&Puzzle, 0);
+	if (DictionaryLoad(&Dictionary, Pointer_String_Dictionary_File_Name) != 0) goto Exit;
+	if (Dictionary.Skipped_Words_Count > 0) printf("Ignored %d dictionary word(s) that are too long or that contain other characters than letters.\n", Dictionary.Skipped_Words_Count);
+	Sweep.Pointer_Word_Table = &Dictionary.Word_Table;
+	Sweep.Pointer_Output = Pointer_Output;
+
+	for (i = 0; i < Puzzles_Count; i++)
+	{
+		if (GridLoadFromFile(&Puzzle.Grid, Pointer_Puzzles[i].Pointer_String_File_Name, &Puzzle.Word_Table, &Rows_Count, &Columns_Count, &Puzzle.Words_Count) != 0)
+		{
+			OutputFlush(Pointer_Output); // Keep the error after the previous grids results
+			printf("Error : could not load the grid of the file \"%s\".\n", Pointer_Puzzles[i].Pointer_String_File_Name);
+			goto Exit;
+		}
+
+		OutputBeginPuzzle(Pointer_Output, Pointer_Puzzles[i].Pointer_String_File_Name, Rows_Count, Columns_Count);
+		DictionarySweepGrid(&Dictionary, &Puzzle.Grid, MainPrintOccurrence, &Sweep);
+		OutputEndPuzzle(Pointer_Output, 1, NULL);
+	}
+	Return_Value = 0;
+
+Exit:
+	DictionaryFree(&Dictionary);
+	SolverPuzzleFree(&Puzzle);
+	return Return_Value;
+}
+
+/** Print whether an edited puzzle is valid and its current hidden word.
+ * @param Pointer_Puzzle The edited puzzle.
+ * @return -1 if no more heap memory is available,
+ * @return 0 on success.
+ */
+static int MainPrintEditedPuzzleState(TIncrementalPuzzle *Pointer_Puzzle)
+{
+	char *Pointer_String_Hidden_Word;
+
+	Pointer_String_Hidden_Word = IncrementalGetHiddenWord(Pointer_Puzzle);
+	if (Pointer_String_Hidden_Word == NULL)
+	{
+		printf("Error : not enough memory to store the hidden word.\n");
+		return -1;
+	}
+
+	if (Pointer_Puzzle->Missing_Words_Count == 0) printf("Valid puzzle, hidden word : \"%s\".\n", Pointer_String_Hidden_Word);
+	else printf("Invalid puzzle, %d word(s) can't be found, hidden word : \"%s\".\n", Pointer_Puzzle->Missing_Words_Count, Pointer_String_Hidden_Word);
+	return 0;
+}
+
+/** Load a puzzle, then apply the edit commands read from the standard input, printing the puzzle state after each command. Commands are "letter Row Column Letter" (rows and columns start from 1), "add Word" and "remove Word".
+ * @param Pointer_String_File_Name The puzzle file.
+ * @return -1 if the puzzle could not be loaded,
+ * @return 0 when the end of the standard input has been reached.
+ */
+static int MainEditPuzzle(char *Pointer_String_File_Name)
+{
+	TIncrementalPuzzle Puzzle;
+	char *Pointer_String_Line = NULL, String_Word[CONFIGURATION_WORD_MAXIMUM_STRING_SIZE * 2], String_Add_Format[32], String_Remove_Format[32], Letter;
+	size_t Line_Buffer_Size = 0;
+	int Row, Column, Return_Value = -1;
+
+	// Read at most as many word characters as the word buffer can store, the buffer being bigger than the longest word so too long words are detected
+	snprintf(String_Add_Format, sizeof(String_Add_Format), "add %%%ds", (int) sizeof(String_Word) - 1);
+	snprintf(String_Remove_Format, sizeof(String_Remove_Format), "remove %%%ds", (int) sizeof(String_Word) - 1);
+
+	IncrementalInitialize(&Puzzle);
+	if (IncrementalLoadFromFile(&Puzzle, Pointer_String_File_Name) != 0) goto Exit;
+	if (MainPrintEditedPuzzleState(&Puzzle) != 0) goto Exit;
+
+	while (getline(&Pointer_String_Line, &Line_Buffer_Size, stdin) >= 0)
+	{
+		if (sscanf(Pointer_String_Line, "letter %d %d %c", &Row, &Column, &Letter) == 3)
+		{
+			if (IncrementalSetLetter(&Puzzle, Row - 1, Column - 1, Letter) != 0) continue;
+		}
+		else if (sscanf(Pointer_String_Line, String_Add_Format, String_Word) == 1)
+		{
+			if (IncrementalAddWord(&Puzzle, String_Word) != 0) continue;
+		}
+		else if (sscanf(Pointer_String_Line, String_Remove_Format, String_Word) == 1)
+		{
+			if (IncrementalRemoveWord(&Puzzle, String_Word) != 0)
+			{
+				printf("Error : the puzzle does not contain the word \"%s\".\n", String_Word);
+				continue;
+			}
+		}
+		else
+		{
+			// Ignore empty lines
+			if (strspn(Pointer_String_Line, " \t\r\n") != strlen(Pointer_String_Line)) printf("Error : unknown edit command.\n");
+			continue;
+		}
+
+		if (MainPrintEditedPuzzleState(&Puzzle) != 0) goto Exit;
+		fflush(stdout); // Answer each command right away when the commands come from another program
+	}
+	Return_Value = 0;
+
+Exit:
+	free(Pointer_String_Line);
+	IncrementalFree(&Puzzle);
+	return Return_Value;
+}
+
+/** Retrieve the value of a command line option provided either as "--name=value" or as "--name value".
+ * @param argc The command line arguments count.
+ * @param argv The command line arguments.
+ * @param Pointer_Argument_Index On input, contain the index of the argument to parse. On output, contain the index of the last argument consumed by the option.
+ * @param Pointer_String_Option_Name The option name, including the leading dashes.
+ * @return NULL if the argument is not this option (or if the option value is missing),
+ * @return The option value.
+ */
+static char *MainGetOptionValue(int argc, char *argv[], int *Pointer_Argument_Index, const char *Pointer_String_Option_Name)
+{
+	char *Pointer_String_Argument = argv[*Pointer_Argument_Index];
+	size_t Length;
+
+	Length = strlen(Pointer_String_Option_Name);
+	if (strncmp(Pointer_String_Argument, Pointer_String_Option_Name, Length) != 0) return NULL;
+
+	// "--name=value" form
+	if (Pointer_String_Argument[Length] == '=') return &Pointer_String_Argument[Length + 1];
+
+	// "--name value" form
+	if ((Pointer_String_Argument[Length] == 0) && (*Pointer_Argument_Index + 1 < argc))
+	{
+		(*Pointer_Argument_Index)++;
+		return argv[*Pointer_Argument_Index];
+	}
+
+	return NULL;
+}
+
 //-------------------------------------------------------------------------------------------------
 // Entry point
 //-------------------------------------------------------------------------------------------------
 int main(int argc, char *argv[])
 {
-	int i, Words_Count;
-	char String_Hidden_Word[CONFIGURATION_HIDDEN_WORD_MAXIMUM_STRING_SIZE];
-
-	// Display banner
-	printf("+--------------------------------+\n"
-		"|       Word search solver       |\n"
-		"| (C) 2021-2024 Adrien RICCIARDI |\n"
-		"+--------------------------------+\n");
+	int i, Threads_Count = 1, Is_Batch_Mode_Enabled = 0, Is_Server_Mode_Enabled = 0, Is_Edit_Mode_Enabled = 0, Is_Stream_Mode_Enabled = 0, Band_Rows_Count = CONFIGURATION_STREAM_BAND_ROWS_COUNT, Is_Quiet = 0, Is_Statistics_Enabled = 0, Puzzles_Count = 0, Output_File_Descriptor = STDOUT_FILENO, Cache_Size = CONFIGURATION_CACHE_MAXIMUM_SIZE, Return_Value;
+	char *Pointer_String_Option_Value, *Pointer_String_Socket_Path = NULL, *Pointer_String_Dictionary_File_Name = NULL, *Pointer_String_Cache_Directory_Name = NULL;
+	TSolverStrategy Strategy = SOLVER_STRATEGY_AUTO;
+	TOutputFormat Format = OUTPUT_FORMAT_TEXT;
+	TMainBatchPuzzle *Pointer_Puzzles = NULL;
+	TSolverPuzzle Puzzle;
+	TOutput Output;
+	TCache Cache, *Pointer_Cache = NULL;
+	struct stat Status;
 
 	// Check arguments
-	if (argc != 2)
+	for (i = 1; i < argc; i++)
 	{
-		printf("Usage : %s Word_Search_File\n"
-			"Word search file format consists of the grid content, followed by the separating character '-', then followed by the list of the words to search (one per line).\n"
-			"Only ASCII letters (from A to Z), both uppercase of lowercase, are accepted.\n"
-			"See test files in the Tests directory for examples.\n", argv[0]);
-		return EXIT_FAILURE;
+		// Is a strategy specified ?
+		if ((Pointer_String_Option_Value = MainGetOptionValue(argc, argv, &i, "--strategy")) != NULL)
+		{
+			for (Strategy = 0; Strategy < SOLVER_STRATEGIES_COUNT; Strategy++)
+			{
+				if (strcmp(Pointer_String_Option_Value, Solver_Strategy_Names[Strategy]) == 0) break;
+			}
+			if (Strategy == SOLVER_STRATEGIES_COUNT)
+			{
+				printf("Error : unknown strategy \"%s\".\n", Pointer_String_Option_Value);
+				return EXIT_FAILURE;
+			}
+		}
+		// Is a threads count specified ?
+		else if ((Pointer_String_Option_Value = MainGetOptionValue(argc, argv, &i, "--threads")) != NULL)
+		{
+			Threads_Count = atoi(Pointer_String_Option_Value);
+			if (Threads_Count < 1)
+			{
+				printf("Error : the threads count must be a positive number.\n");
+				return EXIT_FAILURE;
+			}
+		}
+		// Is an output format specified ?
+		else if ((Pointer_String_Option_Value = MainGetOptionValue(argc, argv, &i, "--format")) != NULL)
+		{
+			for (Format = 0; Format < OUTPUT_FORMATS_COUNT; Format++)
+			{
+				if (strcmp(Pointer_String_Option_Value, Output_Format_Names[Format]) == 0) break;
+			}
+			if (Format == OUTPUT_FORMATS_COUNT)
+			{
+				printf("Error : unknown output format \"%s\".\n", Pointer_String_Option_Value);
+				return EXIT_FAILURE;
+			}
+		}
+		// Report only the results ?
+		else if (strcmp(argv[i], "--quiet") == 0) Is_Quiet = 1;
+		// Measure the solving phases ?
+		else if (strcmp(argv[i], "--stats") == 0) Is_Statistics_Enabled = 1;
+		// Solve many puzzles ?
+		else if (strcmp(argv[i], "--batch") == 0) Is_Batch_Mode_Enabled = 1;
+		// Find all dictionary words instead of the puzzles words ?
+		else if ((Pointer_String_Option_Value = MainGetOptionValue(argc, argv, &i, "--dictionary")) != NULL) Pointer_String_Dictionary_File_Name = Pointer_String_Option_Value;
+		// Solve the puzzles received on the standard input ?
+		else if (strcmp(argv[i], "--server") == 0) Is_Server_Mode_Enabled = 1;
+		// Edit a puzzle with the commands received on the standard input ?
+		else if (strcmp(argv[i], "--edit") == 0) Is_Edit_Mode_Enabled = 1;
+		// Keep the results of the solved puzzles ?
+		else if ((Pointer_String_Option_Value = MainGetOptionValue(argc, argv, &i, "--cache")) != NULL) Pointer_String_Cache_Directory_Name = Pointer_String_Option_Value;
+		// Is the cache size specified ?
+		else if ((Pointer_String_Option_Value = MainGetOptionValue(argc, argv, &i, "--cache-size")) != NULL)
+		{
+			Cache_Size = atoi(Pointer_String_Option_Value);
+			if (Cache_Size < 1)
+			{
+				printf("Error : the cache size must be a positive number of mebibytes.\n");
+				return EXIT_FAILURE;
+			}
+		}
+		// Read the grid band by band ?
+		else if (strcmp(argv[i], "--stream") == 0) Is_Stream_Mode_Enabled = 1;
+		// Is a band height specified ?
+		else if ((Pointer_String_Option_Value = MainGetOptionValue(argc, argv, &i, "--band-rows")) != NULL)
+		{
+			Band_Rows_Count = atoi(Pointer_String_Option_Value);
+			if ((Band_Rows_Count < 1) || (Band_Rows_Count > CONFIGURATION_GRID_MAXIMUM_SIZE / 2))
+			{
+				printf("Error : the band rows count must be in range 1 to %d.\n", CONFIGURATION_GRID_MAXIMUM_SIZE / 2);
+				return EXIT_FAILURE;
+			}
+		}
+		// Solve the puzzles received on a socket ?
+		else if ((Pointer_String_Option_Value = MainGetOptionValue(argc, argv, &i, "--socket")) != NULL) Pointer_String_Socket_Path = Pointer_String_Option_Value;
+		// Is a list of puzzle files provided ?
+		else if ((Pointer_String_Option_Value = MainGetOptionValue(argc, argv, &i, "--list")) != NULL)
+		{
+			Is_Batch_Mode_Enabled = 1;
+			if (MainBatchAddListFile(&Pointer_Puzzles, &Puzzles_Count, Pointer_String_Option_Value) != 0) return EXIT_FAILURE;
+		}
+		// This is a puzzle file or a directory of puzzle files
+		else if ((stat(argv[i], &Status) == 0) && S_ISDIR(Status.st_mode))
+		{
+			Is_Batch_Mode_Enabled = 1;
+			if (MainBatchAddDirectory(&Pointer_Puzzles, &Puzzles_Count, argv[i]) != 0) return EXIT_FAILURE;
+		}
+		else if (MainBatchAddFile(&Pointer_Puzzles, &Puzzles_Count, argv[i]) != 0)
+		{
+			printf("Error : not enough memory to store the command line.\n");
+			return EXIT_FAILURE;
+		}
 	}
+	if (Puzzles_Count > 1) Is_Batch_Mode_Enabled = 1;
 
-	// Try to load the specified file
-	printf("Trying to solve the file \"%s\".\n", argv[1]);
-	if (GridLoadFromFile(argv[1], Main_Word_Lists, &Main_Grid_Rows_Count, &Main_Grid_Columns_Count, &Words_Count) != 0)
+	// The cache is shared by all puzzles, and by all processes using the same directory. Only the solving, batch and server modes store results
+	if (Pointer_String_Cache_Directory_Name != NULL)
 	{
-		printf("The specified file \"%s\" is invalid\n.", argv[1]);
-		return EXIT_FAILURE;
+		if (Is_Edit_Mode_Enabled || Is_Stream_Mode_Enabled || (Pointer_String_Dictionary_File_Name != NULL))
+		{
+			printf("Error : the --cache option is not supported in edit, stream and dictionary sweep modes.\n");
+			return EXIT_FAILURE;
+		}
+		if (CacheInitialize(&Cache, Pointer_String_Cache_Directory_Name, (long long) Cache_Size * 1024 * 1024) != 0) return EXIT_FAILURE;
+		Pointer_Cache = &Cache;
 	}
 
-	// Try to find all searched words and the hidden word
-	if (MainSolveGrid(Words_Count) != 0)
+	// Keep a single puzzle solved while it is edited
+	if (Is_Edit_Mode_Enabled && (Puzzles_Count == 1))
 	{
-		printf("Error : this grid is invalid, no solution could be found.\n");
-		return EXIT_FAILURE;
+		Return_Value = MainEditPuzzle(Pointer_Puzzles[0].Pointer_String_File_Name);
+		free(Pointer_Puzzles[0].Pointer_String_File_Name);
+		free(Pointer_Puzzles);
+		if (Return_Value != 0) return EXIT_FAILURE;
+		return EXIT_SUCCESS;
 	}
 
-	// Make sure all words have been found
-	for (i = 0; i < CONFIGURATION_ALPHABET_LETTERS_COUNT; i++)
+	// Stream a single puzzle grid whose size is not bounded by the memory, only the text results are supported
+	if (Is_Stream_Mode_Enabled && (Puzzles_Count == 1))
 	{
-		if (Main_Word_Lists[i].Size > 0)
+		if (Format != OUTPUT_FORMAT_TEXT)
+		{
+			printf("Error : only the text format is supported when solving a grid band by band.\n");
+			Return_Value = -1;
+		}
+		else
 		{
-			printf("Error : some words were not found in the grid, the grid seems to be invalid.\n");
+			if (!Is_Quiet) printf("+--------------------------------+\n"
+				"|       Word search solver       |\n"
+				"| (C) 2021-2024 Adrien RICCIARDI |\n"
+				"+--------------------------------+\n");
+			Return_Value = StreamSolvePuzzle(Pointer_Puzzles[0].Pointer_String_File_Name, Band_Rows_Count, !Is_Quiet);
+			if ((Return_Value != 0) && Is_Quiet) printf("Error : the puzzle \"%s\" could not be solved.\n", Pointer_Puzzles[0].Pointer_String_File_Name);
+		}
+		free(Pointer_Puzzles[0].Pointer_String_File_Name);
+		free(Pointer_Puzzles);
+		if (Return_Value != 0) return EXIT_FAILURE;
+		return EXIT_SUCCESS;
+	}
+
+	// Write the results through a single buffer. Machine-readable formats own the standard output, all other messages are redirected to the standard error so they can't corrupt the results
+	if (Puzzles_Count > 0)
+	{
+		if (Format != OUTPUT_FORMAT_TEXT)
+		{
+			fflush(stdout);
+			Output_File_Descriptor = dup(STDOUT_FILENO);
+			if ((Output_File_Descriptor < 0) || (dup2(STDERR_FILENO, STDOUT_FILENO) < 0))
+			{
+				printf("Error : could not redirect the standard output.\n");
+				return EXIT_FAILURE;
+			}
+		}
+		if (OutputInitialize(&Output, Output_File_Descriptor, Format, Is_Quiet) != 0)
+		{
+			printf("Error : not enough memory to format the results.\n");
 			return EXIT_FAILURE;
 		}
 	}
 
-	// Try to display the hidden word
-	if (GridGetHiddenWord(String_Hidden_Word) != 0)
+	// Sweep the grids with the dictionary words, the output only contains the found words
+	if ((Pointer_String_Dictionary_File_Name != NULL) && (Puzzles_Count > 0))
+	{
+		Return_Value = MainSweepPuzzles(Pointer_Puzzles, Puzzles_Count, Pointer_String_Dictionary_File_Name, &Output);
+		for (i = 0; i < Puzzles_Count; i++) free(Pointer_Puzzles[i].Pointer_String_File_Name);
+		free(Pointer_Puzzles);
+		if ((OutputFree(&Output) != 0) || (Return_Value != 0)) return EXIT_FAILURE;
+		return EXIT_SUCCESS;
+	}
+
+	// Keep the process resident in server mode, the output only contains the responses
+	if ((Is_Server_Mode_Enabled || (Pointer_String_Socket_Path != NULL)) && (Puzzles_Count == 0))
+	{
+		if (Pointer_String_Socket_Path != NULL) Return_Value = ServerServeSocket(Pointer_String_Socket_Path, Strategy, Threads_Count, Pointer_Cache);
+		else Return_Value = ServerServeStandardInput(Strategy, Threads_Count, Pointer_Cache);
+		if (Pointer_Cache != NULL) CacheFree(Pointer_Cache);
+		if (Return_Value != 0) return EXIT_FAILURE;
+		return EXIT_SUCCESS;
+	}
+
+	// Solve all puzzles without any decoration in batch mode, the whole output is a summary line per puzzle (or the formatted results of each puzzle)
+	if (Is_Batch_Mode_Enabled)
+	{
+		Return_Value = MainSolveBatch(Pointer_Puzzles, Puzzles_Count, Strategy, Threads_Count, Format == OUTPUT_FORMAT_TEXT ? NULL : &Output, Is_Statistics_Enabled, Pointer_Cache);
+		for (i = 0; i < Puzzles_Count; i++) free(Pointer_Puzzles[i].Pointer_String_File_Name);
+		free(Pointer_Puzzles);
+		if (Pointer_Cache != NULL) CacheFree(Pointer_Cache);
+		if ((OutputFree(&Output) != 0) || (Return_Value != 0)) return EXIT_FAILURE;
+		return EXIT_SUCCESS;
+	}
+
+	// Display banner, unless only the results are wanted
+	if ((Puzzles_Count != 1) || ((Format == OUTPUT_FORMAT_TEXT) && !Is_Quiet)) printf("+--------------------------------+\n"
+		"|       Word search solver       |\n"
+		"| (C) 2021-2024 Adrien RICCIARDI |\n"
+		"+--------------------------------+\n");
+
+	if (Puzzles_Count != 1)
 	{
-		printf("Error : the hidden word is too long, the grid seems to be invalid.\n");
+		printf("Usage : %s [--strategy=scan|aho-corasick|trie|rabin-karp|letter-index|shift-and|auto] [--threads N] [--format=text|json|tsv|binary] [--quiet] [--stats] Word_Search_File\n"
+			"        %s [--strategy=scan|aho-corasick|trie|rabin-karp|letter-index|shift-and|auto] [--threads N] [--format=text|json|tsv|binary] [--quiet] [--stats] [--batch] [--list List_File] Word_Search_Files_Or_Directories...\n"
+			"        %s [--strategy=scan|aho-corasick|trie|rabin-karp|letter-index|shift-and|auto] [--threads N] --server|--socket Socket_File\n"
+			"        %s [--format=text|json|tsv|binary] [--quiet] --dictionary Dictionary_File Word_Search_Files_Or_Directories...\n"
+			"        %s --edit Word_Search_File\n"
+			"        %s [--quiet] --stream [--band-rows N] Word_Search_File\n"
+			"The --cache Directory [--cache-size Mebibytes] options can be added to the solving, batch and server modes.\n"
+			"Word search file format consists of the grid content, followed by the separating character '-', then followed by the list of the words to search (one per line).\n"
+			"Only ASCII letters (from A to Z), both uppercase of lowercase, are accepted.\n"
+			"See test files in the Tests directory for examples.\n"
+			"The auto strategy (the default one) estimates the cost of each strategy from the grid size, the words count and lengths and the grid letters frequencies, then uses the cheapest one. The scan strategy tries each word on every cell starting with the word first letter, the aho-corasick strategy reads each grid line only once to find all words at the same time (it is faster on big grids or long word lists), the trie strategy walks the grid and a prefix tree of the words together (it is faster when many words share prefixes), the rabin-karp strategy slides a rolling hash of each word length along the grid lines (its speed depends on the amount of distinct word lengths, not on the amount of words), the letter-index strategy tries each word only around the grid positions of its rarest letter (it is faster when the grid letters frequencies are skewed), the shift-and strategy advances all words packed in 64-bit masks with a few bitwise operations per grid letter.\n"
+			"The --threads option splits the grid in as many row bands searched in parallel by the scan strategy, the auto strategy uses them only when it chooses the scan.\n"
+			"Batch mode is enabled when several files, a directory, a list file (containing a file name per line) or the --batch option are provided. All puzzles are solved by the same process, --threads tells how many puzzles are solved at the same time, and a summary line is printed per puzzle.\n"
+			"Server mode keeps the process running and solves the puzzles received on the standard input (--server) or on the connections to a Unix domain socket (--socket). Each puzzle is sent as a puzzle file content followed by an empty line, each response is a \"solved HIDDEN_WORD\" or \"failed\" line followed by an empty line.\n"
+			"Dictionary sweep mode prints every occurrence of every word of the dictionary file (words separated by whitespaces) in the grids, including the words found several times. The puzzles words are ignored.\n"
+			"The --format option writes the results as text (the default), one JSON object per puzzle and per line, tab-separated records or binary records, always with rows and columns starting from 1. All other messages are then written to the standard error. The --quiet option only writes the puzzles results, without the found words.\n"
+			"Edit mode keeps a puzzle solved while the commands read from the standard input edit it : \"letter Row Column Letter\" changes a grid letter (rows and columns start from 1), \"add Word\" and \"remove Word\" change the words to search. The puzzle validity and its hidden word are printed after each command, only the words and the grid lines affected by the command are searched again.\n"
+			"The --cache option keeps the found words locations and the hidden word of each solved puzzle in a directory, so a puzzle solved again is not searched again. The directory can be shared by several processes, the least recently used results are removed when it grows bigger than --cache-size mebibytes (64 by default).\n"
+			"The --stats option prints, for each puzzle, the loading, solving and hidden word extraction durations, and the search work : visited cells, candidate (word, cell) pairs, directions rejected by the grid bounds, compared letters and matches.\n", argv[0], argv[0], argv[0], argv[0], argv[0], argv[0]);
 		return EXIT_FAILURE;
 	}
-	if (String_Hidden_Word[0] == 0) printf("This grid does not contain a hidden word.\n");
-	else printf("Hidden word : \"%s\".\n", String_Hidden_Word);
 
+	// Solve the puzzle while displaying all steps, or silently when only the results are wanted
+	SolverPuzzleInitialize(&Puzzle, (Format == OUTPUT_FORMAT_TEXT) && !Is_Quiet);
+	Puzzle.Is_Statistics_Enabled = Is_Statistics_Enabled;
+	Puzzle.Pointer_Cache = Pointer_Cache;
+	Return_Value = SolverSolvePuzzle(&Puzzle, Pointer_Puzzles[0].Pointer_String_File_Name, Strategy, Threads_Count);
+	if ((Return_Value != 0) && !Puzzle.Is_Verbose) printf("Error : the puzzle \"%s\" could not be solved.\n", Pointer_Puzzles[0].Pointer_String_File_Name);
+
+	// Display the hidden word (the found words have already been displayed with the solving steps)
+	if (Puzzle.Is_Verbose)
+	{
+		if (Return_Value == 0)
+		{
+			if (Puzzle.Pointer_String_Hidden_Word[0] == 0) printf("This grid does not contain a hidden word.\n");
+			else printf("Hidden word : \"%s\".\n", Puzzle.Pointer_String_Hidden_Word);
+		}
+	}
+	else MainWritePuzzleResult(&Output, &Puzzle, Pointer_Puzzles[0].Pointer_String_File_Name, Return_Value == 0);
+	if (Is_Statistics_Enabled)
+	{
+		OutputFlush(&Output); // Print the statistics after the results
+		MainPrintStatistics(Pointer_Puzzles[0].Pointer_String_File_Name, &Puzzle.Statistics);
+	}
+
+	free(Pointer_Puzzles[0].Pointer_String_File_Name);
+	free(Pointer_Puzzles);
+	SolverPuzzleFree(&Puzzle);
+	if (Pointer_Cache != NULL) CacheFree(Pointer_Cache);
+	if ((OutputFree(&Output) != 0) || (Return_Value != 0)) return EXIT_FAILURE;
 	return EXIT_SUCCESS;
 }
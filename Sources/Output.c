@@ -0,0 +1,413 @@
+/** @file Output.c
+ * See Output.h for description.
+ * @author Adrien RICCIARDI
+ */
+#include <errno.h>
+#include <Output.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+//-------------------------------------------------------------------------------------------------
+// Private constants
+//-------------------------------------------------------------------------------------------------
+/** The size of the buffer of a writer that writes to a file. A memory writer starts with this size too, then grows as needed. */
+#define OUTPUT_BUFFER_SIZE (1024 * 1024)
+
+//-------------------------------------------------------------------------------------------------
+// Public variables
+//-------------------------------------------------------------------------------------------------
+/** The format names, as provided on the command line. */
+const char *Output_Format_Names[OUTPUT_FORMATS_COUNT] =
+{
+	"text",
+	"json",
+	"tsv",
+	"binary"
+};
+
+//-------------------------------------------------------------------------------------------------
+// Private functions
+//-------------------------------------------------------------------------------------------------
+/** Make sure the buffer can receive the provided amount of bytes, writing its content to the file or growing it if needed.
+ * @param Pointer_Output The writer.
+ * @param Size How many bytes will be appended.
+ * @return -1 if the bytes can't be appended,
+ * @return 0 on success.
+ */
+static int OutputReserve(TOutput *Pointer_Output, size_t Size)
+{
+	size_t New_Size;
+	char *Pointer_Buffer;
+
+	if (Pointer_Output->Has_Failed) return -1;
+	if (Pointer_Output->Used_Size + Size <= Pointer_Output->Buffer_Size) return 0;
+
+	// A file writer empties its buffer, the bytes that still do not fit are written directly by the caller
+	if (Pointer_Output->File_Descriptor >= 0)
+	{
+		if (OutputFlush(Pointer_Output) != 0) return -1;
+		if (Size <= Pointer_Output->Buffer_Size) return 0;
+		return 1;
+	}
+
+	// A memory writer keeps everything
+	New_Size = Pointer_Output->Buffer_Size * 2;
+	while (New_Size < Pointer_Output->Used_Size + Size) New_Size *= 2;
+	Pointer_Buffer = realloc(Pointer_Output->Pointer_Buffer, New_Size);
+	if (Pointer_Buffer == NULL)
+	{
+		Pointer_Output->Has_Failed = 1;
+		return -1;
+	}
+	Pointer_Output->Pointer_Buffer = Pointer_Buffer;
+	Pointer_Output->Buffer_Size = New_Size;
+	return 0;
+}
+
+/** Write all bytes to a file, even if it accepts less bytes at a time.
+ * @param Pointer_Output The writer, its failure flag is set on error.
+ * @param Pointer_Buffer The bytes to write.
+ * @param Size How many bytes to write.
+ * @return -1 if an error occurred,
+ * @return 0 on success.
+ */
+static int OutputWriteToFile(TOutput *Pointer_Output, const char *Pointer_Buffer, size_t Size)
+{
+	ssize_t Written_Bytes_Count;
+
+	while (Size > 0)
+	{
+		Written_Bytes_Count = write(Pointer_Output->File_Descriptor, Pointer_Buffer, Size);
+		if (Written_Bytes_Count < 0)
+		{
+			if (errno == EINTR) continue;
+			Pointer_Output->Has_Failed = 1;
+			return -1;
+		}
+		Pointer_Buffer += Written_Bytes_Count;
+		Size -= (size_t) Written_Bytes_Count;
+	}
+
+	return 0;
+}
+
+/** Append a string.
+ * @param Pointer_Output The writer.
+ * @param Pointer_String The string to write.
+ */
+static void OutputWriteString(TOutput *Pointer_Output, const char *Pointer_String)
+{
+	OutputWriteBytes(Pointer_Output, Pointer_String, strlen(Pointer_String));
+}
+
+/** Append a number in decimal, without calling the costly printf() family functions.
+ * @param Pointer_Output The writer.
+ * @param Number The number to write.
+ */
+static void OutputWriteNumber(TOutput *Pointer_Output, long long Number)
+{
+	char String_Digits[24];
+	int i = sizeof(String_Digits);
+	unsigned long long Value;
+
+	// Convert the digits from the least significant one
+	Value = Number < 0 ? -(unsigned long long) Number : (unsigned long long) Number;
+	do
+	{
+		i--;
+		String_Digits[i] = (char) ('0' + Value % 10);
+		Value /= 10;
+	} while (Value > 0);
+	if (Number < 0)
+	{
+		i--;
+		String_Digits[i] = '-';
+	}
+
+	OutputWriteBytes(Pointer_Output, &String_Digits[i], sizeof(String_Digits) - i);
+}
+
+/** Append a string as a JSON string, surrounded by quotes and with the special characters escaped.
+ * @param Pointer_Output The writer.
+ * @param Pointer_String The string to write.
+ */
+static void OutputWriteJsonString(TOutput *Pointer_Output, const char *Pointer_String)
+{
+	char String_Escape[8];
+
+	OutputWriteBytes(Pointer_Output, "\"", 1);
+	while (*Pointer_String != 0)
+	{
+		if ((*Pointer_String == '"') || (*Pointer_String == '\\'))
+		{
+			String_Escape[0] = '\\';
+			String_Escape[1] = *Pointer_String;
+			OutputWriteBytes(Pointer_Output, String_Escape, 2);
+		}
+		else if ((unsigned char) *Pointer_String < 0x20)
+		{
+			snprintf(String_Escape, sizeof(String_Escape), "\\u%04x", (unsigned char) *Pointer_String);
+			OutputWriteBytes(Pointer_Output, String_Escape, 6);
+		}
+		else OutputWriteBytes(Pointer_Output, Pointer_String, 1);
+		Pointer_String++;
+	}
+	OutputWriteBytes(Pointer_Output, "\"", 1);
+}
+
+/** Append a 32-bit number in the processor byte order.
+ * @param Pointer_Output The writer.
+ * @param Number The number to write.
+ */
+static void OutputWriteBinary32(TOutput *Pointer_Output, uint32_t Number)
+{
+	OutputWriteBytes(Pointer_Output, &Number, sizeof(Number));
+}
+
+/** Append a byte.
+ * @param Pointer_Output The writer.
+ * @param Byte The byte to write.
+ */
+static void OutputWriteBinary8(TOutput *Pointer_Output, uint8_t Byte)
+{
+	OutputWriteBytes(Pointer_Output, &Byte, sizeof(Byte));
+}
+
+//-------------------------------------------------------------------------------------------------
+// Public functions
+//-------------------------------------------------------------------------------------------------
+int OutputInitialize(TOutput *Pointer_Output, int File_Descriptor, TOutputFormat Format, int Is_Quiet)
+{
+	memset(Pointer_Output, 0, sizeof(TOutput));
+	Pointer_Output->Pointer_Buffer = malloc(OUTPUT_BUFFER_SIZE);
+	if (Pointer_Output->Pointer_Buffer == NULL) return -1;
+	Pointer_Output->Buffer_Size = OUTPUT_BUFFER_SIZE;
+	Pointer_Output->File_Descriptor = File_Descriptor;
+	Pointer_Output->Format = Format;
+	Pointer_Output->Is_Quiet = Is_Quiet;
+	return 0;
+}
+
+int OutputFree(TOutput *Pointer_Output)
+{
+	int Return_Value = 0;
+
+	if (Pointer_Output->File_Descriptor >= 0) Return_Value = OutputFlush(Pointer_Output);
+	else if (Pointer_Output->Has_Failed) Return_Value = -1;
+	free(Pointer_Output->Pointer_Buffer);
+	Pointer_Output->Pointer_Buffer = NULL;
+	Pointer_Output->Buffer_Size = 0;
+	Pointer_Output->Used_Size = 0;
+	return Return_Value;
+}
+
+int OutputFlush(TOutput *Pointer_Output)
+{
+	if (Pointer_Output->Has_Failed) return -1;
+	if ((Pointer_Output->File_Descriptor < 0) || (Pointer_Output->Used_Size == 0)) return 0;
+
+	// Make sure the messages printed before are written first
+	fflush(stdout);
+
+	if (OutputWriteToFile(Pointer_Output, Pointer_Output->Pointer_Buffer, Pointer_Output->Used_Size) != 0) return -1;
+	Pointer_Output->Used_Size = 0;
+	return 0;
+}
+
+void OutputWriteBytes(TOutput *Pointer_Output, const void *Pointer_Buffer, size_t Size)
+{
+	int Result;
+
+	Result = OutputReserve(Pointer_Output, Size);
+	if (Result < 0) return;
+
+	// Too big data for the file writer buffer are written at once
+	if (Result > 0)
+	{
+		OutputWriteToFile(Pointer_Output, Pointer_Buffer, Size);
+		return;
+	}
+
+	memcpy(&Pointer_Output->Pointer_Buffer[Pointer_Output->Used_Size], Pointer_Buffer, Size);
+	Pointer_Output->Used_Size += Size;
+}
+
+char *OutputDetachBuffer(TOutput *Pointer_Output, size_t *Pointer_Size)
+{
+	char *Pointer_Content;
+
+	if (Pointer_Output->Has_Failed) return NULL;
+
+	// Copy only the used part, so the big buffer can be reused
+	Pointer_Content = malloc(Pointer_Output->Used_Size + 1); // Make sure to never allocate 0 bytes
+	if (Pointer_Content == NULL) return NULL;
+	memcpy(Pointer_Content, Pointer_Output->Pointer_Buffer, Pointer_Output->Used_Size);
+	*Pointer_Size = Pointer_Output->Used_Size;
+	Pointer_Output->Used_Size = 0;
+	return Pointer_Content;
+}
+
+void OutputBeginPuzzle(TOutput *Pointer_Output, char *Pointer_String_File_Name, int Rows_Count, int Columns_Count)
+{
+	Pointer_Output->Pointer_String_File_Name = Pointer_String_File_Name;
+	Pointer_Output->Rows_Count = Rows_Count;
+	Pointer_Output->Columns_Count = Columns_Count;
+	Pointer_Output->Words_Count = 0;
+
+	switch (Pointer_Output->Format)
+	{
+		case OUTPUT_FORMAT_JSON:
+			OutputWriteString(Pointer_Output, "{\"file\":");
+			OutputWriteJsonString(Pointer_Output, Pointer_String_File_Name);
+			OutputWriteString(Pointer_Output, ",\"rows\":");
+			OutputWriteNumber(Pointer_Output, Rows_Count);
+			OutputWriteString(Pointer_Output, ",\"columns\":");
+			OutputWriteNumber(Pointer_Output, Columns_Count);
+			if (!Pointer_Output->Is_Quiet) OutputWriteString(Pointer_Output, ",\"words\":[");
+			break;
+
+		case OUTPUT_FORMAT_TSV:
+			OutputWriteString(Pointer_Output, "grid\t");
+			OutputWriteString(Pointer_Output, Pointer_String_File_Name);
+			OutputWriteBytes(Pointer_Output, "\t", 1);
+			OutputWriteNumber(Pointer_Output, Rows_Count);
+			OutputWriteBytes(Pointer_Output, "\t", 1);
+			OutputWriteNumber(Pointer_Output, Columns_Count);
+			OutputWriteBytes(Pointer_Output, "\n", 1);
+			break;
+
+		case OUTPUT_FORMAT_BINARY:
+			OutputWriteBinary8(Pointer_Output, 'G');
+			OutputWriteBinary32(Pointer_Output, (uint32_t) Rows_Count);
+			OutputWriteBinary32(Pointer_Output, (uint32_t) Columns_Count);
+			OutputWriteBinary32(Pointer_Output, (uint32_t) strlen(Pointer_String_File_Name));
+			OutputWriteString(Pointer_Output, Pointer_String_File_Name);
+			break;
+
+		// Sentences do not need any header
+		default:
+			break;
+	}
+}
+
+void OutputWriteWord(TOutput *Pointer_Output, char *Pointer_String_Word, int Length, int Row, int Column, TGridDirection Direction)
+{
+	Pointer_Output->Words_Count++;
+	if (Pointer_Output->Is_Quiet) return;
+
+	switch (Pointer_Output->Format)
+	{
+		case OUTPUT_FORMAT_JSON:
+			if (Pointer_Output->Words_Count > 1) OutputWriteBytes(Pointer_Output, ",", 1);
+			OutputWriteString(Pointer_Output, "{\"word\":\"");
+			OutputWriteBytes(Pointer_Output, Pointer_String_Word, Length); // Words contain only letters, they do not need to be escaped
+			OutputWriteString(Pointer_Output, "\",\"row\":");
+			OutputWriteNumber(Pointer_Output, Row + 1);
+			OutputWriteString(Pointer_Output, ",\"column\":");
+			OutputWriteNumber(Pointer_Output, Column + 1);
+			OutputWriteString(Pointer_Output, ",\"direction\":\"");
+			OutputWriteString(Pointer_Output, Grid_Direction_Names[Direction]);
+			OutputWriteString(Pointer_Output, "\",\"length\":");
+			OutputWriteNumber(Pointer_Output, Length);
+			OutputWriteBytes(Pointer_Output, "}", 1);
+			break;
+
+		case OUTPUT_FORMAT_TSV:
+			OutputWriteString(Pointer_Output, "word\t");
+			OutputWriteBytes(Pointer_Output, Pointer_String_Word, Length);
+			OutputWriteBytes(Pointer_Output, "\t", 1);
+			OutputWriteNumber(Pointer_Output, Row + 1);
+			OutputWriteBytes(Pointer_Output, "\t", 1);
+			OutputWriteNumber(Pointer_Output, Column + 1);
+			OutputWriteBytes(Pointer_Output, "\t", 1);
+			OutputWriteString(Pointer_Output, Grid_Direction_Names[Direction]);
+			OutputWriteBytes(Pointer_Output, "\t", 1);
+			OutputWriteNumber(Pointer_Output, Length);
+			OutputWriteBytes(Pointer_Output, "\n", 1);
+			break;
+
+		case OUTPUT_FORMAT_BINARY:
+			OutputWriteBinary8(Pointer_Output, 'W');
+			OutputWriteBinary32(Pointer_Output, (uint32_t) (Row + 1));
+			OutputWriteBinary32(Pointer_Output, (uint32_t) (Column + 1));
+			OutputWriteBinary8(Pointer_Output, (uint8_t) Direction);
+			OutputWriteBinary8(Pointer_Output, (uint8_t) Length);
+			OutputWriteBytes(Pointer_Output, Pointer_String_Word, Length);
+			break;
+
+		default:
+			OutputWriteString(Pointer_Output, "Found word \"");
+			OutputWriteBytes(Pointer_Output, Pointer_String_Word, Length);
+			OutputWriteString(Pointer_Output, "\" at row ");
+			OutputWriteNumber(Pointer_Output, Row + 1);
+			OutputWriteString(Pointer_Output, " and column ");
+			OutputWriteNumber(Pointer_Output, Column + 1);
+			OutputWriteString(Pointer_Output, ", direction ");
+			OutputWriteString(Pointer_Output, Grid_Direction_Names[Direction]);
+			OutputWriteString(Pointer_Output, ".\n");
+			break;
+	}
+}
+
+void OutputEndPuzzle(TOutput *Pointer_Output, int Is_Solved, char *Pointer_String_Hidden_Word)
+{
+	switch (Pointer_Output->Format)
+	{
+		case OUTPUT_FORMAT_JSON:
+			if (!Pointer_Output->Is_Quiet) OutputWriteBytes(Pointer_Output, "]", 1);
+			OutputWriteString(Pointer_Output, ",\"found_words\":");
+			OutputWriteNumber(Pointer_Output, Pointer_Output->Words_Count);
+			OutputWriteString(Pointer_Output, Is_Solved ? ",\"solved\":true" : ",\"solved\":false");
+			if (Pointer_String_Hidden_Word != NULL)
+			{
+				OutputWriteString(Pointer_Output, ",\"hidden_word\":");
+				OutputWriteJsonString(Pointer_Output, Pointer_String_Hidden_Word);
+			}
+			OutputWriteString(Pointer_Output, "}\n");
+			break;
+
+		case OUTPUT_FORMAT_TSV:
+			OutputWriteString(Pointer_Output, Is_Solved ? "result\tsolved\t" : "result\tfailed\t");
+			if (Pointer_String_Hidden_Word != NULL) OutputWriteString(Pointer_Output, Pointer_String_Hidden_Word);
+			OutputWriteBytes(Pointer_Output, "\n", 1);
+			break;
+
+		case OUTPUT_FORMAT_BINARY:
+			OutputWriteBinary8(Pointer_Output, 'R');
+			OutputWriteBinary8(Pointer_Output, Is_Solved ? 1 : 0);
+			if (Pointer_String_Hidden_Word == NULL) OutputWriteBinary32(Pointer_Output, 0);
+			else
+			{
+				OutputWriteBinary32(Pointer_Output, (uint32_t) strlen(Pointer_String_Hidden_Word));
+				OutputWriteString(Pointer_Output, Pointer_String_Hidden_Word);
+			}
+			break;
+
+		// Conclude with a sentence, the errors have already been displayed if the puzzle could not be solved
+		default:
+			if (!Is_Solved) break;
+			if (Pointer_String_Hidden_Word == NULL)
+			{
+				OutputWriteString(Pointer_Output, "Found ");
+				OutputWriteNumber(Pointer_Output, Pointer_Output->Words_Count);
+				OutputWriteString(Pointer_Output, " occurrence(s) of the dictionary words in the ");
+				OutputWriteNumber(Pointer_Output, Pointer_Output->Columns_Count);
+				OutputWriteBytes(Pointer_Output, "x", 1);
+				OutputWriteNumber(Pointer_Output, Pointer_Output->Rows_Count);
+				OutputWriteString(Pointer_Output, " grid of \"");
+				OutputWriteString(Pointer_Output, Pointer_Output->Pointer_String_File_Name);
+				OutputWriteString(Pointer_Output, "\".\n");
+			}
+			else if (Pointer_String_Hidden_Word[0] == 0) OutputWriteString(Pointer_Output, "This grid does not contain a hidden word.\n");
+			else
+			{
+				OutputWriteString(Pointer_Output, "Hidden word : \"");
+				OutputWriteString(Pointer_Output, Pointer_String_Hidden_Word);
+				OutputWriteString(Pointer_Output, "\".\n");
+			}
+			break;
+	}
+}
@@ -0,0 +1,160 @@
+/** @file Parallel_Scan.c
+ * See Parallel_Scan.h for description.
+ * @author Adrien RICCIARDI
+ */
+#include <Parallel_Scan.h>
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+//-------------------------------------------------------------------------------------------------
+// Private types
+//-------------------------------------------------------------------------------------------------
+/** What is shared by all threads searching the same grid. */
+typedef struct
+{
+	TGrid *Pointer_Grid; //!< The grid to search words in.
+	TWordTable *Pointer_Word_Table; //!< The words to search.
+	atomic_llong *Pointer_Location_Keys; //!< The best location found so far for each word, or -1. A word is claimed by atomically lowering its key, so the cell-by-cell scan first location always wins whatever the threads timing.
+	int Is_Counting_Enabled; //!< Set to count the work done by each thread.
+} TParallelScanJob;
+
+/** A thread searching a band of rows. */
+typedef struct
+{
+	pthread_t Thread;
+	TParallelScanJob *Pointer_Job;
+	int First_Row; //!< The first row of the band.
+	int End_Row; //!< The row following the last row of the band.
+	TGridSearchCounters Counters; //!< The work done by this thread, copied once the band has been searched. The thread counts on its stack meanwhile, so the workers, which are next to each other in memory, do not write to the same cache lines.
+} TParallelScanWorker;
+
+//-------------------------------------------------------------------------------------------------
+// Private functions
+//-------------------------------------------------------------------------------------------------
+/** Search all words starting in a band of rows.
+ * @param Pointer_Parameters The TParallelScanWorker describing the band to search.
+ * @return Always NULL.
+ */
+static void *ParallelScanWorkerThread(void *Pointer_Parameters)
+{
+	TParallelScanWorker *Pointer_Worker = Pointer_Parameters;
+	TParallelScanJob *Pointer_Job = Pointer_Worker->Pointer_Job;
+	int Row, Column, Letter, Word_Index, End_Word_Index, Direction;
+	long long Cell_Key, Key, New_Key;
+	TWordTable *Pointer_Word_Table = Pointer_Job->Pointer_Word_Table;
+	TGridSearchCounters Counters;
+
+	memset(&Counters, 0, sizeof(Counters));
+
+	for (Row = Pointer_Worker->First_Row; Row < Pointer_Worker->End_Row; Row++)
+	{
+		for (Column = 0; Column < Pointer_Job->Pointer_Grid->Columns_Count; Column++)
+		{
+			// Only words starting with the cell letter can start here
+			Letter = GRID_GET_LETTER(Pointer_Job->Pointer_Grid, Row, Column) - 'A';
+			Cell_Key = GRID_MAKE_LOCATION_KEY(Row, Column, Pointer_Job->Pointer_Grid->Columns_Count, 0);
+
+			End_Word_Index = Pointer_Word_Table->Bucket_First_Indexes[Letter + 1];
+			for (Word_Index = Pointer_Word_Table->Bucket_First_Indexes[Letter]; Word_Index < End_Word_Index; Word_Index++)
+			{
+				// Do not search again a word already found on a previous cell
+				Key = atomic_load_explicit(&Pointer_Job->Pointer_Location_Keys[Word_Index], memory_order_relaxed);
+				if ((Key < 0) || (Key >= Cell_Key))
+				{
+					// Count the work only when asked, so the search loop stays the same otherwise
+					if (Pointer_Job->Is_Counting_Enabled)
+					{
+						Counters.Candidate_Pairs_Count++;
+						Direction = GridFindWordDirectionCounted(Pointer_Job->Pointer_Grid, WORD_TABLE_GET_WORD(Pointer_Word_Table, Word_Index), WORD_TABLE_GET_LENGTH(Pointer_Word_Table, Word_Index), Row, Column, &Counters);
+					}
+					else Direction = GridFindWordDirection(Pointer_Job->Pointer_Grid, WORD_TABLE_GET_WORD(Pointer_Word_Table, Word_Index), WORD_TABLE_GET_LENGTH(Pointer_Word_Table, Word_Index), Row, Column);
+					if (Direction >= 0)
+					{
+						if (Pointer_Job->Is_Counting_Enabled) Counters.Matches_Count++;
+
+						// Claim the word, unless another thread found it at a better location meanwhile
+						New_Key = Cell_Key + Direction;
+						while ((Key < 0) || (New_Key < Key))
+						{
+							if (atomic_compare_exchange_weak_explicit(&Pointer_Job->Pointer_Location_Keys[Word_Index], &Key, New_Key, memory_order_relaxed, memory_order_relaxed)) break;
+						}
+					}
+				}
+			}
+		}
+	}
+
+	if (Pointer_Job->Is_Counting_Enabled)
+	{
+		Counters.Visited_Cells_Count = (long long) (Pointer_Worker->End_Row - Pointer_Worker->First_Row) * Pointer_Job->Pointer_Grid->Columns_Count;
+		Pointer_Worker->Counters = Counters;
+	}
+	return NULL;
+}
+
+//-------------------------------------------------------------------------------------------------
+// Public functions
+//-------------------------------------------------------------------------------------------------
+int ParallelScanFindWords(TGrid *Pointer_Grid, TWordTable *Pointer_Word_Table, int Threads_Count, long long *Pointer_Location_Keys, TGridSearchCounters *Pointer_Counters)
+{
+	TParallelScanJob Job;
+	TParallelScanWorker *Pointer_Workers = NULL;
+	int i, Words_Count = Pointer_Word_Table->Words_Count, Rows_Count = Pointer_Grid->Rows_Count, Started_Threads_Count = 0, Return_Value = -1;
+
+	// Do not create threads that would have nothing to do
+	if (Threads_Count > Rows_Count) Threads_Count = Rows_Count;
+	if (Threads_Count < 1) Threads_Count = 1;
+
+	Job.Pointer_Grid = Pointer_Grid;
+	Job.Pointer_Word_Table = Pointer_Word_Table;
+	Job.Is_Counting_Enabled = Pointer_Counters != NULL;
+	Job.Pointer_Location_Keys = malloc((Words_Count + 1) * sizeof(atomic_llong)); // Make sure to never allocate 0 bytes
+	Pointer_Workers = malloc(Threads_Count * sizeof(TParallelScanWorker));
+	if ((Job.Pointer_Location_Keys == NULL) || (Pointer_Workers == NULL))
+	{
+		printf("Error : not enough memory to start the search threads.\n");
+		goto Exit;
+	}
+	for (i = 0; i < Words_Count; i++) atomic_init(&Job.Pointer_Location_Keys[i], -1);
+
+	// Give each thread a band of consecutive rows of about the same size
+	for (i = 0; i < Threads_Count; i++)
+	{
+		Pointer_Workers[i].Pointer_Job = &Job;
+		Pointer_Workers[i].First_Row = (int) ((long long) Rows_Count * i / Threads_Count);
+		Pointer_Workers[i].End_Row = (int) ((long long) Rows_Count * (i + 1) / Threads_Count);
+		memset(&Pointer_Workers[i].Counters, 0, sizeof(TGridSearchCounters));
+		if (pthread_create(&Pointer_Workers[i].Thread, NULL, ParallelScanWorkerThread, &Pointer_Workers[i]) != 0)
+		{
+			printf("Error : failed to start a search thread.\n");
+			goto Exit;
+		}
+		Started_Threads_Count++;
+	}
+	Return_Value = 0;
+
+Exit:
+	// Always wait for the started threads, even on error, because they use the job data
+	for (i = 0; i < Started_Threads_Count; i++)
+	{
+		pthread_join(Pointer_Workers[i].Thread, NULL);
+		if (Pointer_Counters != NULL)
+		{
+			Pointer_Counters->Visited_Cells_Count += Pointer_Workers[i].Counters.Visited_Cells_Count;
+			Pointer_Counters->Candidate_Pairs_Count += Pointer_Workers[i].Counters.Candidate_Pairs_Count;
+			Pointer_Counters->Rejected_Directions_Count += Pointer_Workers[i].Counters.Rejected_Directions_Count;
+			Pointer_Counters->Compared_Letters_Count += Pointer_Workers[i].Counters.Compared_Letters_Count;
+			Pointer_Counters->Matches_Count += Pointer_Workers[i].Counters.Matches_Count;
+		}
+	}
+	if (Return_Value == 0)
+	{
+		for (i = 0; i < Words_Count; i++) Pointer_Location_Keys[i] = atomic_load_explicit(&Job.Pointer_Location_Keys[i], memory_order_relaxed);
+	}
+	free(Job.Pointer_Location_Keys);
+	free(Pointer_Workers);
+	return Return_Value;
+}
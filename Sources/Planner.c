@@ -0,0 +1,136 @@
+/** @file Planner.c
+ * See Planner.h for description.
+ * @author Adrien RICCIARDI
+ */
+#include <Planner.h>
+#include <string.h>
+#include <unistd.h>
+
+//-------------------------------------------------------------------------------------------------
+// Private constants
+//-------------------------------------------------------------------------------------------------
+// The cost of the elementary operations of each strategy, in nanoseconds. They have been measured with the benchmark program on grids from 15x15 to 1000x1000 with 30 to 10000 words, only their ratios matter.
+/** The fixed cost of a cell-by-cell scan. */
+#define PLANNER_SCAN_COST 4000.0
+/** The cost of trying a word on a cell starting with the word first letter. */
+#define PLANNER_SCAN_PAIR_COST 15.0
+/** The cost of starting and joining a scan thread. */
+#define PLANNER_SCAN_THREAD_COST 30000.0
+
+/** The fixed cost of the letter index strategy. */
+#define PLANNER_LETTER_INDEX_COST 2000.0
+/** The cost of indexing a grid cell. */
+#define PLANNER_LETTER_INDEX_CELL_COST 2.0
+/** The cost of trying a word around an occurrence of its rarest letter. */
+#define PLANNER_LETTER_INDEX_PAIR_COST 18.0
+
+/** The fixed cost of the strategies streaming the grid lines through a words structure. */
+#define PLANNER_STREAMING_COST 10000.0
+/** The cost of adding a word letter to the Aho-Corasick automaton. */
+#define PLANNER_AHO_CORASICK_LETTER_COST 40.0
+/** The cost of reading a grid letter with the Aho-Corasick automaton, when the automaton fits in the processor cache. */
+#define PLANNER_AHO_CORASICK_STEP_COST 4.5
+/** The cost of adding a word letter to the trie. */
+#define PLANNER_TRIE_LETTER_COST 60.0
+/** The cost of walking a grid letter with the trie, when the trie fits in the processor cache. */
+#define PLANNER_TRIE_STEP_COST 7.0
+/** How much more a grid letter costs to the automaton and the trie when they do not fit in the processor cache anymore. */
+#define PLANNER_TREE_CACHE_MISS_STEP_COST 5.0
+/** The amount of word letters from which the automaton and the trie do not fit in the processor cache anymore. */
+#define PLANNER_TREE_CACHED_LETTERS_COUNT 40000.0
+/** The cost of hashing a word letter for the Rabin-Karp hash sets. */
+#define PLANNER_RABIN_KARP_LETTER_COST 20.0
+/** The cost of rolling the hash of a word length over a grid letter. */
+#define PLANNER_RABIN_KARP_STEP_COST 12.0
+/** The cost of reading a grid letter with the shift-and strategy. */
+#define PLANNER_SHIFT_AND_STEP_COST 1.0
+/** The cost of advancing a 64-bit mask of words over a grid letter. */
+#define PLANNER_SHIFT_AND_GROUP_STEP_COST 0.8
+
+//-------------------------------------------------------------------------------------------------
+// Public functions
+//-------------------------------------------------------------------------------------------------
+void PlannerChooseStrategy(TGrid *Pointer_Grid, TWordTable *Pointer_Word_Table, int Maximum_Threads_Count, TPlannerPlan *Pointer_Plan)
+{
+	long long Letter_Counts[CONFIGURATION_ALPHABET_LETTERS_COUNT], Anchor_Count;
+	int Length_Counts[CONFIGURATION_WORD_MAXIMUM_STRING_SIZE];
+	int Word_Index, Length, Letter, i, Distinct_Lengths_Count = 0, Groups_Count = 0, Used_Bits_Count = 64, Threads_Count, Processors_Count;
+	size_t Cell_Index, Cells_Count = (size_t) Pointer_Grid->Rows_Count * Pointer_Grid->Columns_Count;
+	double First_Letter_Pairs_Count = 0, Rarest_Letter_Pairs_Count = 0, Letters_Count = 0, Steps_Count, Cache_Miss_Ratio, Duration;
+	char *Pointer_String_Word;
+	TSolverStrategy Strategy;
+
+	// Grid letters histogram
+	memset(Letter_Counts, 0, sizeof(Letter_Counts));
+	for (Cell_Index = 0; Cell_Index < Cells_Count; Cell_Index++) Letter_Counts[Pointer_Grid->Pointer_Letters[Cell_Index] - 'A']++;
+
+	// Only the cells starting like a word are tried by the scan
+	for (Letter = 0; Letter < CONFIGURATION_ALPHABET_LETTERS_COUNT; Letter++) First_Letter_Pairs_Count += (double) Letter_Counts[Letter] * (Pointer_Word_Table->Bucket_First_Indexes[Letter + 1] - Pointer_Word_Table->Bucket_First_Indexes[Letter]);
+
+	// Words lengths histogram and rarest letters
+	memset(Length_Counts, 0, sizeof(Length_Counts));
+	for (Word_Index = 0; Word_Index < Pointer_Word_Table->Words_Count; Word_Index++)
+	{
+		Pointer_String_Word = WORD_TABLE_GET_WORD(Pointer_Word_Table, Word_Index);
+		Length = WORD_TABLE_GET_LENGTH(Pointer_Word_Table, Word_Index);
+		if (Length_Counts[Length] == 0) Distinct_Lengths_Count++;
+		Length_Counts[Length]++;
+		Letters_Count += Length;
+
+		Anchor_Count = Letter_Counts[Pointer_String_Word[0] - 'A'];
+		for (i = 1; i < Length; i++)
+		{
+			if (Letter_Counts[Pointer_String_Word[i] - 'A'] < Anchor_Count) Anchor_Count = Letter_Counts[Pointer_String_Word[i] - 'A'];
+		}
+		Rarest_Letter_Pairs_Count += Anchor_Count;
+
+		// Pack the words like the shift-and strategy does, a word never spans two 64-bit masks
+		if (Used_Bits_Count + Length > 64)
+		{
+			Groups_Count++;
+			Used_Bits_Count = 0;
+		}
+		Used_Bits_Count += Length;
+	}
+
+	// The streaming strategies read each grid letter once per direction
+	Steps_Count = (double) Cells_Count * GRID_DIRECTIONS_COUNT;
+	Cache_Miss_Ratio = Letters_Count / PLANNER_TREE_CACHED_LETTERS_COUNT;
+	if (Cache_Miss_Ratio > 1) Cache_Miss_Ratio = 1;
+
+	// Threads only pay off when they run on their own processor
+	Processors_Count = (int) sysconf(_SC_NPROCESSORS_ONLN);
+	if (Processors_Count < 1) Processors_Count = 1;
+	Threads_Count = Maximum_Threads_Count < Processors_Count ? Maximum_Threads_Count : Processors_Count;
+	if (Threads_Count < 1) Threads_Count = 1;
+
+	// Estimate each strategy in nanoseconds
+	Pointer_Plan->Threads_Count = 1;
+	Pointer_Plan->Estimated_Durations[SOLVER_STRATEGY_SCAN] = PLANNER_SCAN_COST + PLANNER_SCAN_PAIR_COST * First_Letter_Pairs_Count;
+	Pointer_Plan->Estimated_Durations[SOLVER_STRATEGY_AHO_CORASICK] = PLANNER_STREAMING_COST + PLANNER_AHO_CORASICK_LETTER_COST * Letters_Count + (PLANNER_AHO_CORASICK_STEP_COST + PLANNER_TREE_CACHE_MISS_STEP_COST * Cache_Miss_Ratio) * Steps_Count;
+	Pointer_Plan->Estimated_Durations[SOLVER_STRATEGY_TRIE] = PLANNER_STREAMING_COST + PLANNER_TRIE_LETTER_COST * Letters_Count + (PLANNER_TRIE_STEP_COST + PLANNER_TREE_CACHE_MISS_STEP_COST * Cache_Miss_Ratio) * Steps_Count;
+	Pointer_Plan->Estimated_Durations[SOLVER_STRATEGY_RABIN_KARP] = PLANNER_STREAMING_COST + PLANNER_RABIN_KARP_LETTER_COST * Letters_Count + PLANNER_RABIN_KARP_STEP_COST * Distinct_Lengths_Count * Steps_Count;
+	Pointer_Plan->Estimated_Durations[SOLVER_STRATEGY_LETTER_INDEX] = PLANNER_LETTER_INDEX_COST + PLANNER_LETTER_INDEX_CELL_COST * Cells_Count + PLANNER_LETTER_INDEX_PAIR_COST * Rarest_Letter_Pairs_Count;
+	Pointer_Plan->Estimated_Durations[SOLVER_STRATEGY_SHIFT_AND] = PLANNER_STREAMING_COST + (PLANNER_SHIFT_AND_STEP_COST + PLANNER_SHIFT_AND_GROUP_STEP_COST * Groups_Count) * Steps_Count;
+	Pointer_Plan->Estimated_Durations[SOLVER_STRATEGY_AUTO] = 0;
+
+	// The scan is the only strategy that can split the grid between threads
+	if (Threads_Count > 1)
+	{
+		Duration = PLANNER_SCAN_COST + PLANNER_SCAN_PAIR_COST * First_Letter_Pairs_Count / Threads_Count + PLANNER_SCAN_THREAD_COST * Threads_Count;
+		if (Duration < Pointer_Plan->Estimated_Durations[SOLVER_STRATEGY_SCAN])
+		{
+			Pointer_Plan->Estimated_Durations[SOLVER_STRATEGY_SCAN] = Duration;
+			Pointer_Plan->Threads_Count = Threads_Count;
+		}
+	}
+
+	// Keep the first cheapest strategy
+	Pointer_Plan->Strategy = SOLVER_STRATEGY_SCAN;
+	for (Strategy = 0; Strategy < SOLVER_STRATEGY_AUTO; Strategy++)
+	{
+		Pointer_Plan->Estimated_Durations[Strategy] /= 1000000000.0;
+		if (Pointer_Plan->Estimated_Durations[Strategy] < Pointer_Plan->Estimated_Durations[Pointer_Plan->Strategy]) Pointer_Plan->Strategy = Strategy;
+	}
+	if (Pointer_Plan->Strategy != SOLVER_STRATEGY_SCAN) Pointer_Plan->Threads_Count = 1;
+}
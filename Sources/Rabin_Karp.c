@@ -0,0 +1,227 @@
+/** @file Rabin_Karp.c
+ * See Rabin_Karp.h for description.
+ * @author Adrien RICCIARDI
+ */
+#include <Rabin_Karp.h>
+#include <stdlib.h>
+#include <string.h>
+
+//-------------------------------------------------------------------------------------------------
+// Private constants
+//-------------------------------------------------------------------------------------------------
+/** The polynomial hash base. */
+#define RABIN_KARP_HASH_BASE 1099511628211ULL
+
+/** Spread the hash bits before selecting a slot, the low bits of a polynomial hash modulo 2^64 only depend on the low bits of the letters. */
+#define RABIN_KARP_SLOT_MULTIPLIER 0x9E3779B97F4A7C15ULL
+
+//-------------------------------------------------------------------------------------------------
+// Private types
+//-------------------------------------------------------------------------------------------------
+/** The words grouped by length, with an open addressing hash set per length. All sets are stored in the same slot arrays. */
+typedef struct
+{
+	unsigned long long *Pointer_Slot_Hashes; //!< The hash of the words stored in each slot.
+	int *Pointer_Slot_Words; //!< The first word stored in each slot, or -1 if the slot is empty.
+	int *Pointer_Next_Words; //!< For each word, the index of the next identical word (several identical words can be searched), or -1.
+	int Lengths[CONFIGURATION_WORD_MAXIMUM_STRING_SIZE]; //!< All distinct word lengths.
+	int Lengths_Count; //!< How many distinct word lengths.
+	size_t Set_Offsets[CONFIGURATION_WORD_MAXIMUM_STRING_SIZE]; //!< The first slot of each length set.
+	size_t Set_Masks[CONFIGURATION_WORD_MAXIMUM_STRING_SIZE]; //!< The slots count minus one of each length set, the slots count is a power of two.
+	int Set_Shifts[CONFIGURATION_WORD_MAXIMUM_STRING_SIZE]; //!< How many bits to discard from the spread hash to get a slot of each length set.
+	unsigned long long Highest_Powers[CONFIGURATION_WORD_MAXIMUM_STRING_SIZE]; //!< The hash base raised to the length minus one, to remove the first letter from a rolling hash.
+} TRabinKarpIndex;
+
+//-------------------------------------------------------------------------------------------------
+// Private functions
+//-------------------------------------------------------------------------------------------------
+/** Release all memory allocated by an index.
+ * @param Pointer_Index The index to free.
+ */
+static void RabinKarpFree(TRabinKarpIndex *Pointer_Index)
+{
+	free(Pointer_Index->Pointer_Slot_Hashes);
+	free(Pointer_Index->Pointer_Slot_Words);
+	free(Pointer_Index->Pointer_Next_Words);
+}
+
+/** Compute the hash of a letters sequence.
+ * @param Pointer_Letters The letters.
+ * @param Length How many letters to hash.
+ * @return The hash.
+ */
+static inline unsigned long long RabinKarpHash(const char *Pointer_Letters, int Length)
+{
+	unsigned long long Hash = 0;
+	int i;
+
+	for (i = 0; i < Length; i++) Hash = Hash * RABIN_KARP_HASH_BASE + (unsigned char) Pointer_Letters[i];
+	return Hash;
+}
+
+/** Get the slot a hash would be stored in if there was no collision.
+ * @param Pointer_Index The index.
+ * @param Length The length set to use.
+ * @param Hash The hash.
+ * @return The slot index, relative to the set first slot.
+ */
+static inline size_t RabinKarpGetSlot(TRabinKarpIndex *Pointer_Index, int Length, unsigned long long Hash)
+{
+	return (size_t) ((Hash * RABIN_KARP_SLOT_MULTIPLIER) >> Pointer_Index->Set_Shifts[Length]);
+}
+
+/** Build the hash sets of all words of the table.
+ * @param Pointer_Index The index to build.
+ * @param Pointer_Word_Table The words to insert.
+ * @return -1 if no more heap memory is available,
+ * @return 0 on success.
+ */
+static int RabinKarpBuild(TRabinKarpIndex *Pointer_Index, TWordTable *Pointer_Word_Table)
+{
+	int Words_Counts[CONFIGURATION_WORD_MAXIMUM_STRING_SIZE], Word_Index, Words_Count = Pointer_Word_Table->Words_Count, Length, Bits_Count, Slot_Word;
+	size_t Slots_Count = 0, Set_Slots_Count, Slot;
+	unsigned long long Hash, Power;
+	char *Pointer_String_Word;
+
+	memset(Pointer_Index, 0, sizeof(TRabinKarpIndex));
+
+	// Count the words of each length
+	memset(Words_Counts, 0, sizeof(Words_Counts));
+	for (Word_Index = 0; Word_Index < Words_Count; Word_Index++) Words_Counts[WORD_TABLE_GET_LENGTH(Pointer_Word_Table, Word_Index)]++;
+
+	// Give each length a set at least twice bigger than its words count, so probing sequences stay short
+	for (Length = 1; Length < CONFIGURATION_WORD_MAXIMUM_STRING_SIZE; Length++)
+	{
+		if (Words_Counts[Length] == 0) continue;
+		Pointer_Index->Lengths[Pointer_Index->Lengths_Count] = Length;
+		Pointer_Index->Lengths_Count++;
+
+		Bits_Count = 1;
+		while (((size_t) 1 << Bits_Count) < 2 * (size_t) Words_Counts[Length]) Bits_Count++;
+		Set_Slots_Count = (size_t) 1 << Bits_Count;
+		Pointer_Index->Set_Offsets[Length] = Slots_Count;
+		Pointer_Index->Set_Masks[Length] = Set_Slots_Count - 1;
+		Pointer_Index->Set_Shifts[Length] = 64 - Bits_Count;
+		Slots_Count += Set_Slots_Count;
+
+		Power = 1;
+		for (Bits_Count = 1; Bits_Count < Length; Bits_Count++) Power *= RABIN_KARP_HASH_BASE;
+		Pointer_Index->Highest_Powers[Length] = Power;
+	}
+
+	Pointer_Index->Pointer_Slot_Hashes = malloc((Slots_Count + 1) * sizeof(unsigned long long)); // Make sure to never allocate 0 bytes
+	Pointer_Index->Pointer_Slot_Words = malloc((Slots_Count + 1) * sizeof(int));
+	Pointer_Index->Pointer_Next_Words = malloc((Words_Count + 1) * sizeof(int));
+	if ((Pointer_Index->Pointer_Slot_Hashes == NULL) || (Pointer_Index->Pointer_Slot_Words == NULL) || (Pointer_Index->Pointer_Next_Words == NULL)) return -1;
+	memset(Pointer_Index->Pointer_Slot_Words, -1, Slots_Count * sizeof(int));
+
+	for (Word_Index = 0; Word_Index < Words_Count; Word_Index++)
+	{
+		Pointer_String_Word = WORD_TABLE_GET_WORD(Pointer_Word_Table, Word_Index);
+		Length = WORD_TABLE_GET_LENGTH(Pointer_Word_Table, Word_Index);
+		Hash = RabinKarpHash(Pointer_String_Word, Length);
+		Pointer_Index->Pointer_Next_Words[Word_Index] = -1;
+
+		// Probe until an empty slot or a slot storing the same word is found, different words may have the same hash
+		Slot = RabinKarpGetSlot(Pointer_Index, Length, Hash);
+		while (1)
+		{
+			Slot_Word = Pointer_Index->Pointer_Slot_Words[Pointer_Index->Set_Offsets[Length] + Slot];
+			if (Slot_Word < 0)
+			{
+				Pointer_Index->Pointer_Slot_Hashes[Pointer_Index->Set_Offsets[Length] + Slot] = Hash;
+				Pointer_Index->Pointer_Slot_Words[Pointer_Index->Set_Offsets[Length] + Slot] = Word_Index;
+				break;
+			}
+			if ((Pointer_Index->Pointer_Slot_Hashes[Pointer_Index->Set_Offsets[Length] + Slot] == Hash) && (memcmp(WORD_TABLE_GET_WORD(Pointer_Word_Table, Slot_Word), Pointer_String_Word, Length) == 0))
+			{
+				Pointer_Index->Pointer_Next_Words[Word_Index] = Pointer_Index->Pointer_Next_Words[Slot_Word];
+				Pointer_Index->Pointer_Next_Words[Slot_Word] = Word_Index;
+				break;
+			}
+			Slot = (Slot + 1) & Pointer_Index->Set_Masks[Length];
+		}
+	}
+
+	return 0;
+}
+
+//-------------------------------------------------------------------------------------------------
+// Public functions
+//-------------------------------------------------------------------------------------------------
+int RabinKarpFindWords(TGrid *Pointer_Grid, TWordTable *Pointer_Word_Table, long long *Pointer_Location_Keys)
+{
+	TRabinKarpIndex Index;
+	int i, Words_Count = Pointer_Word_Table->Words_Count, Rows_Count = Pointer_Grid->Rows_Count, Columns_Count = Pointer_Grid->Columns_Count, Direction, Row_Step, Column_Step, Row, Column, Letters_Count, Letters_Step, Length, Position, Word_Index, Return_Value = -1;
+	unsigned long long Hash, Highest_Power;
+	size_t Slot, Set_Offset, Set_Mask;
+	char *Pointer_Letters, String_Reversed_Line[CONFIGURATION_GRID_MAXIMUM_SIZE];
+	long long Key;
+
+	if (RabinKarpBuild(&Index, Pointer_Word_Table) != 0) goto Exit;
+	for (i = 0; i < Words_Count; i++) Pointer_Location_Keys[i] = -1;
+
+	// Slide the hash of each length along each grid line, once per direction
+	for (Direction = 0; Direction < GRID_DIRECTIONS_COUNT; Direction++)
+	{
+		GridGetDirectionSteps(Direction, &Row_Step, &Column_Step);
+
+		for (Row = 0; Row < Rows_Count; Row++)
+		{
+			for (Column = 0; Column < Columns_Count; Column++)
+			{
+				// A line starts on the cells whose predecessor in this direction is outside of the grid
+				if ((Row - Row_Step >= 0) && (Row - Row_Step < Rows_Count) && (Column - Column_Step >= 0) && (Column - Column_Step < Columns_Count)) continue;
+				Pointer_Letters = GridGetDirectionLetters(Pointer_Grid, Direction, Row, Column, &Letters_Count, &Letters_Step);
+
+				// The backward directions lines are stored in reverse, put their letters in reading order so the hash can roll on contiguous letters
+				if (Letters_Step < 0)
+				{
+					for (i = 0; i < Letters_Count; i++) String_Reversed_Line[i] = Pointer_Letters[-i];
+					Pointer_Letters = String_Reversed_Line;
+				}
+
+				for (i = 0; i < Index.Lengths_Count; i++)
+				{
+					// Lengths are sorted, no longer word fits in this line
+					Length = Index.Lengths[i];
+					if (Length > Letters_Count) break;
+					Set_Offset = Index.Set_Offsets[Length];
+					Set_Mask = Index.Set_Masks[Length];
+					Highest_Power = Index.Highest_Powers[Length];
+
+					Hash = RabinKarpHash(Pointer_Letters, Length);
+					for (Position = 0; ; Position++)
+					{
+						// Compare the letters only with the words having the same hash
+						Slot = RabinKarpGetSlot(&Index, Length, Hash);
+						while ((Word_Index = Index.Pointer_Slot_Words[Set_Offset + Slot]) >= 0)
+						{
+							if ((Index.Pointer_Slot_Hashes[Set_Offset + Slot] == Hash) && (memcmp(WORD_TABLE_GET_WORD(Pointer_Word_Table, Word_Index), &Pointer_Letters[Position], Length) == 0))
+							{
+								// Keep only the location the cell-by-cell scan would have found first
+								Key = GRID_MAKE_LOCATION_KEY(Row + Position * Row_Step, Column + Position * Column_Step, Columns_Count, Direction);
+								while (Word_Index >= 0)
+								{
+									if ((Pointer_Location_Keys[Word_Index] < 0) || (Key < Pointer_Location_Keys[Word_Index])) Pointer_Location_Keys[Word_Index] = Key;
+									Word_Index = Index.Pointer_Next_Words[Word_Index];
+								}
+								break;
+							}
+							Slot = (Slot + 1) & Set_Mask;
+						}
+
+						// Roll the hash to the next window
+						if (Position + Length >= Letters_Count) break;
+						Hash = (Hash - Highest_Power * (unsigned char) Pointer_Letters[Position]) * RABIN_KARP_HASH_BASE + (unsigned char) Pointer_Letters[Position + Length];
+					}
+				}
+			}
+		}
+	}
+	Return_Value = 0;
+
+Exit:
+	RabinKarpFree(&Index);
+	return Return_Value;
+}
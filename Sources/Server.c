@@ -0,0 +1,356 @@
+/** @file Server.c
+ * See Server.h for description.
+ * @author Adrien RICCIARDI
+ */
+#include <errno.h>
+#include <pthread.h>
+#include <Server.h>
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+//-------------------------------------------------------------------------------------------------
+// Private types
+//-------------------------------------------------------------------------------------------------
+/** A connection to serve, either the standard streams or a socket. */
+typedef struct
+{
+	int Input_File_Descriptor; //!< Where to read the requests from.
+	int Output_File_Descriptor; //!< Where to write the responses to.
+	TSolverStrategy Strategy; //!< How to search the words.
+	int Threads_Count; //!< How many threads the scan strategy can use.
+	TCache *Pointer_Cache; //!< The results cache shared by all connections, or NULL.
+} TServerConnection;
+
+/** Split the received bytes into requests. */
+typedef struct
+{
+	char *Pointer_Buffer; //!< The received bytes that have not been handled yet.
+	size_t Buffer_Size; //!< The buffer size in bytes.
+	size_t Data_Size; //!< How many bytes the buffer contains.
+	size_t Request_Start; //!< Where the next request begins in the buffer.
+	size_t Line_Start; //!< Where the line being searched for its end begins in the buffer.
+	size_t Scan_Offset; //!< The next byte to check for a line end, so each received byte is checked only once.
+} TServerReader;
+
+//-------------------------------------------------------------------------------------------------
+// Private constants
+//-------------------------------------------------------------------------------------------------
+/** The initial size of a connection receive buffer, it is doubled each time a request does not fit in it. */
+#define SERVER_READER_INITIAL_BUFFER_SIZE 65536
+
+/** How many connections can wait to be accepted. */
+#define SERVER_LISTEN_BACKLOG 64
+
+//-------------------------------------------------------------------------------------------------
+// Private functions
+//-------------------------------------------------------------------------------------------------
+/** Get the next request of a connection, reading more bytes when no complete request has been received yet.
+ * @param Pointer_Reader The connection reader.
+ * @param File_Descriptor The connection to read from.
+ * @param Pointer_Size On output, contain the request size in bytes (the terminating empty line is not included).
+ * @return NULL if the end of the stream has been reached or if an error occurred,
+ * @return A pointer on the request in the reader buffer, it is valid until the next call. The byte following the request can be overwritten.
+ */
+static char *ServerReadRequest(TServerReader *Pointer_Reader, int File_Descriptor, size_t *Pointer_Size)
+{
+	char *Pointer_Buffer, *Pointer_Request;
+	size_t Size, Line_Length;
+	ssize_t Read_Bytes_Count;
+
+	while (1)
+	{
+		// Look for an empty line in the bytes that have not been checked yet
+		while (Pointer_Reader->Scan_Offset < Pointer_Reader->Data_Size)
+		{
+			if (Pointer_Reader->Pointer_Buffer[Pointer_Reader->Scan_Offset] == '\n')
+			{
+				// Windows line endings are accepted too
+				Line_Length = Pointer_Reader->Scan_Offset - Pointer_Reader->Line_Start;
+				if ((Line_Length == 0) || ((Line_Length == 1) && (Pointer_Reader->Pointer_Buffer[Pointer_Reader->Line_Start] == '\r')))
+				{
+					Pointer_Request = &Pointer_Reader->Pointer_Buffer[Pointer_Reader->Request_Start];
+					Size = Pointer_Reader->Line_Start - Pointer_Reader->Request_Start;
+					Pointer_Reader->Request_Start = Pointer_Reader->Scan_Offset + 1;
+					Pointer_Reader->Line_Start = Pointer_Reader->Request_Start;
+					Pointer_Reader->Scan_Offset++;
+
+					// Several empty lines in a row do not make empty requests
+					if (Size == 0) continue;
+					*Pointer_Size = Size;
+					return Pointer_Request;
+				}
+				Pointer_Reader->Line_Start = Pointer_Reader->Scan_Offset + 1;
+			}
+			Pointer_Reader->Scan_Offset++;
+		}
+
+		// Move the pending request to the buffer beginning, the previous requests have already been handled
+		if (Pointer_Reader->Request_Start > 0)
+		{
+			Size = Pointer_Reader->Data_Size - Pointer_Reader->Request_Start;
+			memmove(Pointer_Reader->Pointer_Buffer, &Pointer_Reader->Pointer_Buffer[Pointer_Reader->Request_Start], Size);
+			Pointer_Reader->Line_Start -= Pointer_Reader->Request_Start;
+			Pointer_Reader->Scan_Offset -= Pointer_Reader->Request_Start;
+			Pointer_Reader->Data_Size = Size;
+			Pointer_Reader->Request_Start = 0;
+		}
+
+		// Grow the buffer if it is full, always keeping a spare byte to terminate the last request word
+		if (Pointer_Reader->Data_Size + 1 >= Pointer_Reader->Buffer_Size)
+		{
+			Size = Pointer_Reader->Buffer_Size == 0 ? SERVER_READER_INITIAL_BUFFER_SIZE : Pointer_Reader->Buffer_Size * 2;
+			Pointer_Buffer = realloc(Pointer_Reader->Pointer_Buffer, Size);
+			if (Pointer_Buffer == NULL)
+			{
+				printf("Error : not enough memory to receive a request.\n");
+				return NULL;
+			}
+			Pointer_Reader->Pointer_Buffer = Pointer_Buffer;
+			Pointer_Reader->Buffer_Size = Size;
+		}
+
+		Read_Bytes_Count = read(File_Descriptor, &Pointer_Reader->Pointer_Buffer[Pointer_Reader->Data_Size], Pointer_Reader->Buffer_Size - 1 - Pointer_Reader->Data_Size);
+		if (Read_Bytes_Count < 0)
+		{
+			if (errno == EINTR) continue;
+			printf("Error : failed to receive a request (%s).\n", strerror(errno));
+			return NULL;
+		}
+
+		// A request does not need to be followed by an empty line at the end of the stream
+		if (Read_Bytes_Count == 0)
+		{
+			Size = Pointer_Reader->Data_Size - Pointer_Reader->Request_Start;
+			if (Size == 0) return NULL;
+			Pointer_Request = &Pointer_Reader->Pointer_Buffer[Pointer_Reader->Request_Start];
+			Pointer_Reader->Request_Start = Pointer_Reader->Data_Size;
+			Pointer_Reader->Line_Start = Pointer_Reader->Data_Size;
+			*Pointer_Size = Size;
+			return Pointer_Request;
+		}
+		Pointer_Reader->Data_Size += (size_t) Read_Bytes_Count;
+	}
+}
+
+/** Write a whole buffer, even if the connection accepts less bytes at a time.
+ * @param File_Descriptor The connection to write to.
+ * @param Pointer_Buffer The bytes to write.
+ * @param Size How many bytes to write.
+ * @return -1 if the connection is closed or if an error occurred,
+ * @return 0 on success.
+ */
+static int ServerWrite(int File_Descriptor, char *Pointer_Buffer, size_t Size)
+{
+	ssize_t Written_Bytes_Count;
+
+	while (Size > 0)
+	{
+		Written_Bytes_Count = write(File_Descriptor, Pointer_Buffer, Size);
+		if (Written_Bytes_Count < 0)
+		{
+			if (errno == EINTR) continue;
+			return -1;
+		}
+		Pointer_Buffer += Written_Bytes_Count;
+		Size -= (size_t) Written_Bytes_Count;
+	}
+
+	return 0;
+}
+
+/** Solve all requests of a connection until the connection is closed.
+ * @param Pointer_Connection The connection to serve.
+ * @return -1 if an error occurred,
+ * @return 0 when the connection has been closed by the client.
+ */
+static int ServerServeConnection(TServerConnection *Pointer_Connection)
+{
+	TServerReader Reader;
+	TSolverPuzzle Puzzle;
+	char *Pointer_Request, *Pointer_Response = NULL, *Pointer_Buffer;
+	size_t Size, Response_Size, Response_Buffer_Size = 0;
+	int Return_Value = -1;
+
+	memset(&Reader, 0, sizeof(Reader));
+
+	// Keep the same puzzle object for all requests, so grid and word table memory is allocated only once
+	SolverPuzzleInitialize(&Puzzle, 0);
+	Puzzle.Pointer_Cache = Pointer_Connection->Pointer_Cache;
+
+	while ((Pointer_Request = ServerReadRequest(&Reader, Pointer_Connection->Input_File_Descriptor, &Size)) != NULL)
+	{
+		if (SolverSolvePuzzleFromMemory(&Puzzle, Pointer_Request, Size, Pointer_Connection->Strategy, Pointer_Connection->Threads_Count) == 0)
+		{
+			// Make room for "solved ", the hidden word and the two new lines
+			Response_Size = strlen(Puzzle.Pointer_String_Hidden_Word) + 9;
+			if (Response_Size + 1 > Response_Buffer_Size)
+			{
+				Pointer_Buffer = realloc(Pointer_Response, Response_Size + 1);
+				if (Pointer_Buffer == NULL)
+				{
+					printf("Error : not enough memory to send a response.\n");
+					goto Exit;
+				}
+				Pointer_Response = Pointer_Buffer;
+				Response_Buffer_Size = Response_Size + 1;
+			}
+			sprintf(Pointer_Response, "solved %s\n\n", Puzzle.Pointer_String_Hidden_Word);
+			if (ServerWrite(Pointer_Connection->Output_File_Descriptor, Pointer_Response, Response_Size) != 0) goto Exit;
+		}
+		else if (ServerWrite(Pointer_Connection->Output_File_Descriptor, "failed\n\n", 8) != 0) goto Exit;
+	}
+
+	// The loop ends at the end of the stream or on a receive error, which has already been reported
+	Return_Value = 0;
+
+Exit:
+	SolverPuzzleFree(&Puzzle);
+	free(Reader.Pointer_Buffer);
+	free(Pointer_Response);
+	return Return_Value;
+}
+
+/** Serve a socket connection, then close it.
+ * @param Pointer_Parameters The heap-allocated TServerConnection to serve, it is freed by this function.
+ * @return Always NULL.
+ */
+static void *ServerConnectionThread(void *Pointer_Parameters)
+{
+	TServerConnection *Pointer_Connection = Pointer_Parameters;
+
+	ServerServeConnection(Pointer_Connection);
+	close(Pointer_Connection->Input_File_Descriptor);
+	free(Pointer_Connection);
+	return NULL;
+}
+
+//-------------------------------------------------------------------------------------------------
+// Public functions
+//-------------------------------------------------------------------------------------------------
+int ServerServeStandardInput(TSolverStrategy Strategy, int Threads_Count, TCache *Pointer_Cache)
+{
+	TServerConnection Connection;
+	int Return_Value;
+
+	// Keep the standard output for the responses only, the messages printed by the solver go to the standard error
+	fflush(stdout);
+	Connection.Output_File_Descriptor = dup(STDOUT_FILENO);
+	if ((Connection.Output_File_Descriptor < 0) || (dup2(STDERR_FILENO, STDOUT_FILENO) < 0))
+	{
+		printf("Error : failed to redirect the standard output (%s).\n", strerror(errno));
+		return -1;
+	}
+	Connection.Input_File_Descriptor = STDIN_FILENO;
+	Connection.Strategy = Strategy;
+	Connection.Threads_Count = Threads_Count;
+	Connection.Pointer_Cache = Pointer_Cache;
+
+	// A closed output must not kill the process
+	signal(SIGPIPE, SIG_IGN);
+
+	Return_Value = ServerServeConnection(&Connection);
+	close(Connection.Output_File_Descriptor);
+	return Return_Value;
+}
+
+int ServerServeSocket(char *Pointer_String_Socket_Path, TSolverStrategy Strategy, int Threads_Count, TCache *Pointer_Cache)
+{
+	struct sockaddr_un Address;
+	struct stat Status;
+	int Socket, Client_Socket;
+	TServerConnection *Pointer_Connection;
+	pthread_t Thread;
+	pthread_attr_t Thread_Attributes;
+
+	// Make sure the path fits in the socket address
+	if (strlen(Pointer_String_Socket_Path) >= sizeof(Address.sun_path))
+	{
+		printf("Error : the socket path \"%s\" is too long.\n", Pointer_String_Socket_Path);
+		return -1;
+	}
+	memset(&Address, 0, sizeof(Address));
+	Address.sun_family = AF_UNIX;
+	strcpy(Address.sun_path, Pointer_String_Socket_Path);
+
+	// Remove the socket a previous server may have left, but never another kind of file
+	if (lstat(Pointer_String_Socket_Path, &Status) == 0)
+	{
+		if (!S_ISSOCK(Status.st_mode))
+		{
+			printf("Error : the file \"%s\" already exists and is not a socket.\n", Pointer_String_Socket_Path);
+			return -1;
+		}
+		if (unlink(Pointer_String_Socket_Path) != 0)
+		{
+			printf("Error : failed to remove the existing socket \"%s\" (%s).\n", Pointer_String_Socket_Path, strerror(errno));
+			return -1;
+		}
+	}
+	else if (errno != ENOENT)
+	{
+		printf("Error : failed to check the socket path \"%s\" (%s).\n", Pointer_String_Socket_Path, strerror(errno));
+		return -1;
+	}
+
+	// Create the socket
+	Socket = socket(AF_UNIX, SOCK_STREAM, 0);
+	if (Socket < 0)
+	{
+		printf("Error : failed to create the socket (%s).\n", strerror(errno));
+		return -1;
+	}
+	if ((bind(Socket, (struct sockaddr *) &Address, sizeof(Address)) != 0) || (listen(Socket, SERVER_LISTEN_BACKLOG) != 0))
+	{
+		printf("Error : failed to listen on the socket \"%s\" (%s).\n", Pointer_String_Socket_Path, strerror(errno));
+		close(Socket);
+		return -1;
+	}
+
+	// A client closing its connection before reading the response must not kill the process
+	signal(SIGPIPE, SIG_IGN);
+
+	// Each connection is served by its own thread, nobody waits for the threads to end
+	pthread_attr_init(&Thread_Attributes);
+	pthread_attr_setdetachstate(&Thread_Attributes, PTHREAD_CREATE_DETACHED);
+
+	while (1)
+	{
+		Client_Socket = accept(Socket, NULL, NULL);
+		if (Client_Socket < 0)
+		{
+			if ((errno == EINTR) || (errno == ECONNABORTED)) continue;
+			printf("Error : failed to accept a connection (%s).\n", strerror(errno));
+			break;
+		}
+
+		Pointer_Connection = malloc(sizeof(TServerConnection));
+		if (Pointer_Connection == NULL)
+		{
+			printf("Error : not enough memory to serve a connection.\n");
+			close(Client_Socket);
+			continue;
+		}
+		Pointer_Connection->Input_File_Descriptor = Client_Socket;
+		Pointer_Connection->Output_File_Descriptor = Client_Socket;
+		Pointer_Connection->Strategy = Strategy;
+		Pointer_Connection->Threads_Count = Threads_Count;
+		Pointer_Connection->Pointer_Cache = Pointer_Cache;
+
+		if (pthread_create(&Thread, &Thread_Attributes, ServerConnectionThread, Pointer_Connection) != 0)
+		{
+			printf("Error : failed to start a connection thread.\n");
+			close(Client_Socket);
+			free(Pointer_Connection);
+		}
+	}
+
+	pthread_attr_destroy(&Thread_Attributes);
+	close(Socket);
+	return -1;
+}
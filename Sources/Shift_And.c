@@ -0,0 +1,174 @@
+/** @file Shift_And.c
+ * See Shift_And.h for description.
+ * @author Adrien RICCIARDI
+ */
+#include <Shift_And.h>
+#include <stdlib.h>
+#include <string.h>
+
+//-------------------------------------------------------------------------------------------------
+// Private constants
+//-------------------------------------------------------------------------------------------------
+/** How many letters a group of packed words can contain. */
+#define SHIFT_AND_GROUP_BITS_COUNT 64
+
+//-------------------------------------------------------------------------------------------------
+// Private types
+//-------------------------------------------------------------------------------------------------
+/** All words packed in groups of 64 bits, each word using consecutive bits of a single group (a bit per letter, the first letter in the lowest bit). */
+typedef struct
+{
+	unsigned long long *Pointer_Letter_Masks; //!< For each letter and each group, the bits of the word letters equal to this letter (the masks of a letter are contiguous, so all groups are advanced with a single memory stream).
+	unsigned long long *Pointer_Start_Masks; //!< For each group, the bits of the words first letters.
+	unsigned long long *Pointer_End_Masks; //!< For each group, the bits of the words last letters.
+	unsigned long long *Pointer_States; //!< For each group, the words prefixes matched by the letters read so far.
+	int *Pointer_End_Words; //!< For each group and each bit, the word whose last letter is this bit, or -1.
+	int Groups_Count;
+} TShiftAndMatcher;
+
+//-------------------------------------------------------------------------------------------------
+// Private functions
+//-------------------------------------------------------------------------------------------------
+/** Release all memory allocated by a matcher.
+ * @param Pointer_Matcher The matcher to free.
+ */
+static void ShiftAndFree(TShiftAndMatcher *Pointer_Matcher)
+{
+	free(Pointer_Matcher->Pointer_Letter_Masks);
+	free(Pointer_Matcher->Pointer_Start_Masks);
+	free(Pointer_Matcher->Pointer_End_Masks);
+	free(Pointer_Matcher->Pointer_End_Words);
+	free(Pointer_Matcher->Pointer_States);
+}
+
+/** Pack all words of the table in groups and compute the groups masks.
+ * @param Pointer_Matcher The matcher to build.
+ * @param Pointer_Word_Table The words to pack.
+ * @return -1 if no more heap memory is available,
+ * @return 0 on success.
+ */
+static int ShiftAndBuild(TShiftAndMatcher *Pointer_Matcher, TWordTable *Pointer_Word_Table)
+{
+	int i, Word_Index, Words_Count = Pointer_Word_Table->Words_Count, Length, Group, Used_Bits_Count, Bit;
+	char *Pointer_String_Word;
+
+	// Count the groups, a word never spans two groups
+	memset(Pointer_Matcher, 0, sizeof(TShiftAndMatcher));
+	Group = 0;
+	Used_Bits_Count = 0;
+	for (Word_Index = 0; Word_Index < Words_Count; Word_Index++)
+	{
+		Length = WORD_TABLE_GET_LENGTH(Pointer_Word_Table, Word_Index);
+		if (Used_Bits_Count + Length > SHIFT_AND_GROUP_BITS_COUNT)
+		{
+			Group++;
+			Used_Bits_Count = 0;
+		}
+		Used_Bits_Count += Length;
+	}
+	Pointer_Matcher->Groups_Count = Words_Count > 0 ? Group + 1 : 0;
+
+	Pointer_Matcher->Pointer_Letter_Masks = calloc((size_t) Pointer_Matcher->Groups_Count * CONFIGURATION_ALPHABET_LETTERS_COUNT + 1, sizeof(unsigned long long)); // Make sure to never allocate 0 bytes
+	Pointer_Matcher->Pointer_Start_Masks = calloc(Pointer_Matcher->Groups_Count + 1, sizeof(unsigned long long));
+	Pointer_Matcher->Pointer_End_Masks = calloc(Pointer_Matcher->Groups_Count + 1, sizeof(unsigned long long));
+	Pointer_Matcher->Pointer_End_Words = malloc(((size_t) Pointer_Matcher->Groups_Count * SHIFT_AND_GROUP_BITS_COUNT + 1) * sizeof(int));
+	Pointer_Matcher->Pointer_States = malloc((Pointer_Matcher->Groups_Count + 1) * sizeof(unsigned long long));
+	if ((Pointer_Matcher->Pointer_Letter_Masks == NULL) || (Pointer_Matcher->Pointer_Start_Masks == NULL) || (Pointer_Matcher->Pointer_End_Masks == NULL) || (Pointer_Matcher->Pointer_End_Words == NULL) || (Pointer_Matcher->Pointer_States == NULL)) return -1;
+	for (i = 0; i < Pointer_Matcher->Groups_Count * SHIFT_AND_GROUP_BITS_COUNT; i++) Pointer_Matcher->Pointer_End_Words[i] = -1;
+
+	// Set the bits of each word in the same order
+	Group = 0;
+	Used_Bits_Count = 0;
+	for (Word_Index = 0; Word_Index < Words_Count; Word_Index++)
+	{
+		Length = WORD_TABLE_GET_LENGTH(Pointer_Word_Table, Word_Index);
+		if (Used_Bits_Count + Length > SHIFT_AND_GROUP_BITS_COUNT)
+		{
+			Group++;
+			Used_Bits_Count = 0;
+		}
+
+		Pointer_String_Word = WORD_TABLE_GET_WORD(Pointer_Word_Table, Word_Index);
+		for (i = 0; i < Length; i++)
+		{
+			Bit = Used_Bits_Count + i;
+			Pointer_Matcher->Pointer_Letter_Masks[(Pointer_String_Word[i] - 'A') * Pointer_Matcher->Groups_Count + Group] |= 1ULL << Bit;
+		}
+		Pointer_Matcher->Pointer_Start_Masks[Group] |= 1ULL << Used_Bits_Count;
+		Bit = Used_Bits_Count + Length - 1;
+		Pointer_Matcher->Pointer_End_Masks[Group] |= 1ULL << Bit;
+		Pointer_Matcher->Pointer_End_Words[Group * SHIFT_AND_GROUP_BITS_COUNT + Bit] = Word_Index;
+		Used_Bits_Count += Length;
+	}
+
+	return 0;
+}
+
+//-------------------------------------------------------------------------------------------------
+// Public functions
+//-------------------------------------------------------------------------------------------------
+int ShiftAndFindWords(TGrid *Pointer_Grid, TWordTable *Pointer_Word_Table, long long *Pointer_Location_Keys)
+{
+	TShiftAndMatcher Matcher;
+	int i, Rows_Count = Pointer_Grid->Rows_Count, Columns_Count = Pointer_Grid->Columns_Count, Direction, Row_Step, Column_Step, Row, Column, Letters_Count, Letters_Step, Groups_Count, Group, Word_Index, Position, Return_Value = -1;
+	unsigned long long State, Matches, *Pointer_Letter_Masks, *Pointer_Start_Masks, *Pointer_End_Masks, *Pointer_States;
+	long long Key;
+	char *Pointer_Letters;
+
+	if (ShiftAndBuild(&Matcher, Pointer_Word_Table) != 0) goto Exit;
+	for (i = 0; i < Pointer_Word_Table->Words_Count; i++) Pointer_Location_Keys[i] = -1;
+	Groups_Count = Matcher.Groups_Count;
+	Pointer_Start_Masks = Matcher.Pointer_Start_Masks;
+	Pointer_End_Masks = Matcher.Pointer_End_Masks;
+	Pointer_States = Matcher.Pointer_States;
+
+	for (Direction = 0; Direction < GRID_DIRECTIONS_COUNT; Direction++)
+	{
+		GridGetDirectionSteps(Direction, &Row_Step, &Column_Step);
+
+		for (Row = 0; Row < Rows_Count; Row++)
+		{
+			for (Column = 0; Column < Columns_Count; Column++)
+			{
+				// A line starts on the cells whose predecessor in this direction is outside of the grid
+				if ((Row - Row_Step >= 0) && (Row - Row_Step < Rows_Count) && (Column - Column_Step >= 0) && (Column - Column_Step < Columns_Count)) continue;
+				Pointer_Letters = GridGetDirectionLetters(Pointer_Grid, Direction, Row, Column, &Letters_Count, &Letters_Step);
+
+				// Advance all groups on each letter, the groups are independent so their updates can run in parallel in the processor
+				for (Group = 0; Group < Groups_Count; Group++) Pointer_States[Group] = 0;
+				for (i = 0; i < Letters_Count; i++)
+				{
+					// Each set bit is a word prefix ending on this letter, extend them all at once and start all words again
+					Pointer_Letter_Masks = &Matcher.Pointer_Letter_Masks[(Pointer_Letters[i * Letters_Step] - 'A') * Groups_Count];
+					Matches = 0;
+					for (Group = 0; Group < Groups_Count; Group++)
+					{
+						State = ((Pointer_States[Group] << 1) | Pointer_Start_Masks[Group]) & Pointer_Letter_Masks[Group];
+						Pointer_States[Group] = State;
+						Matches |= State & Pointer_End_Masks[Group];
+					}
+					if (Matches == 0) continue;
+
+					// Keep the location the cell-by-cell scan would have found first
+					for (Group = 0; Group < Groups_Count; Group++)
+					{
+						Matches = Pointer_States[Group] & Pointer_End_Masks[Group];
+						while (Matches != 0)
+						{
+							Word_Index = Matcher.Pointer_End_Words[Group * SHIFT_AND_GROUP_BITS_COUNT + __builtin_ctzll(Matches)];
+							Position = i - (WORD_TABLE_GET_LENGTH(Pointer_Word_Table, Word_Index) - 1);
+							Key = GRID_MAKE_LOCATION_KEY(Row + Position * Row_Step, Column + Position * Column_Step, Columns_Count, Direction);
+							if ((Pointer_Location_Keys[Word_Index] < 0) || (Key < Pointer_Location_Keys[Word_Index])) Pointer_Location_Keys[Word_Index] = Key;
+							Matches &= Matches - 1;
+						}
+					}
+				}
+			}
+		}
+	}
+	Return_Value = 0;
+
+Exit:
+	ShiftAndFree(&Matcher);
+	return Return_Value;
+}
@@ -0,0 +1,418 @@
+/** @file Solver.c
+ * See Solver.h for description.
+ * @author Adrien RICCIARDI
+ */
+#include <Aho_Corasick.h>
+#include <Letter_Index.h>
+#include <Parallel_Scan.h>
+#include <Planner.h>
+#include <Rabin_Karp.h>
+#include <Shift_And.h>
+#include <Solver.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <Trie.h>
+
+//-------------------------------------------------------------------------------------------------
+// Private types
+//-------------------------------------------------------------------------------------------------
+/** A word found by a strategy that reports locations instead of removing the words by itself. */
+typedef struct
+{
+	long long Location_Key; //!< The location the word has been found at.
+	int Word_Index; //!< The word index in the table, used to report words starting on the same cell in the same order than the cell-by-cell scan.
+} TSolverFoundWord;
+
+//-------------------------------------------------------------------------------------------------
+// Public variables
+//-------------------------------------------------------------------------------------------------
+/** The strategy names, as provided on the command line. */
+const char *Solver_Strategy_Names[SOLVER_STRATEGIES_COUNT] =
+{
+	"scan",
+	"aho-corasick",
+	"trie",
+	"rabin-karp",
+	"letter-index",
+	"shift-and",
+	"auto"
+};
+
+//-------------------------------------------------------------------------------------------------
+// Private functions
+//-------------------------------------------------------------------------------------------------
+/** Sort found words by starting cell, then by order in the word table (this is the cell-by-cell scan order, the direction does not matter).
+ * @param Pointer_A The first TSolverFoundWord to compare.
+ * @param Pointer_B The second TSolverFoundWord to compare.
+ * @return A negative number if the first word must be reported before the second one, a positive number otherwise.
+ */
+static int SolverCompareFoundWords(const void *Pointer_A, const void *Pointer_B)
+{
+	const TSolverFoundWord *Pointer_Found_Word_A = Pointer_A, *Pointer_Found_Word_B = Pointer_B;
+	long long Cell_A, Cell_B;
+
+	Cell_A = Pointer_Found_Word_A->Location_Key / GRID_DIRECTIONS_COUNT;
+	Cell_B = Pointer_Found_Word_B->Location_Key / GRID_DIRECTIONS_COUNT;
+	if (Cell_A < Cell_B) return -1;
+	if (Cell_A > Cell_B) return 1;
+	return Pointer_Found_Word_A->Word_Index - Pointer_Found_Word_B->Word_Index;
+}
+
+/** Mark in the grid and in the table, then print, all words located by a strategy, in the order the cell-by-cell scan would have found them.
+ * @param Pointer_Puzzle The puzzle the words belong to.
+ * @param Pointer_Location_Keys The location key of each word of the table (or -1 if the word was not found).
+ * @param Remaining_Words_Count The amount of words to find.
+ * @return -1 if no more heap memory is available,
+ * @return 0 on success.
+ */
+static int SolverReportFoundWords(TSolverPuzzle *Pointer_Puzzle, long long *Pointer_Location_Keys, int Remaining_Words_Count)
+{
+	TSolverFoundWord *Pointer_Found_Words;
+	int i, Word_Index, Words_Count = Pointer_Puzzle->Word_Table.Words_Count, Found_Words_Count = 0, Row, Column, Direction;
+
+	Pointer_Found_Words = malloc((Words_Count + 1) * sizeof(TSolverFoundWord)); // Make sure to never allocate 0 bytes
+	if (Pointer_Found_Words == NULL) return -1;
+
+	// Gather the newly found words
+	for (Word_Index = 0; Word_Index < Words_Count; Word_Index++)
+	{
+		if ((Pointer_Location_Keys[Word_Index] >= 0) && !WORD_TABLE_IS_WORD_FOUND(&Pointer_Puzzle->Word_Table, Word_Index))
+		{
+			Pointer_Found_Words[Found_Words_Count].Location_Key = Pointer_Location_Keys[Word_Index];
+			Pointer_Found_Words[Found_Words_Count].Word_Index = Word_Index;
+			Found_Words_Count++;
+		}
+	}
+	qsort(Pointer_Found_Words, Found_Words_Count, sizeof(TSolverFoundWord), SolverCompareFoundWords);
+
+	// Report them
+	for (i = 0; i < Found_Words_Count; i++)
+	{
+		Direction = Pointer_Found_Words[i].Location_Key % GRID_DIRECTIONS_COUNT;
+		Row = (int) (Pointer_Found_Words[i].Location_Key / GRID_DIRECTIONS_COUNT / Pointer_Puzzle->Grid.Columns_Count);
+		Column = (int) (Pointer_Found_Words[i].Location_Key / GRID_DIRECTIONS_COUNT % Pointer_Puzzle->Grid.Columns_Count);
+		Word_Index = Pointer_Found_Words[i].Word_Index;
+		GridSetWordFound(&Pointer_Puzzle->Grid, Row, Column, Direction, WORD_TABLE_GET_LENGTH(&Pointer_Puzzle->Word_Table, Word_Index));
+		WordTableSetWordFound(&Pointer_Puzzle->Word_Table, Word_Index);
+
+		Remaining_Words_Count--;
+		if (Pointer_Puzzle->Is_Verbose) printf("Found word \"%s\" at row %d and column %d (%d word(s) remaining to be found).\n", WORD_TABLE_GET_WORD(&Pointer_Puzzle->Word_Table, Word_Index), Row + 1, Column + 1, Remaining_Words_Count);
+	}
+
+	free(Pointer_Found_Words);
+	return 0;
+}
+
+/** Find all words with a strategy that locates all words before reporting them.
+ * @param Pointer_Puzzle The puzzle to solve.
+ * @param Strategy How to search the words.
+ * @param Threads_Count How many threads to search with.
+ * @param Remaining_Words_Count The amount of words to find.
+ * @return -1 if an error occurred,
+ * @return 0 on success.
+ */
+static int SolverSolveGridWithLocations(TSolverPuzzle *Pointer_Puzzle, TSolverStrategy Strategy, int Threads_Count, int Remaining_Words_Count)
+{
+	long long *Pointer_Location_Keys = Pointer_Puzzle->Pointer_Location_Keys;
+	int Word_Index;
+
+	if (Strategy == SOLVER_STRATEGY_AHO_CORASICK)
+	{
+		if (AhoCorasickFindWords(&Pointer_Puzzle->Grid, &Pointer_Puzzle->Word_Table, Pointer_Location_Keys) != 0)
+		{
+			printf("Error : not enough memory to build the Aho-Corasick automaton.\n");
+			return -1;
+		}
+	}
+	else if (Strategy == SOLVER_STRATEGY_TRIE)
+	{
+		if (TrieFindWords(&Pointer_Puzzle->Grid, &Pointer_Puzzle->Word_Table, Pointer_Location_Keys) != 0)
+		{
+			printf("Error : not enough memory to build the words trie.\n");
+			return -1;
+		}
+	}
+	else if (Strategy == SOLVER_STRATEGY_RABIN_KARP)
+	{
+		if (RabinKarpFindWords(&Pointer_Puzzle->Grid, &Pointer_Puzzle->Word_Table, Pointer_Location_Keys) != 0)
+		{
+			printf("Error : not enough memory to build the Rabin-Karp hash sets.\n");
+			return -1;
+		}
+	}
+	else if (Strategy == SOLVER_STRATEGY_LETTER_INDEX)
+	{
+		if (LetterIndexFindWords(&Pointer_Puzzle->Grid, &Pointer_Puzzle->Word_Table, Pointer_Location_Keys) != 0)
+		{
+			printf("Error : not enough memory to build the grid letters index.\n");
+			return -1;
+		}
+	}
+	else if (Strategy == SOLVER_STRATEGY_SHIFT_AND)
+	{
+		if (ShiftAndFindWords(&Pointer_Puzzle->Grid, &Pointer_Puzzle->Word_Table, Pointer_Location_Keys) != 0)
+		{
+			printf("Error : not enough memory to build the shift-and masks.\n");
+			return -1;
+		}
+	}
+	else if (ParallelScanFindWords(&Pointer_Puzzle->Grid, &Pointer_Puzzle->Word_Table, Threads_Count, Pointer_Location_Keys, Pointer_Puzzle->Is_Statistics_Enabled ? &Pointer_Puzzle->Statistics.Counters : NULL) != 0) return -1;
+
+	// The other strategies do not try cells and directions one by one, only their results can be counted
+	if (Pointer_Puzzle->Is_Statistics_Enabled && (Strategy != SOLVER_STRATEGY_SCAN))
+	{
+		for (Word_Index = 0; Word_Index < Pointer_Puzzle->Word_Table.Words_Count; Word_Index++)
+		{
+			if ((Pointer_Location_Keys[Word_Index] >= 0) && !WORD_TABLE_IS_WORD_FOUND(&Pointer_Puzzle->Word_Table, Word_Index)) Pointer_Puzzle->Statistics.Counters.Matches_Count++;
+		}
+	}
+
+	return SolverReportFoundWords(Pointer_Puzzle, Pointer_Location_Keys, Remaining_Words_Count);
+}
+
+/** Make sure the puzzle location keys buffer can store a key per word of the table, growing it if needed.
+ * @param Pointer_Puzzle The puzzle.
+ * @return -1 if no more heap memory is available,
+ * @return 0 on success.
+ */
+static int SolverReserveLocationKeys(TSolverPuzzle *Pointer_Puzzle)
+{
+	long long *Pointer_Location_Keys;
+	int Count = Pointer_Puzzle->Word_Table.Words_Count + 1; // Make sure to never allocate 0 bytes
+
+	if (Count <= Pointer_Puzzle->Allocated_Location_Keys_Count) return 0;
+
+	Pointer_Location_Keys = realloc(Pointer_Puzzle->Pointer_Location_Keys, Count * sizeof(long long));
+	if (Pointer_Location_Keys == NULL) return -1;
+	Pointer_Puzzle->Pointer_Location_Keys = Pointer_Location_Keys;
+	Pointer_Puzzle->Allocated_Location_Keys_Count = Count;
+	return 0;
+}
+
+/** Find all words of a loaded puzzle and its hidden word.
+ * @param Pointer_Puzzle The loaded puzzle. On success, its hidden word field contains the hidden word.
+ * @param Strategy How to search the words.
+ * @param Threads_Count How many threads the scan strategy can use.
+ * @return -1 if the puzzle could not be solved,
+ * @return 0 on success.
+ */
+static int SolverSolveLoadedPuzzle(TSolverPuzzle *Pointer_Puzzle, TSolverStrategy Strategy, int Threads_Count)
+{
+	TCacheKey Cache_Key;
+	double Start_Time = 0;
+	int Return_Value;
+
+	// A puzzle that has already been solved does not need to be searched again
+	if (Pointer_Puzzle->Pointer_Cache != NULL)
+	{
+		if (SolverReserveLocationKeys(Pointer_Puzzle) != 0)
+		{
+			printf("Error : not enough memory to store the words locations.\n");
+			return -1;
+		}
+		CacheComputeKey(&Pointer_Puzzle->Grid, &Pointer_Puzzle->Word_Table, &Cache_Key);
+		if (Pointer_Puzzle->Is_Statistics_Enabled) Start_Time = SolverGetTime();
+		if (CacheLoad(Pointer_Puzzle->Pointer_Cache, &Cache_Key, &Pointer_Puzzle->Grid, &Pointer_Puzzle->Word_Table, Pointer_Puzzle->Pointer_Location_Keys, &Pointer_Puzzle->Pointer_String_Hidden_Word, &Pointer_Puzzle->Hidden_Word_Buffer_Size))
+		{
+			// Only cached puzzles whose words have all been found, so each word is a match
+			if (Pointer_Puzzle->Is_Statistics_Enabled)
+			{
+				Pointer_Puzzle->Statistics.Solving_Duration = SolverGetTime() - Start_Time;
+				Pointer_Puzzle->Statistics.Strategy = Strategy;
+				Pointer_Puzzle->Statistics.Counters.Matches_Count = Pointer_Puzzle->Word_Table.Words_Count;
+				Pointer_Puzzle->Statistics.Is_Cache_Hit = 1;
+			}
+			if (Pointer_Puzzle->Is_Verbose) printf("The results have been read from the cache.\n");
+			return SolverReportFoundWords(Pointer_Puzzle, Pointer_Puzzle->Pointer_Location_Keys, Pointer_Puzzle->Words_Count);
+		}
+	}
+
+	// Try to find all searched words and the hidden word
+	if (Pointer_Puzzle->Is_Statistics_Enabled) Start_Time = SolverGetTime();
+	Return_Value = SolverSolveGrid(Pointer_Puzzle, Strategy, Threads_Count, Pointer_Puzzle->Words_Count);
+	if (Pointer_Puzzle->Is_Statistics_Enabled) Pointer_Puzzle->Statistics.Solving_Duration = SolverGetTime() - Start_Time;
+	if (Return_Value != 0)
+	{
+		if (Pointer_Puzzle->Is_Verbose) printf("Error : this grid is invalid, no solution could be found.\n");
+		return -1;
+	}
+
+	// Make sure all words have been found
+	if (Pointer_Puzzle->Word_Table.Found_Words_Count < Pointer_Puzzle->Word_Table.Words_Count)
+	{
+		if (Pointer_Puzzle->Is_Verbose) printf("Error : some words were not found in the grid, the grid seems to be invalid.\n");
+		return -1;
+	}
+
+	// Retrieve the hidden word
+	if (Pointer_Puzzle->Is_Statistics_Enabled) Start_Time = SolverGetTime();
+	Return_Value = GridGetHiddenWord(&Pointer_Puzzle->Grid, &Pointer_Puzzle->Pointer_String_Hidden_Word, &Pointer_Puzzle->Hidden_Word_Buffer_Size);
+	if (Pointer_Puzzle->Is_Statistics_Enabled) Pointer_Puzzle->Statistics.Hidden_Word_Duration = SolverGetTime() - Start_Time;
+	if (Return_Value != 0)
+	{
+		printf("Error : not enough memory to store the hidden word.\n");
+		return -1;
+	}
+
+	// A cache that can't be written must not prevent from solving puzzles
+	if ((Pointer_Puzzle->Pointer_Cache != NULL) && (CacheStore(Pointer_Puzzle->Pointer_Cache, &Cache_Key, &Pointer_Puzzle->Grid, &Pointer_Puzzle->Word_Table, Pointer_Puzzle->Pointer_Location_Keys, Pointer_Puzzle->Pointer_String_Hidden_Word) != 0) && Pointer_Puzzle->Is_Verbose) printf("Error : the results could not be stored in the cache.\n");
+
+	return 0;
+}
+
+//-------------------------------------------------------------------------------------------------
+// Public functions
+//-------------------------------------------------------------------------------------------------
+int SolverSolveGrid(TSolverPuzzle *Pointer_Puzzle, TSolverStrategy Strategy, int Threads_Count, int Remaining_Words_Count)
+{
+	int Row, Column, Letter, Word_Index, End_Word_Index, Direction;
+	TWordTable *Pointer_Word_Table = &Pointer_Puzzle->Word_Table;
+	TGridSearchCounters *Pointer_Counters = &Pointer_Puzzle->Statistics.Counters;
+	TPlannerPlan Plan;
+
+	// Pick the cheapest strategy for this puzzle
+	if (Strategy == SOLVER_STRATEGY_AUTO)
+	{
+		PlannerChooseStrategy(&Pointer_Puzzle->Grid, Pointer_Word_Table, Threads_Count, &Plan);
+		Strategy = Plan.Strategy;
+		Threads_Count = Plan.Threads_Count;
+		if (Pointer_Puzzle->Is_Verbose) printf("The planner chose the %s strategy with %d thread(s), estimated to take %.3f ms.\n", Solver_Strategy_Names[Strategy], Threads_Count, Plan.Estimated_Durations[Strategy] * 1000.0);
+	}
+	Pointer_Puzzle->Statistics.Strategy = Strategy;
+
+	// The results are stored in the puzzle, so they can be retrieved after the puzzle has been solved
+	if (SolverReserveLocationKeys(Pointer_Puzzle) != 0)
+	{
+		printf("Error : not enough memory to store the words locations.\n");
+		return -1;
+	}
+	if ((Strategy != SOLVER_STRATEGY_SCAN) || (Threads_Count > 1)) return SolverSolveGridWithLocations(Pointer_Puzzle, Strategy, Threads_Count, Remaining_Words_Count);
+
+	for (Word_Index = 0; Word_Index < Pointer_Word_Table->Words_Count; Word_Index++)
+	{
+		if (!WORD_TABLE_IS_WORD_FOUND(Pointer_Word_Table, Word_Index)) Pointer_Puzzle->Pointer_Location_Keys[Word_Index] = -1;
+	}
+
+	// Check each grid character only once
+	for (Row = 0; Row < Pointer_Puzzle->Grid.Rows_Count; Row++)
+	{
+		for (Column = 0; Column < Pointer_Puzzle->Grid.Columns_Count; Column++)
+		{
+			// Only the words starting with the cell letter can match
+			Letter = GRID_GET_LETTER(&Pointer_Puzzle->Grid, Row, Column) - 'A';
+			End_Word_Index = Pointer_Word_Table->Bucket_First_Indexes[Letter + 1];
+
+			// Check all possible words that have not been found yet
+			for (Word_Index = Pointer_Word_Table->Bucket_First_Indexes[Letter]; Word_Index < End_Word_Index; Word_Index++)
+			{
+				if (WORD_TABLE_IS_WORD_FOUND(Pointer_Word_Table, Word_Index)) continue;
+
+				// Count the work only when asked, so the search loop stays the same otherwise
+				if (Pointer_Puzzle->Is_Statistics_Enabled)
+				{
+					Pointer_Counters->Candidate_Pairs_Count++;
+					Direction = GridFindWordDirectionCounted(&Pointer_Puzzle->Grid, WORD_TABLE_GET_WORD(Pointer_Word_Table, Word_Index), WORD_TABLE_GET_LENGTH(Pointer_Word_Table, Word_Index), Row, Column, Pointer_Counters);
+				}
+				else Direction = GridFindWordDirection(&Pointer_Puzzle->Grid, WORD_TABLE_GET_WORD(Pointer_Word_Table, Word_Index), WORD_TABLE_GET_LENGTH(Pointer_Word_Table, Word_Index), Row, Column);
+				if (Direction >= 0)
+				{
+					if (Pointer_Puzzle->Is_Statistics_Enabled) Pointer_Counters->Matches_Count++;
+					GridSetWordFound(&Pointer_Puzzle->Grid, Row, Column, Direction, WORD_TABLE_GET_LENGTH(Pointer_Word_Table, Word_Index));
+					WordTableSetWordFound(Pointer_Word_Table, Word_Index);
+					Pointer_Puzzle->Pointer_Location_Keys[Word_Index] = GRID_MAKE_LOCATION_KEY(Row, Column, Pointer_Puzzle->Grid.Columns_Count, Direction);
+					Remaining_Words_Count--;
+					if (Pointer_Puzzle->Is_Verbose) printf("Found word \"%s\" at row %d and column %d (%d word(s) remaining to be found).\n", WORD_TABLE_GET_WORD(Pointer_Word_Table, Word_Index), Row + 1, Column + 1, Remaining_Words_Count);
+				}
+			}
+		}
+	}
+	if (Pointer_Puzzle->Is_Statistics_Enabled) Pointer_Counters->Visited_Cells_Count += (long long) Pointer_Puzzle->Grid.Rows_Count * Pointer_Puzzle->Grid.Columns_Count;
+
+	return 0;
+}
+
+double SolverGetTime(void)
+{
+	struct timespec Time;
+
+	clock_gettime(CLOCK_MONOTONIC, &Time);
+	return (double) Time.tv_sec + (double) Time.tv_nsec / 1000000000.0;
+}
+
+void SolverPuzzleInitialize(TSolverPuzzle *Pointer_Puzzle, int Is_Verbose)
+{
+	GridInitialize(&Pointer_Puzzle->Grid);
+	WordTableInitialize(&Pointer_Puzzle->Word_Table);
+	Pointer_Puzzle->Words_Count = 0;
+	Pointer_Puzzle->Pointer_Location_Keys = NULL;
+	Pointer_Puzzle->Allocated_Location_Keys_Count = 0;
+	Pointer_Puzzle->Pointer_String_Hidden_Word = NULL;
+	Pointer_Puzzle->Hidden_Word_Buffer_Size = 0;
+	Pointer_Puzzle->Is_Verbose = Is_Verbose;
+	Pointer_Puzzle->Is_Statistics_Enabled = 0;
+	memset(&Pointer_Puzzle->Statistics, 0, sizeof(TSolverStatistics));
+	Pointer_Puzzle->Pointer_Cache = NULL;
+}
+
+void SolverPuzzleFree(TSolverPuzzle *Pointer_Puzzle)
+{
+	GridFree(&Pointer_Puzzle->Grid);
+	WordTableFree(&Pointer_Puzzle->Word_Table);
+	free(Pointer_Puzzle->Pointer_Location_Keys);
+	Pointer_Puzzle->Pointer_Location_Keys = NULL;
+	Pointer_Puzzle->Allocated_Location_Keys_Count = 0;
+	free(Pointer_Puzzle->Pointer_String_Hidden_Word);
+	Pointer_Puzzle->Pointer_String_Hidden_Word = NULL;
+	Pointer_Puzzle->Hidden_Word_Buffer_Size = 0;
+}
+
+int SolverSolvePuzzle(TSolverPuzzle *Pointer_Puzzle, char *Pointer_String_File_Name, TSolverStrategy Strategy, int Threads_Count)
+{
+	int Rows_Count, Columns_Count, Return_Value;
+	double Start_Time = 0;
+
+	// Try to load the specified file
+	if (Pointer_Puzzle->Is_Verbose) printf("Trying to solve the file \"%s\".\n", Pointer_String_File_Name);
+	memset(&Pointer_Puzzle->Statistics, 0, sizeof(TSolverStatistics));
+	if (Pointer_Puzzle->Is_Statistics_Enabled) Start_Time = SolverGetTime();
+	Return_Value = GridLoadFromFile(&Pointer_Puzzle->Grid, Pointer_String_File_Name, &Pointer_Puzzle->Word_Table, &Rows_Count, &Columns_Count, &Pointer_Puzzle->Words_Count);
+	if (Pointer_Puzzle->Is_Statistics_Enabled) Pointer_Puzzle->Statistics.Loading_Duration = SolverGetTime() - Start_Time;
+	if (Return_Value != 0)
+	{
+		if (Pointer_Puzzle->Is_Verbose) printf("The specified file \"%s\" is invalid\n.", Pointer_String_File_Name);
+		return -1;
+	}
+	if (Pointer_Puzzle->Is_Verbose) printf("Successfully loaded a %dx%d grid and %d words to search.\n", Columns_Count, Rows_Count, Pointer_Puzzle->Words_Count);
+
+	return SolverSolveLoadedPuzzle(Pointer_Puzzle, Strategy, Threads_Count);
+}
+
+int SolverSolvePuzzleFromMemory(TSolverPuzzle *Pointer_Puzzle, char *Pointer_Content, size_t Size, TSolverStrategy Strategy, int Threads_Count)
+{
+	int Rows_Count, Columns_Count, Return_Value;
+	double Start_Time = 0;
+
+	memset(&Pointer_Puzzle->Statistics, 0, sizeof(TSolverStatistics));
+	if (Pointer_Puzzle->Is_Statistics_Enabled) Start_Time = SolverGetTime();
+	Return_Value = GridLoadFromMemory(&Pointer_Puzzle->Grid, Pointer_Content, Size, &Pointer_Puzzle->Word_Table, &Rows_Count, &Columns_Count, &Pointer_Puzzle->Words_Count);
+	if (Pointer_Puzzle->Is_Statistics_Enabled) Pointer_Puzzle->Statistics.Loading_Duration = SolverGetTime() - Start_Time;
+	if (Return_Value != 0) return -1;
+	if (Pointer_Puzzle->Is_Verbose) printf("Successfully loaded a %dx%d grid and %d words to search.\n", Columns_Count, Rows_Count, Pointer_Puzzle->Words_Count);
+
+	return SolverSolveLoadedPuzzle(Pointer_Puzzle, Strategy, Threads_Count);
+}
+
+int SolverGetWordLocation(TSolverPuzzle *Pointer_Puzzle, int Word_Index, int *Pointer_Row, int *Pointer_Column, TGridDirection *Pointer_Direction)
+{
+	long long Location_Key;
+
+	if ((Word_Index < 0) || (Word_Index >= Pointer_Puzzle->Word_Table.Words_Count) || !WORD_TABLE_IS_WORD_FOUND(&Pointer_Puzzle->Word_Table, Word_Index)) return -1;
+
+	Location_Key = Pointer_Puzzle->Pointer_Location_Keys[Word_Index];
+	*Pointer_Direction = Location_Key % GRID_DIRECTIONS_COUNT;
+	*Pointer_Row = (int) (Location_Key / GRID_DIRECTIONS_COUNT / Pointer_Puzzle->Grid.Columns_Count);
+	*Pointer_Column = (int) (Location_Key / GRID_DIRECTIONS_COUNT % Pointer_Puzzle->Grid.Columns_Count);
+	return 0;
+}
@@ -0,0 +1,612 @@
+/** @file Stream.c
+ * See Stream.h for description.
+ * @author Adrien RICCIARDI
+ */
+#include <Aho_Corasick.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <Grid.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <Stream.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+//-------------------------------------------------------------------------------------------------
+// Private constants
+//-------------------------------------------------------------------------------------------------
+/** How many bytes are read from the file at once. */
+#define STREAM_READ_BUFFER_SIZE (1024 * 1024)
+
+/** How many bytes are read at once when searching the words separator from the end of the file. */
+#define STREAM_SEPARATOR_SEARCH_BUFFER_SIZE 4096
+
+/** Returned when reading a character if the end of the grid has been reached. */
+#define STREAM_CHARACTER_END_OF_GRID -1
+/** Returned when reading a character if the file could not be read. */
+#define STREAM_CHARACTER_ERROR -2
+
+//-------------------------------------------------------------------------------------------------
+// Private types
+//-------------------------------------------------------------------------------------------------
+/** Read the grid rows of a puzzle file one after the other. */
+typedef struct
+{
+	int File_Descriptor;
+	char *Pointer_String_File_Name; //!< Only used to display errors.
+	char *Pointer_Buffer; //!< The file bytes read in advance (STREAM_READ_BUFFER_SIZE bytes).
+	size_t Buffer_Position; //!< The next byte to parse in the buffer.
+	size_t Buffer_Bytes_Count; //!< How many bytes the buffer contains.
+	off_t Remaining_Bytes_Count; //!< How many grid bytes have not been read from the file yet, the words part of the file is never read.
+	char *Pointer_Row; //!< The last read row (CONFIGURATION_GRID_MAXIMUM_SIZE bytes).
+	int Is_Hidden_Word_Line_Open; //!< Set while the hidden word letters are written band after band, an error message must then close the line first.
+} TStreamReader;
+
+/** Read the next rows of a band, possibly in a separate thread. */
+typedef struct
+{
+	TStreamReader *Pointer_Reader; //!< Where to read the rows from.
+	char *Pointer_Letters; //!< Where to store the first read row, the next ones follow it.
+	int Columns_Count; //!< How many letters all rows must have.
+	int Maximum_Rows_Count; //!< How many rows to read at most.
+	int Read_Rows_Count; //!< On output, how many rows have been read. Less rows than the maximum are read at the end of the grid.
+	int Return_Value; //!< On output, -1 if the file could not be read or if a row is invalid, 0 otherwise.
+} TStreamBandLoad;
+
+/** Where the band being searched is in the grid. */
+typedef struct
+{
+	long long *Pointer_Location_Keys; //!< The first location key of each word in the whole grid, or -1 if the word has not been found yet.
+	int First_Row; //!< The band first row in the grid.
+	int Columns_Count; //!< The grid width.
+} TStreamBand;
+
+/** A located word. */
+typedef struct
+{
+	long long Location_Key; //!< The word location in the whole grid.
+	int Word_Index; //!< The word index in the table.
+	int First_Row; //!< The topmost row containing a word letter.
+} TStreamFoundWord;
+
+//-------------------------------------------------------------------------------------------------
+// Private functions
+//-------------------------------------------------------------------------------------------------
+/** Read a part of a file, retrying until all bytes have been read.
+ * @param File_Descriptor The file.
+ * @param Pointer_Buffer On output, contain the read bytes.
+ * @param Size How many bytes to read.
+ * @param Offset Where to start reading in the file.
+ * @return -1 if the file could not be read,
+ * @return 0 on success.
+ */
+static int StreamReadAt(int File_Descriptor, char *Pointer_Buffer, size_t Size, off_t Offset)
+{
+	ssize_t Read_Bytes_Count;
+
+	while (Size > 0)
+	{
+		Read_Bytes_Count = pread(File_Descriptor, Pointer_Buffer, Size, Offset);
+		if (Read_Bytes_Count < 0)
+		{
+			if (errno == EINTR) continue;
+			return -1;
+		}
+		if (Read_Bytes_Count == 0) return -1; // The file has been truncated
+
+		Pointer_Buffer += Read_Bytes_Count;
+		Size -= (size_t) Read_Bytes_Count;
+		Offset += Read_Bytes_Count;
+	}
+	return 0;
+}
+
+/** Tell whether a character separates the grid rows and the words.
+ * @param Character The character.
+ * @return 1 if the character is a whitespace,
+ * @return 0 otherwise.
+ */
+static inline int StreamIsSeparator(int Character)
+{
+	return (Character == ' ') || ((Character >= '\t') && (Character <= '\r'));
+}
+
+/** Find the '-' line separating the grid from the words, starting from the end of the file so the grid is not read. Words can only contain letters, so the separator is the last '-' character of the file.
+ * @param File_Descriptor The file.
+ * @param Pointer_String_File_Name The file name, only used to display errors.
+ * @param File_Size The file size in bytes.
+ * @param Pointer_Offset On output, contain the separator offset in the file.
+ * @return -1 if the file does not contain a valid separator,
+ * @return 0 on success.
+ */
+static int StreamFindSeparator(int File_Descriptor, char *Pointer_String_File_Name, off_t File_Size, off_t *Pointer_Offset)
+{
+	char Buffer[STREAM_SEPARATOR_SEARCH_BUFFER_SIZE], Character;
+	off_t Start, End = File_Size, Offset;
+	int i;
+
+	while (End > 0)
+	{
+		Start = End - STREAM_SEPARATOR_SEARCH_BUFFER_SIZE;
+		if (Start < 0) Start = 0;
+		if (StreamReadAt(File_Descriptor, Buffer, (size_t) (End - Start), Start) != 0)
+		{
+			printf("Error : could not read the file \"%s\" (%s).\n", Pointer_String_File_Name, strerror(errno));
+			return -1;
+		}
+
+		for (i = (int) (End - Start) - 1; i >= 0; i--)
+		{
+			if (Buffer[i] != '-') continue;
+
+			// The separator must be alone between whitespaces, like the grid rows and the words
+			Offset = Start + i;
+			if ((Offset > 0) && ((StreamReadAt(File_Descriptor, &Character, 1, Offset - 1) != 0) || !StreamIsSeparator((unsigned char) Character))) goto Invalid_Separator;
+			if ((Offset + 1 < File_Size) && ((StreamReadAt(File_Descriptor, &Character, 1, Offset + 1) != 0) || !StreamIsSeparator((unsigned char) Character))) goto Invalid_Separator;
+			*Pointer_Offset = Offset;
+			return 0;
+		}
+		End = Start;
+	}
+
+	printf("Error : end of file has been reached without reaching the list of words to find.\n");
+	return -1;
+
+Invalid_Separator:
+	printf("Error : the character '-' can only be used alone on a line, to separate the grid from the words.\n");
+	return -1;
+}
+
+/** Close the hidden word line if some of its letters have been written, so an error message starts on its own line. The closing quote has no final period, telling that the hidden word is incomplete.
+ * @param Pointer_Reader The reader.
+ */
+static void StreamCloseHiddenWordLine(TStreamReader *Pointer_Reader)
+{
+	if (!Pointer_Reader->Is_Hidden_Word_Line_Open) return;
+	printf("\"\n");
+	Pointer_Reader->Is_Hidden_Word_Line_Open = 0;
+}
+
+/** Go back to the beginning of the grid.
+ * @param Pointer_Reader The reader.
+ * @param Grid_Size How many bytes precede the words separator.
+ * @return -1 if the file could not be rewound,
+ * @return 0 on success.
+ */
+static int StreamRewind(TStreamReader *Pointer_Reader, off_t Grid_Size)
+{
+	if (lseek(Pointer_Reader->File_Descriptor, 0, SEEK_SET) != 0)
+	{
+		StreamCloseHiddenWordLine(Pointer_Reader);
+		printf("Error : could not read the file \"%s\" (%s).\n", Pointer_Reader->Pointer_String_File_Name, strerror(errno));
+		return -1;
+	}
+	Pointer_Reader->Buffer_Position = 0;
+	Pointer_Reader->Buffer_Bytes_Count = 0;
+	Pointer_Reader->Remaining_Bytes_Count = Grid_Size;
+	return 0;
+}
+
+/** Get the next grid character, reading the file when the buffer is empty.
+ * @param Pointer_Reader The reader.
+ * @return STREAM_CHARACTER_END_OF_GRID if the words separator has been reached,
+ * @return STREAM_CHARACTER_ERROR if the file could not be read (an error message has been displayed),
+ * @return The character.
+ */
+static inline int StreamReadCharacter(TStreamReader *Pointer_Reader)
+{
+	ssize_t Read_Bytes_Count;
+	size_t Size;
+
+	if (Pointer_Reader->Buffer_Position >= Pointer_Reader->Buffer_Bytes_Count)
+	{
+		if (Pointer_Reader->Remaining_Bytes_Count == 0) return STREAM_CHARACTER_END_OF_GRID;
+
+		// Never read the words part of the file
+		Size = STREAM_READ_BUFFER_SIZE;
+		if ((off_t) Size > Pointer_Reader->Remaining_Bytes_Count) Size = (size_t) Pointer_Reader->Remaining_Bytes_Count;
+		do
+		{
+			Read_Bytes_Count = read(Pointer_Reader->File_Descriptor, Pointer_Reader->Pointer_Buffer, Size);
+		} while ((Read_Bytes_Count < 0) && (errno == EINTR));
+		if (Read_Bytes_Count <= 0)
+		{
+			StreamCloseHiddenWordLine(Pointer_Reader);
+			printf("Error : could not read the file \"%s\" (%s).\n", Pointer_Reader->Pointer_String_File_Name, Read_Bytes_Count < 0 ? strerror(errno) : "the file has been truncated");
+			return STREAM_CHARACTER_ERROR;
+		}
+
+		Pointer_Reader->Buffer_Position = 0;
+		Pointer_Reader->Buffer_Bytes_Count = (size_t) Read_Bytes_Count;
+		Pointer_Reader->Remaining_Bytes_Count -= Read_Bytes_Count;
+	}
+
+	return (unsigned char) Pointer_Reader->Pointer_Buffer[Pointer_Reader->Buffer_Position++];
+}
+
+/** Read the next grid row to the reader row buffer, converting its letters to uppercase.
+ * @param Pointer_Reader The reader.
+ * @param Pointer_Length On output, contain the row length.
+ * @return -1 if the file could not be read or if the row is invalid (an error message has been displayed),
+ * @return 0 if the end of the grid has been reached,
+ * @return 1 if a row has been read.
+ */
+static int StreamReadRow(TStreamReader *Pointer_Reader, int *Pointer_Length)
+{
+	int Character, Length = 0, Is_Valid = 1;
+
+	// Skip leading whitespaces
+	do
+	{
+		Character = StreamReadCharacter(Pointer_Reader);
+	} while ((Character >= 0) && StreamIsSeparator(Character));
+	if (Character == STREAM_CHARACTER_END_OF_GRID) return 0;
+
+	// Read all characters until the next whitespace
+	while ((Character >= 0) && !StreamIsSeparator(Character))
+	{
+		if (Length >= CONFIGURATION_GRID_MAXIMUM_SIZE)
+		{
+			StreamCloseHiddenWordLine(Pointer_Reader);
+			printf("Error : grid row size can't be greater than %d characters.\n", CONFIGURATION_GRID_MAXIMUM_SIZE);
+			return -1;
+		}
+
+		if ((Character >= 'a') && (Character <= 'z')) Character -= 'a' - 'A';
+		else if ((Character < 'A') || (Character > 'Z')) Is_Valid = 0;
+		Pointer_Reader->Pointer_Row[Length] = (char) Character;
+		Length++;
+
+		Character = StreamReadCharacter(Pointer_Reader);
+	}
+	if (Character == STREAM_CHARACTER_ERROR) return -1;
+
+	// Does the line contain only the allowed characters ?
+	if (!Is_Valid)
+	{
+		StreamCloseHiddenWordLine(Pointer_Reader);
+		printf("Error : the grid line \"%.*s\" contains invalid characters (only letters are allowed).\n", Length, Pointer_Reader->Pointer_Row);
+		return -1;
+	}
+
+	*Pointer_Length = Length;
+	return 1;
+}
+
+/** Read the next rows of a band. This is a thread entry point.
+ * @param Pointer_Parameters The TStreamBandLoad describing the rows to read, its Read_Rows_Count and Return_Value fields are set on output.
+ * @return Always NULL.
+ */
+static void *StreamLoadBand(void *Pointer_Parameters)
+{
+	TStreamBandLoad *Pointer_Load = Pointer_Parameters;
+	int Length, Result;
+
+	Pointer_Load->Read_Rows_Count = 0;
+	Pointer_Load->Return_Value = -1;
+
+	while (Pointer_Load->Read_Rows_Count < Pointer_Load->Maximum_Rows_Count)
+	{
+		Result = StreamReadRow(Pointer_Load->Pointer_Reader, &Length);
+		if (Result < 0) return NULL;
+		if (Result == 0) break;
+
+		if (Length != Pointer_Load->Columns_Count)
+		{
+			StreamCloseHiddenWordLine(Pointer_Load->Pointer_Reader);
+			printf("Error : all grid lines must be of the same length.\n");
+			return NULL;
+		}
+		memcpy(&Pointer_Load->Pointer_Letters[(size_t) Pointer_Load->Read_Rows_Count * Pointer_Load->Columns_Count], Pointer_Load->Pointer_Reader->Pointer_Row, Pointer_Load->Columns_Count);
+		Pointer_Load->Read_Rows_Count++;
+	}
+
+	Pointer_Load->Return_Value = 0;
+	return NULL;
+}
+
+/** Keep the first location of a word found in a band, in the whole grid coordinates.
+ * @param Pointer_Parameters The TStreamBand being searched.
+ * @param Word_Index The found word.
+ * @param Row The word first letter row in the band.
+ * @param Column The word first letter column.
+ * @param Direction The direction the word is written to.
+ */
+static void StreamKeepFirstLocation(void *Pointer_Parameters, int Word_Index, int Row, int Column, TGridDirection Direction)
+{
+	TStreamBand *Pointer_Band = Pointer_Parameters;
+	long long Key;
+
+	Key = GRID_MAKE_LOCATION_KEY(Pointer_Band->First_Row + Row, Column, Pointer_Band->Columns_Count, Direction);
+	if ((Pointer_Band->Pointer_Location_Keys[Word_Index] < 0) || (Key < Pointer_Band->Pointer_Location_Keys[Word_Index])) Pointer_Band->Pointer_Location_Keys[Word_Index] = Key;
+}
+
+/** Sort found words by starting cell, then by order in the word table, like the solver reports them.
+ * @param Pointer_A The first TStreamFoundWord to compare.
+ * @param Pointer_B The second TStreamFoundWord to compare.
+ * @return A negative number if the first word must be reported before the second one, a positive number otherwise.
+ */
+static int StreamCompareFoundWordsLocations(const void *Pointer_A, const void *Pointer_B)
+{
+	const TStreamFoundWord *Pointer_Found_Word_A = Pointer_A, *Pointer_Found_Word_B = Pointer_B;
+	long long Cell_A, Cell_B;
+
+	Cell_A = Pointer_Found_Word_A->Location_Key / GRID_DIRECTIONS_COUNT;
+	Cell_B = Pointer_Found_Word_B->Location_Key / GRID_DIRECTIONS_COUNT;
+	if (Cell_A < Cell_B) return -1;
+	if (Cell_A > Cell_B) return 1;
+	return Pointer_Found_Word_A->Word_Index - Pointer_Found_Word_B->Word_Index;
+}
+
+/** Sort found words by topmost row, so the words covering a band of rows are contiguous.
+ * @param Pointer_A The first TStreamFoundWord to compare.
+ * @param Pointer_B The second TStreamFoundWord to compare.
+ * @return A negative number if the first word starts on an upper row, a positive number if it starts on a lower row, 0 otherwise.
+ */
+static int StreamCompareFoundWordsRows(const void *Pointer_A, const void *Pointer_B)
+{
+	const TStreamFoundWord *Pointer_Found_Word_A = Pointer_A, *Pointer_Found_Word_B = Pointer_B;
+
+	return Pointer_Found_Word_A->First_Row - Pointer_Found_Word_B->First_Row;
+}
+
+//-------------------------------------------------------------------------------------------------
+// Public functions
+//-------------------------------------------------------------------------------------------------
+int StreamSolvePuzzle(char *Pointer_String_File_Name, int Band_Rows_Count, int Is_Verbose)
+{
+	TGrid Grid;
+	TWordTable Word_Table;
+	TAhoCorasickAutomaton Automaton;
+	TStreamReader Reader;
+	TStreamBandLoad Load;
+	TStreamBand Band;
+	TStreamFoundWord *Pointer_Found_Words = NULL, *Pointer_Found_Word;
+	pthread_t Thread;
+	struct stat Status;
+	off_t Separator_Offset;
+	size_t Words_Content_Size, Cell_Index, Hidden_Letters_Count;
+	char *Pointer_Words_Content = NULL, *Pointer_Current_Letters = NULL, *Pointer_Next_Letters = NULL, *Pointer_Letters;
+	long long *Pointer_Location_Keys = NULL;
+	unsigned long long *Pointer_Covered_Bits = NULL;
+	int File_Descriptor, Rows_Count = 0, Columns_Count = 0, Words_Count, Word_Index, Maximum_Length = 0, Overlapping_Rows_Count, Band_Height, Current_Rows_Count = 0, Found_Words_Count = 0, Is_Grid_End_Reached = 1, Is_Thread_Started, Is_Memory_Error, First_Active_Word_Index, Row, Column, Row_Step, Column_Step, Direction, Length, i, j, Result, Return_Value = -1;
+
+	GridInitialize(&Grid);
+	WordTableInitialize(&Word_Table);
+	memset(&Automaton, 0, sizeof(Automaton));
+	Reader.Pointer_Buffer = NULL;
+	Reader.Pointer_Row = NULL;
+	Reader.Is_Hidden_Word_Line_Open = 0;
+
+	// The file is read several times, so it can't be a pipe
+	if (Is_Verbose) printf("Trying to solve the file \"%s\".\n", Pointer_String_File_Name);
+	File_Descriptor = open(Pointer_String_File_Name, O_RDONLY);
+	if (File_Descriptor < 0)
+	{
+		printf("Error : could not open the file \"%s\" (%s).\n", Pointer_String_File_Name, strerror(errno));
+		goto Exit;
+	}
+	if ((fstat(File_Descriptor, &Status) != 0) || !S_ISREG(Status.st_mode))
+	{
+		printf("Error : the file \"%s\" must be a regular file to be solved band by band.\n", Pointer_String_File_Name);
+		goto Exit;
+	}
+
+	// Load the words only, the parser sees a puzzle without any grid row
+	if (StreamFindSeparator(File_Descriptor, Pointer_String_File_Name, Status.st_size, &Separator_Offset) != 0) goto Exit;
+	Words_Content_Size = (size_t) (Status.st_size - Separator_Offset);
+	Pointer_Words_Content = malloc(Words_Content_Size + 1); // The parser needs a writable byte following the content
+	if (Pointer_Words_Content == NULL)
+	{
+		printf("Error : not enough memory to read the file \"%s\".\n", Pointer_String_File_Name);
+		goto Exit;
+	}
+	if (StreamReadAt(File_Descriptor, Pointer_Words_Content, Words_Content_Size, Separator_Offset) != 0)
+	{
+		printf("Error : could not read the file \"%s\" (%s).\n", Pointer_String_File_Name, strerror(errno));
+		goto Exit;
+	}
+	if (GridLoadFromMemory(&Grid, Pointer_Words_Content, Words_Content_Size, &Word_Table, &Rows_Count, &Columns_Count, &Words_Count) != 0) goto Exit;
+
+	// Consecutive bands share enough rows to fully contain any word crossing their border
+	for (Word_Index = 0; Word_Index < Words_Count; Word_Index++)
+	{
+		if (WORD_TABLE_GET_LENGTH(&Word_Table, Word_Index) > Maximum_Length) Maximum_Length = WORD_TABLE_GET_LENGTH(&Word_Table, Word_Index);
+	}
+	Overlapping_Rows_Count = Maximum_Length > 0 ? Maximum_Length - 1 : 0;
+	Band_Height = Band_Rows_Count + Overlapping_Rows_Count;
+
+	Reader.File_Descriptor = File_Descriptor;
+	Reader.Pointer_String_File_Name = Pointer_String_File_Name;
+	Reader.Pointer_Buffer = malloc(STREAM_READ_BUFFER_SIZE);
+	Reader.Pointer_Row = malloc(CONFIGURATION_GRID_MAXIMUM_SIZE);
+	Pointer_Location_Keys = malloc((Words_Count + 1) * sizeof(long long)); // Make sure to never allocate 0 bytes
+	Pointer_Found_Words = malloc((Words_Count + 1) * sizeof(TStreamFoundWord));
+	if ((Reader.Pointer_Buffer == NULL) || (Reader.Pointer_Row == NULL) || (Pointer_Location_Keys == NULL) || (Pointer_Found_Words == NULL) || (AhoCorasickBuild(&Automaton, &Word_Table) != 0))
+	{
+		printf("Error : not enough memory to search the grid band by band.\n");
+		goto Exit;
+	}
+	for (Word_Index = 0; Word_Index < Words_Count; Word_Index++) Pointer_Location_Keys[Word_Index] = -1;
+
+	// The first row gives the grid width
+	if (StreamRewind(&Reader, Separator_Offset) != 0) goto Exit;
+	Result = StreamReadRow(&Reader, &Columns_Count);
+	if (Result < 0) goto Exit;
+	if (Result > 0)
+	{
+		Pointer_Current_Letters = malloc((size_t) Band_Height * Columns_Count);
+		Pointer_Next_Letters = malloc((size_t) Band_Height * Columns_Count);
+		Pointer_Covered_Bits = malloc(((size_t) Band_Rows_Count * Columns_Count + 63) / 64 * sizeof(unsigned long long));
+		if ((Pointer_Current_Letters == NULL) || (Pointer_Next_Letters == NULL) || (Pointer_Covered_Bits == NULL))
+		{
+			printf("Error : not enough memory to store a grid band.\n");
+			goto Exit;
+		}
+
+		// Fill the first band
+		memcpy(Pointer_Current_Letters, Reader.Pointer_Row, Columns_Count);
+		Load.Pointer_Reader = &Reader;
+		Load.Pointer_Letters = &Pointer_Current_Letters[Columns_Count];
+		Load.Columns_Count = Columns_Count;
+		Load.Maximum_Rows_Count = Band_Height - 1;
+		StreamLoadBand(&Load);
+		if (Load.Return_Value != 0) goto Exit;
+		Current_Rows_Count = 1 + Load.Read_Rows_Count;
+		Is_Grid_End_Reached = Current_Rows_Count < Band_Height;
+	}
+
+	// Search the bands one after the other
+	Band.Pointer_Location_Keys = Pointer_Location_Keys;
+	Band.First_Row = 0;
+	Band.Columns_Count = Columns_Count;
+	while (Current_Rows_Count > 0)
+	{
+		// Read the next band while this one is searched, the next band starts with the last rows of this one
+		Is_Thread_Started = 0;
+		if (!Is_Grid_End_Reached)
+		{
+			memcpy(Pointer_Next_Letters, &Pointer_Current_Letters[(size_t) Band_Rows_Count * Columns_Count], (size_t) Overlapping_Rows_Count * Columns_Count);
+			Load.Pointer_Letters = &Pointer_Next_Letters[(size_t) Overlapping_Rows_Count * Columns_Count];
+			Load.Maximum_Rows_Count = Band_Rows_Count;
+			if (pthread_create(&Thread, NULL, StreamLoadBand, &Load) == 0) Is_Thread_Started = 1;
+			else StreamLoadBand(&Load); // Read the band right now if no thread can be started
+		}
+
+		Is_Memory_Error = GridLoadFromLetters(&Grid, Pointer_Current_Letters, Current_Rows_Count, Columns_Count);
+		if (Is_Memory_Error == 0) AhoCorasickFindAllOccurrences(&Automaton, &Grid, StreamKeepFirstLocation, &Band);
+		if (Is_Thread_Started) pthread_join(Thread, NULL);
+		if (Is_Memory_Error != 0)
+		{
+			printf("Error : not enough memory to store a grid band.\n");
+			goto Exit;
+		}
+
+		// Stop when all rows have been searched
+		if (Is_Grid_End_Reached || (Load.Return_Value != 0) || (Load.Read_Rows_Count == 0))
+		{
+			if (!Is_Grid_End_Reached && (Load.Return_Value != 0)) goto Exit;
+			Rows_Count = Band.First_Row + Current_Rows_Count;
+			break;
+		}
+
+		// Go to the next band
+		Pointer_Letters = Pointer_Current_Letters;
+		Pointer_Current_Letters = Pointer_Next_Letters;
+		Pointer_Next_Letters = Pointer_Letters;
+		Band.First_Row += Band_Rows_Count;
+		Current_Rows_Count = Overlapping_Rows_Count + Load.Read_Rows_Count;
+		Is_Grid_End_Reached = Load.Read_Rows_Count < Band_Rows_Count;
+	}
+	if (Is_Verbose) printf("Successfully loaded a %dx%d grid and %d words to search.\n", Columns_Count, Rows_Count, Words_Count);
+
+	// Report the found words in the order the cell-by-cell scan would have found them
+	for (Word_Index = 0; Word_Index < Words_Count; Word_Index++)
+	{
+		if (Pointer_Location_Keys[Word_Index] < 0) continue;
+		Pointer_Found_Words[Found_Words_Count].Location_Key = Pointer_Location_Keys[Word_Index];
+		Pointer_Found_Words[Found_Words_Count].Word_Index = Word_Index;
+		Found_Words_Count++;
+	}
+	qsort(Pointer_Found_Words, Found_Words_Count, sizeof(TStreamFoundWord), StreamCompareFoundWordsLocations);
+	for (i = 0; i < Found_Words_Count; i++)
+	{
+		Pointer_Found_Word = &Pointer_Found_Words[i];
+		Row = (int) (Pointer_Found_Word->Location_Key / GRID_DIRECTIONS_COUNT / Columns_Count);
+		Column = (int) (Pointer_Found_Word->Location_Key / GRID_DIRECTIONS_COUNT % Columns_Count);
+		if (Is_Verbose) printf("Found word \"%s\" at row %d and column %d (%d word(s) remaining to be found).\n", WORD_TABLE_GET_WORD(&Word_Table, Pointer_Found_Word->Word_Index), Row + 1, Column + 1, Words_Count - i - 1);
+
+		// Keep the topmost row of the word to know which bands it covers
+		GridGetDirectionSteps(Pointer_Found_Word->Location_Key % GRID_DIRECTIONS_COUNT, &Row_Step, &Column_Step);
+		Pointer_Found_Word->First_Row = Row;
+		if (Row_Step < 0) Pointer_Found_Word->First_Row -= WORD_TABLE_GET_LENGTH(&Word_Table, Pointer_Found_Word->Word_Index) - 1;
+	}
+	if (Found_Words_Count < Words_Count)
+	{
+		if (Is_Verbose) printf("Error : some words were not found in the grid, the grid seems to be invalid.\n");
+		goto Exit;
+	}
+
+	// Read the grid again, writing the letters that are not covered by a word band after band
+	if (Rows_Count > 0)
+	{
+		qsort(Pointer_Found_Words, Found_Words_Count, sizeof(TStreamFoundWord), StreamCompareFoundWordsRows);
+		if (StreamRewind(&Reader, Separator_Offset) != 0) goto Exit;
+		Load.Pointer_Letters = Pointer_Current_Letters;
+		Load.Maximum_Rows_Count = Band_Rows_Count;
+		Band.First_Row = 0;
+		First_Active_Word_Index = 0;
+
+		while (1)
+		{
+			StreamLoadBand(&Load);
+			if (Load.Return_Value != 0) goto Exit;
+			if (Load.Read_Rows_Count == 0) break;
+
+			// Words ending above the band can't cover it, neither the next ones
+			while ((First_Active_Word_Index < Found_Words_Count) && (Pointer_Found_Words[First_Active_Word_Index].First_Row + Maximum_Length - 1 < Band.First_Row)) First_Active_Word_Index++;
+
+			// Mark the band cells covered by a word
+			memset(Pointer_Covered_Bits, 0, ((size_t) Load.Read_Rows_Count * Columns_Count + 63) / 64 * sizeof(unsigned long long));
+			for (i = First_Active_Word_Index; (i < Found_Words_Count) && (Pointer_Found_Words[i].First_Row < Band.First_Row + Load.Read_Rows_Count); i++)
+			{
+				Pointer_Found_Word = &Pointer_Found_Words[i];
+				Row = (int) (Pointer_Found_Word->Location_Key / GRID_DIRECTIONS_COUNT / Columns_Count);
+				Column = (int) (Pointer_Found_Word->Location_Key / GRID_DIRECTIONS_COUNT % Columns_Count);
+				Direction = Pointer_Found_Word->Location_Key % GRID_DIRECTIONS_COUNT;
+				GridGetDirectionSteps(Direction, &Row_Step, &Column_Step);
+				Length = WORD_TABLE_GET_LENGTH(&Word_Table, Pointer_Found_Word->Word_Index);
+
+				for (j = 0; j < Length; j++)
+				{
+					if ((Row >= Band.First_Row) && (Row < Band.First_Row + Load.Read_Rows_Count))
+					{
+						Cell_Index = (size_t) (Row - Band.First_Row) * Columns_Count + Column;
+						Pointer_Covered_Bits[Cell_Index / 64] |= 1ULL << (Cell_Index % 64);
+					}
+					Row += Row_Step;
+					Column += Column_Step;
+				}
+			}
+
+			// Gather the remaining letters in the other band buffer, then write them at once
+			Hidden_Letters_Count = 0;
+			for (Cell_Index = 0; Cell_Index < (size_t) Load.Read_Rows_Count * Columns_Count; Cell_Index++)
+			{
+				if (!((Pointer_Covered_Bits[Cell_Index / 64] >> (Cell_Index % 64)) & 1))
+				{
+					Pointer_Next_Letters[Hidden_Letters_Count] = Pointer_Current_Letters[Cell_Index];
+					Hidden_Letters_Count++;
+				}
+			}
+			if (Hidden_Letters_Count > 0)
+			{
+				if (!Reader.Is_Hidden_Word_Line_Open) printf("Hidden word : \"");
+				Reader.Is_Hidden_Word_Line_Open = 1;
+				fwrite(Pointer_Next_Letters, 1, Hidden_Letters_Count, stdout);
+			}
+
+			Band.First_Row += Load.Read_Rows_Count;
+		}
+	}
+	if (Reader.Is_Hidden_Word_Line_Open) printf("\".\n");
+	else printf("This grid does not contain a hidden word.\n");
+	Return_Value = 0;
+
+Exit:
+	if (File_Descriptor >= 0) close(File_Descriptor);
+	free(Pointer_Words_Content);
+	free(Pointer_Current_Letters);
+	free(Pointer_Next_Letters);
+	free(Pointer_Covered_Bits);
+	free(Pointer_Location_Keys);
+	free(Pointer_Found_Words);
+	free(Reader.Pointer_Buffer);
+	free(Reader.Pointer_Row);
+	AhoCorasickFree(&Automaton);
+	GridFree(&Grid);
+	WordTableFree(&Word_Table);
+	return Return_Value;
+}
@@ -0,0 +1,177 @@
+/** @file Trie.c
+ * See Trie.h for description.
+ * @author Adrien RICCIARDI
+ */
+#include <stdlib.h>
+#include <string.h>
+#include <Trie.h>
+
+//-------------------------------------------------------------------------------------------------
+// Private types
+//-------------------------------------------------------------------------------------------------
+/** The prefix tree of all words to search. Node 0 is the root node, it corresponds to the empty prefix. */
+typedef struct
+{
+	int *Pointer_Children; //!< The child node for each node and letter (CONFIGURATION_ALPHABET_LETTERS_COUNT entries per node), or -1 if no word continues with this letter.
+	int *Pointer_First_Words; //!< The index of the first word ending on a node, or -1 if no word ends on this node.
+	int *Pointer_Remaining_Words_Counts; //!< How many words starting with each node prefix have not been located yet. A walk stops on a node with no remaining word.
+	int Nodes_Count;
+	int Allocated_Nodes_Count;
+	int *Pointer_Next_Words; //!< For each word, the index of the next word ending on the same node (several identical words can be searched), or -1.
+} TTrie;
+
+//-------------------------------------------------------------------------------------------------
+// Private functions
+//-------------------------------------------------------------------------------------------------
+/** Release all memory allocated by a trie.
+ * @param Pointer_Trie The trie to free.
+ */
+static void TrieFree(TTrie *Pointer_Trie)
+{
+	free(Pointer_Trie->Pointer_Children);
+	free(Pointer_Trie->Pointer_First_Words);
+	free(Pointer_Trie->Pointer_Remaining_Words_Counts);
+	free(Pointer_Trie->Pointer_Next_Words);
+}
+
+/** Append a new node without any child to the trie.
+ * @param Pointer_Trie The trie to add a node to.
+ * @return -1 if no more heap memory is available,
+ * @return The new node index on success.
+ */
+static int TrieAddNode(TTrie *Pointer_Trie)
+{
+	int Node, *Pointer_Children, *Pointer_First_Words, *Pointer_Remaining_Words_Counts, Allocated_Nodes_Count;
+
+	// Grow the node arrays when they are full
+	if (Pointer_Trie->Nodes_Count >= Pointer_Trie->Allocated_Nodes_Count)
+	{
+		Allocated_Nodes_Count = Pointer_Trie->Allocated_Nodes_Count * 2;
+		Pointer_Children = realloc(Pointer_Trie->Pointer_Children, (size_t) Allocated_Nodes_Count * CONFIGURATION_ALPHABET_LETTERS_COUNT * sizeof(int));
+		if (Pointer_Children == NULL) return -1;
+		Pointer_Trie->Pointer_Children = Pointer_Children;
+		Pointer_First_Words = realloc(Pointer_Trie->Pointer_First_Words, Allocated_Nodes_Count * sizeof(int));
+		if (Pointer_First_Words == NULL) return -1;
+		Pointer_Trie->Pointer_First_Words = Pointer_First_Words;
+		Pointer_Remaining_Words_Counts = realloc(Pointer_Trie->Pointer_Remaining_Words_Counts, Allocated_Nodes_Count * sizeof(int));
+		if (Pointer_Remaining_Words_Counts == NULL) return -1;
+		Pointer_Trie->Pointer_Remaining_Words_Counts = Pointer_Remaining_Words_Counts;
+		Pointer_Trie->Allocated_Nodes_Count = Allocated_Nodes_Count;
+	}
+
+	// Initialize the node
+	Node = Pointer_Trie->Nodes_Count;
+	memset(&Pointer_Trie->Pointer_Children[Node * CONFIGURATION_ALPHABET_LETTERS_COUNT], -1, CONFIGURATION_ALPHABET_LETTERS_COUNT * sizeof(int));
+	Pointer_Trie->Pointer_First_Words[Node] = -1;
+	Pointer_Trie->Pointer_Remaining_Words_Counts[Node] = 0;
+	Pointer_Trie->Nodes_Count++;
+
+	return Node;
+}
+
+/** Build the trie containing all words of the table.
+ * @param Pointer_Trie The trie to build.
+ * @param Pointer_Word_Table The words to insert.
+ * @return -1 if no more heap memory is available,
+ * @return 0 on success.
+ */
+static int TrieBuild(TTrie *Pointer_Trie, TWordTable *Pointer_Word_Table)
+{
+	int Word_Index, Words_Count = Pointer_Word_Table->Words_Count, Node, Child_Node, Letter;
+	char *Pointer_String_Word;
+
+	// Start with room for a few nodes, the trie will grow as needed
+	memset(Pointer_Trie, 0, sizeof(TTrie));
+	Pointer_Trie->Allocated_Nodes_Count = 64;
+	Pointer_Trie->Pointer_Children = malloc(Pointer_Trie->Allocated_Nodes_Count * CONFIGURATION_ALPHABET_LETTERS_COUNT * sizeof(int));
+	Pointer_Trie->Pointer_First_Words = malloc(Pointer_Trie->Allocated_Nodes_Count * sizeof(int));
+	Pointer_Trie->Pointer_Remaining_Words_Counts = malloc(Pointer_Trie->Allocated_Nodes_Count * sizeof(int));
+	Pointer_Trie->Pointer_Next_Words = malloc((Words_Count + 1) * sizeof(int)); // Make sure to never allocate 0 bytes
+	if ((Pointer_Trie->Pointer_Children == NULL) || (Pointer_Trie->Pointer_First_Words == NULL) || (Pointer_Trie->Pointer_Remaining_Words_Counts == NULL) || (Pointer_Trie->Pointer_Next_Words == NULL)) return -1;
+	if (TrieAddNode(Pointer_Trie) < 0) return -1; // Create the root node
+
+	for (Word_Index = 0; Word_Index < Words_Count; Word_Index++)
+	{
+		// Follow the existing prefix, then create the missing nodes
+		Node = 0;
+		Pointer_Trie->Pointer_Remaining_Words_Counts[0]++;
+		Pointer_String_Word = WORD_TABLE_GET_WORD(Pointer_Word_Table, Word_Index);
+		while (*Pointer_String_Word != 0)
+		{
+			Letter = *Pointer_String_Word - 'A';
+			Child_Node = Pointer_Trie->Pointer_Children[Node * CONFIGURATION_ALPHABET_LETTERS_COUNT + Letter];
+			if (Child_Node < 0)
+			{
+				Child_Node = TrieAddNode(Pointer_Trie);
+				if (Child_Node < 0) return -1;
+				Pointer_Trie->Pointer_Children[Node * CONFIGURATION_ALPHABET_LETTERS_COUNT + Letter] = Child_Node;
+			}
+			Node = Child_Node;
+			Pointer_Trie->Pointer_Remaining_Words_Counts[Node]++;
+			Pointer_String_Word++;
+		}
+
+		// Attach the word to its last node
+		Pointer_Trie->Pointer_Next_Words[Word_Index] = Pointer_Trie->Pointer_First_Words[Node];
+		Pointer_Trie->Pointer_First_Words[Node] = Word_Index;
+	}
+
+	return 0;
+}
+
+//-------------------------------------------------------------------------------------------------
+// Public functions
+//-------------------------------------------------------------------------------------------------
+int TrieFindWords(TGrid *Pointer_Grid, TWordTable *Pointer_Word_Table, long long *Pointer_Location_Keys)
+{
+	TTrie Trie;
+	int i, j, Row, Column, Direction, Letters_Count, Letters_Step, Node, Word_Index, Located_Words_Count, Path_Nodes[CONFIGURATION_WORD_MAXIMUM_STRING_SIZE], Return_Value = -1;
+	char *Pointer_Letters;
+
+	if (TrieBuild(&Trie, Pointer_Word_Table) != 0) goto Exit;
+	for (i = 0; i < Pointer_Word_Table->Words_Count; i++) Pointer_Location_Keys[i] = -1;
+
+	// Visit the cells and the directions in the cell-by-cell scan order, so the first location found for a word is the one the scan would have found. Stop as soon as all words have been located
+	for (Row = 0; (Row < Pointer_Grid->Rows_Count) && (Trie.Pointer_Remaining_Words_Counts[0] > 0); Row++)
+	{
+		for (Column = 0; (Column < Pointer_Grid->Columns_Count) && (Trie.Pointer_Remaining_Words_Counts[0] > 0); Column++)
+		{
+			// Do not read the cell lines if no remaining word starts with the cell letter
+			Node = Trie.Pointer_Children[GRID_GET_LETTER(Pointer_Grid, Row, Column) - 'A'];
+			if ((Node < 0) || (Trie.Pointer_Remaining_Words_Counts[Node] == 0)) continue;
+
+			for (Direction = 0; Direction < GRID_DIRECTIONS_COUNT; Direction++)
+			{
+				// Walk the grid and the trie together until no remaining word has the read prefix
+				Pointer_Letters = GridGetDirectionLetters(Pointer_Grid, Direction, Row, Column, &Letters_Count, &Letters_Step);
+				Node = 0;
+				for (i = 0; i < Letters_Count; i++)
+				{
+					Node = Trie.Pointer_Children[Node * CONFIGURATION_ALPHABET_LETTERS_COUNT + Pointer_Letters[i * Letters_Step] - 'A'];
+					if ((Node < 0) || (Trie.Pointer_Remaining_Words_Counts[Node] == 0)) break;
+					Path_Nodes[i] = Node;
+
+					// Locate the words ending here that have not been located yet (identical words are all located at once)
+					Word_Index = Trie.Pointer_First_Words[Node];
+					if ((Word_Index < 0) || (Pointer_Location_Keys[Word_Index] >= 0)) continue;
+					Located_Words_Count = 0;
+					while (Word_Index >= 0)
+					{
+						Pointer_Location_Keys[Word_Index] = GRID_MAKE_LOCATION_KEY(Row, Column, Pointer_Grid->Columns_Count, Direction);
+						Located_Words_Count++;
+						Word_Index = Trie.Pointer_Next_Words[Word_Index];
+					}
+
+					// The located words do not need to be searched anymore, prune them from all prefixes
+					Trie.Pointer_Remaining_Words_Counts[0] -= Located_Words_Count;
+					for (j = 0; j <= i; j++) Trie.Pointer_Remaining_Words_Counts[Path_Nodes[j]] -= Located_Words_Count;
+				}
+			}
+		}
+	}
+	Return_Value = 0;
+
+Exit:
+	TrieFree(&Trie);
+	return Return_Value;
+}
@@ -0,0 +1,145 @@
+/** @file Word_Table.c
+ * See Word_Table.h for description.
+ * @author Adrien RICCIARDI
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <Word_Table.h>
+
+//-------------------------------------------------------------------------------------------------
+// Private functions
+//-------------------------------------------------------------------------------------------------
+/** Get how many 64-bit words the found bitmap of a table needs.
+ * @param Words_Count How many words the table can contain.
+ * @return The bitmap size in 64-bit words.
+ */
+static size_t WordTableGetFoundBitsCount(int Words_Count)
+{
+	return ((size_t) Words_Count + 63) / 64;
+}
+
+/** Make the arena big enough for the provided amount of words, keeping the appended words.
+ * @param Pointer_Word_Table The table.
+ * @param Capacity How many words must fit.
+ * @return -1 if no more heap memory is available,
+ * @return 0 on success.
+ */
+static int WordTableReserve(TWordTable *Pointer_Word_Table, int Capacity)
+{
+	unsigned char *Pointer_Arena;
+	size_t *Pointer_Offsets, *Pointer_Appended_Offsets;
+	unsigned long long *Pointer_Found_Bits;
+
+	if (Capacity <= Pointer_Word_Table->Capacity) return 0;
+
+	// Double the capacity to make appending many words cheap
+	if (Capacity < Pointer_Word_Table->Capacity * 2) Capacity = Pointer_Word_Table->Capacity * 2;
+	if (Capacity < 64) Capacity = 64;
+
+	// Carve all arrays from a single allocation, the 8-byte wide ones first to keep them aligned
+	Pointer_Arena = malloc(Capacity * (2 * sizeof(size_t) + 2) + WordTableGetFoundBitsCount(Capacity) * sizeof(unsigned long long));
+	if (Pointer_Arena == NULL) return -1;
+	Pointer_Offsets = (size_t *) Pointer_Arena;
+	Pointer_Appended_Offsets = &Pointer_Offsets[Capacity];
+	Pointer_Found_Bits = (unsigned long long *) &Pointer_Appended_Offsets[Capacity];
+	Pointer_Word_Table->Pointer_Lengths = (unsigned char *) &Pointer_Found_Bits[WordTableGetFoundBitsCount(Capacity)];
+
+	// Only the appended words need to be kept, the sorted arrays are rebuilt from them
+	if (Pointer_Word_Table->Words_Count > 0)
+	{
+		memcpy(Pointer_Appended_Offsets, Pointer_Word_Table->Pointer_Appended_Offsets, Pointer_Word_Table->Words_Count * sizeof(size_t));
+		memcpy(&Pointer_Word_Table->Pointer_Lengths[Capacity], Pointer_Word_Table->Pointer_Appended_Lengths, Pointer_Word_Table->Words_Count);
+	}
+	free(Pointer_Word_Table->Pointer_Arena);
+
+	Pointer_Word_Table->Pointer_Arena = Pointer_Arena;
+	Pointer_Word_Table->Pointer_Offsets = Pointer_Offsets;
+	Pointer_Word_Table->Pointer_Appended_Offsets = Pointer_Appended_Offsets;
+	Pointer_Word_Table->Pointer_Found_Bits = Pointer_Found_Bits;
+	Pointer_Word_Table->Pointer_Appended_Lengths = &Pointer_Word_Table->Pointer_Lengths[Capacity];
+	Pointer_Word_Table->Capacity = Capacity;
+	return 0;
+}
+
+//-------------------------------------------------------------------------------------------------
+// Public functions
+//-------------------------------------------------------------------------------------------------
+void WordTableInitialize(TWordTable *Pointer_Word_Table)
+{
+	memset(Pointer_Word_Table, 0, sizeof(TWordTable));
+}
+
+void WordTableFree(TWordTable *Pointer_Word_Table)
+{
+	free(Pointer_Word_Table->Pointer_Arena);
+	WordTableInitialize(Pointer_Word_Table);
+}
+
+void WordTableClear(TWordTable *Pointer_Word_Table, char *Pointer_Text)
+{
+	Pointer_Word_Table->Pointer_Text = Pointer_Text;
+	memset(Pointer_Word_Table->Bucket_First_Indexes, 0, sizeof(Pointer_Word_Table->Bucket_First_Indexes));
+	Pointer_Word_Table->Words_Count = 0;
+	Pointer_Word_Table->Found_Words_Count = 0;
+}
+
+int WordTableAppend(TWordTable *Pointer_Word_Table, char *Pointer_String_Word, int Length)
+{
+	int Words_Count = Pointer_Word_Table->Words_Count;
+
+	// Make sure the word is not too long
+	if (Length >= CONFIGURATION_WORD_MAXIMUM_STRING_SIZE) return -2;
+
+	if (WordTableReserve(Pointer_Word_Table, Words_Count + 1) != 0) return -1;
+	Pointer_Word_Table->Pointer_Appended_Offsets[Words_Count] = (size_t) (Pointer_String_Word - Pointer_Word_Table->Pointer_Text);
+	Pointer_Word_Table->Pointer_Appended_Lengths[Words_Count] = (unsigned char) Length;
+	Pointer_Word_Table->Words_Count = Words_Count + 1;
+
+	return 0;
+}
+
+void WordTableSortWords(TWordTable *Pointer_Word_Table)
+{
+	int i, Letter, Next_Indexes[CONFIGURATION_ALPHABET_LETTERS_COUNT], Words_Count = Pointer_Word_Table->Words_Count;
+
+	// Count the words starting with each letter
+	memset(Next_Indexes, 0, sizeof(Next_Indexes));
+	for (i = 0; i < Words_Count; i++) Next_Indexes[Pointer_Word_Table->Pointer_Text[Pointer_Word_Table->Pointer_Appended_Offsets[i]] - 'A']++;
+
+	// Compute where each bucket begins
+	Pointer_Word_Table->Bucket_First_Indexes[0] = 0;
+	for (Letter = 0; Letter < CONFIGURATION_ALPHABET_LETTERS_COUNT; Letter++)
+	{
+		Pointer_Word_Table->Bucket_First_Indexes[Letter + 1] = Pointer_Word_Table->Bucket_First_Indexes[Letter] + Next_Indexes[Letter];
+		Next_Indexes[Letter] = Pointer_Word_Table->Bucket_First_Indexes[Letter];
+	}
+
+	// Fill the buckets with the last appended words first, which is the order the previous linked lists used, so the words are still reported in the same order
+	for (i = Words_Count - 1; i >= 0; i--)
+	{
+		Letter = Pointer_Word_Table->Pointer_Text[Pointer_Word_Table->Pointer_Appended_Offsets[i]] - 'A';
+		Pointer_Word_Table->Pointer_Offsets[Next_Indexes[Letter]] = Pointer_Word_Table->Pointer_Appended_Offsets[i];
+		Pointer_Word_Table->Pointer_Lengths[Next_Indexes[Letter]] = Pointer_Word_Table->Pointer_Appended_Lengths[i];
+		Next_Indexes[Letter]++;
+	}
+
+	if (Words_Count > 0) memset(Pointer_Word_Table->Pointer_Found_Bits, 0, WordTableGetFoundBitsCount(Words_Count) * sizeof(unsigned long long));
+	Pointer_Word_Table->Found_Words_Count = 0;
+}
+
+void WordTableSetWordFound(TWordTable *Pointer_Word_Table, int Word_Index)
+{
+	if (WORD_TABLE_IS_WORD_FOUND(Pointer_Word_Table, Word_Index)) return;
+
+	Pointer_Word_Table->Pointer_Found_Bits[Word_Index / 64] |= 1ULL << (Word_Index % 64);
+	Pointer_Word_Table->Found_Words_Count++;
+}
+
+void WordTableDisplay(TWordTable *Pointer_Word_Table)
+{
+	int i;
+
+	printf("Words count = %d, found words count = %d, capacity = %d.\n", Pointer_Word_Table->Words_Count, Pointer_Word_Table->Found_Words_Count, Pointer_Word_Table->Capacity);
+	for (i = 0; i < Pointer_Word_Table->Words_Count; i++) printf("Word %d : \"%s\", length = %d, found = %d.\n", i, WORD_TABLE_GET_WORD(Pointer_Word_Table, i), WORD_TABLE_GET_LENGTH(Pointer_Word_Table, i), (int) WORD_TABLE_IS_WORD_FOUND(Pointer_Word_Table, i));
+}
@@ -1,21 +1,160 @@
 #!/bin/sh
 
 Files=$(find . -iname "*.txt" | sort)
+Options="--strategy=scan --strategy=aho-corasick --strategy=trie --strategy=rabin-karp --strategy=letter-index --strategy=shift-and --threads=4"
+
+PrintFailure()
+{
+	printf "\033[31m+-------------+\033[0m\n"
+	printf "\033[31m| Test failed |\033[0m\n"
+	printf "\033[31m+-------------+\033[0m\n"
+	exit 1
+}
 
 for File in $Files
 do
-	../word-search-solver $File
-	if [ $? -ne 0 ]
+	../word-search-solver $File > /tmp/Word_Search_Solver_Reference.txt
+	Result=$?
+	cat /tmp/Word_Search_Solver_Reference.txt
+	if [ $Result -ne 0 ]
+	then
+		PrintFailure
+	fi
+
+	# All strategies must find the same words at the same locations, the automatic strategy also tells which strategy the planner chose
+	if ! grep -q "^The planner chose the [a-z-]* strategy" /tmp/Word_Search_Solver_Reference.txt
 	then
-		printf "\033[31m+-------------+\033[0m\n"
-		printf "\033[31m| Test failed |\033[0m\n"
-		printf "\033[31m+-------------+\033[0m\n"
-		exit 1
+		printf "Error : the planner choice has not been logged.\n"
+		PrintFailure
+	fi
+	grep -v "^The planner chose" /tmp/Word_Search_Solver_Reference.txt > /tmp/Word_Search_Solver_Planned_Reference.txt
+	for Option in $Options
+	do
+		../word-search-solver $Option $File > /tmp/Word_Search_Solver_Output.txt
+		if [ $? -ne 0 ]
+		then
+			PrintFailure
+		fi
+		if ! grep -v "^The planner chose" /tmp/Word_Search_Solver_Output.txt | cmp -s /tmp/Word_Search_Solver_Planned_Reference.txt -
+		then
+			printf "Error : the output with the option \"$Option\" differs from the default one.\n"
+			PrintFailure
+		fi
+	done
+
+	# Files that can't be mapped in memory, like pipes, are read instead
+	cat $File | ../word-search-solver /dev/stdin | grep -v "Trying to solve" > /tmp/Word_Search_Solver_Output.txt
+	if ! grep -v "Trying to solve" /tmp/Word_Search_Solver_Reference.txt | cmp -s - /tmp/Word_Search_Solver_Output.txt
+	then
+		printf "Error : the output differs when the file is read from a pipe.\n"
+		PrintFailure
+	fi
+
+	# Bands of a single row make every word cross several bands
+	../word-search-solver --stream --band-rows 1 $File > /tmp/Word_Search_Solver_Output.txt
+	if [ $? -ne 0 ] || ! cmp -s /tmp/Word_Search_Solver_Planned_Reference.txt /tmp/Word_Search_Solver_Output.txt
+	then
+		printf "Error : the output differs when the grid is read band by band.\n"
+		PrintFailure
+	fi
+
+	# The second solve must come from the cache and report the same results
+	rm -rf /tmp/Word_Search_Solver_Cache
+	../word-search-solver --cache /tmp/Word_Search_Solver_Cache $File > /dev/null
+	../word-search-solver --cache /tmp/Word_Search_Solver_Cache $File > /tmp/Word_Search_Solver_Output.txt
+	if [ $? -ne 0 ] || ! grep -q "^The results have been read from the cache" /tmp/Word_Search_Solver_Output.txt || ! grep -v "^The results have been read from the cache" /tmp/Word_Search_Solver_Output.txt | cmp -s /tmp/Word_Search_Solver_Planned_Reference.txt -
+	then
+		printf "Error : the output differs when the results are read from the cache.\n"
+		PrintFailure
 	fi
 
 	printf "\n"
 done
 
+# Solve all puzzles again in a single process
+../word-search-solver --batch --threads=4 $Files
+if [ $? -ne 0 ]
+then
+	PrintFailure
+fi
+printf "\n"
+
+# Solve all puzzles again as a stream of requests separated by empty lines (a file may not end with a new line), each response must contain the hidden word found when solving the file
+rm -f /tmp/Word_Search_Solver_Requests.txt /tmp/Word_Search_Solver_Reference.txt
+for File in $Files
+do
+	cat $File >> /tmp/Word_Search_Solver_Requests.txt
+	printf "\n\n" >> /tmp/Word_Search_Solver_Requests.txt
+	printf "solved %s\n\n" "$(../word-search-solver $File | sed -n 's/^Hidden word : "\(.*\)"\.$/\1/p')" >> /tmp/Word_Search_Solver_Reference.txt
+done
+../word-search-solver --server < /tmp/Word_Search_Solver_Requests.txt > /tmp/Word_Search_Solver_Output.txt
+if ! cmp -s /tmp/Word_Search_Solver_Reference.txt /tmp/Word_Search_Solver_Output.txt
+then
+	printf "Error : the server responses differ from the solved files.\n"
+	PrintFailure
+fi
+
+# Sweep each grid with its own words used as a dictionary, all of them must be found at least once
+for File in $Files
+do
+	sed '1,/^-/d' $File | tr -d '\r' | tr 'a-z' 'A-Z' | sort -u > /tmp/Word_Search_Solver_Dictionary.txt
+	../word-search-solver --dictionary /tmp/Word_Search_Solver_Dictionary.txt $File | sed -n 's/^Found word "\(.*\)" at row .*$/\1/p' | sort -u > /tmp/Word_Search_Solver_Output.txt
+	if ! cmp -s /tmp/Word_Search_Solver_Dictionary.txt /tmp/Word_Search_Solver_Output.txt
+	then
+		printf "Error : the dictionary sweep of the file \"$File\" did not find all words.\n"
+		PrintFailure
+	fi
+done
+
+# The machine-readable formats must report the same words and hidden word than the text output
+for File in $Files
+do
+	../word-search-solver $File > /tmp/Word_Search_Solver_Reference.txt
+	../word-search-solver --format=tsv $File > /tmp/Word_Search_Solver_Output.txt
+	if [ $? -ne 0 ] || [ "$(grep -c '^Found word' /tmp/Word_Search_Solver_Reference.txt)" -ne "$(grep -c '^word	' /tmp/Word_Search_Solver_Output.txt)" ] || [ "$(sed -n 's/^Hidden word : "\(.*\)"\.$/\1/p' /tmp/Word_Search_Solver_Reference.txt)" != "$(sed -n 's/^result	solved	//p' /tmp/Word_Search_Solver_Output.txt)" ]
+	then
+		printf "Error : the TSV output of the file \"$File\" differs from the text one.\n"
+		PrintFailure
+	fi
+
+	for Format in json binary
+	do
+		if ! ../word-search-solver --format=$Format --quiet $File > /dev/null
+		then
+			printf "Error : the file \"$File\" could not be solved with the $Format format.\n"
+			PrintFailure
+		fi
+	done
+done
+
+# Editing a puzzle then undoing the edits must give back the solved hidden word
+for File in $Files
+do
+	Hidden_Word=$(../word-search-solver $File | sed -n 's/^Hidden word : "\(.*\)"\.$/\1/p')
+	Word=$(sed '1,/^-/d' $File | tr -d '\r' | grep -m 1 .)
+	Letter=$(head -c 1 $File)
+	printf "remove $Word\nletter 1 1 Z\nletter 1 1 Y\nadd $Word\nletter 1 1 $Letter\n" | ../word-search-solver --edit $File > /tmp/Word_Search_Solver_Output.txt
+	if [ $? -ne 0 ] || [ "$(tail -n 1 /tmp/Word_Search_Solver_Output.txt)" != "Valid puzzle, hidden word : \"$Hidden_Word\"." ] || [ "$(head -n 1 /tmp/Word_Search_Solver_Output.txt)" != "Valid puzzle, hidden word : \"$Hidden_Word\"." ]
+	then
+		printf "Error : the edited puzzle \"$File\" does not give back its hidden word.\n"
+		PrintFailure
+	fi
+done
+
+# The statistics must count a match per word, whatever the strategy (several threads may match the same word, so the threads option is not tried)
+for File in $Files
+do
+	Words_Count=$(../word-search-solver $File | grep -c '^Found word')
+	for Option in $(echo $Options | tr ' ' '\n' | grep -e '--strategy')
+	do
+		if [ "$(../word-search-solver --stats --quiet $Option $File | sed -n 's/^Statistics of .* \([0-9]*\) match(es)\.$/\1/p')" != "$Words_Count" ]
+		then
+			printf "Error : the statistics of the file \"$File\" with the option \"$Option\" do not count all words.\n"
+			PrintFailure
+		fi
+	done
+done
+
 printf "\033[32m+---------------------+\033[0m\n"
 printf "\033[32m| All tests succeeded |\033[0m\n"
 printf "\033[32m+---------------------+\033[0m\n"